@@ -0,0 +1,288 @@
+// EventBus and CommandBus hot paths: one publish and its dispatch, as the control
+// loop sees them, next to the payload, subscription and callable schemes they replaced.
+// Run via the run_benchmarks target for a JSON report.
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "BridgeStateMachine.h"
+#include "CommandBus.h"
+#include "Delegate.h"
+#include "EventBus.h"
+#include "Logger.h"
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+// Subscriber counts to measure; the firmware has at most a handful per event
+void subscriberCounts(benchmark::internal::Benchmark* b) {
+    for (int subscribers : {0, 1, 4, 16}) {
+        b->Arg(subscribers);
+    }
+}
+
+// Stand-in for StateWriter / WebSocket broadcast work done for every FAULT_DETECTED
+constexpr unsigned long UI_WORK_US = 300;
+
+void busyWait(unsigned long us) {
+    const unsigned long start = micros();
+    while (micros() - start < us) {
+    }
+}
+
+// The 26 events the UI broadcaster used to subscribe to one by one
+const BridgeEvent BROADCAST_EVENTS[] = {
+    BridgeEvent::BOAT_DETECTED, BridgeEvent::BOAT_DETECTED_LEFT, BridgeEvent::BOAT_DETECTED_RIGHT,
+    BridgeEvent::BOAT_PASSED, BridgeEvent::BOAT_PASSED_LEFT, BridgeEvent::BOAT_PASSED_RIGHT,
+    BridgeEvent::FAULT_DETECTED, BridgeEvent::FAULT_CLEARED, BridgeEvent::MANUAL_OVERRIDE_ACTIVATED,
+    BridgeEvent::MANUAL_OVERRIDE_DEACTIVATED, BridgeEvent::TRAFFIC_STOPPED_SUCCESS,
+    BridgeEvent::BRIDGE_OPENED_SUCCESS, BridgeEvent::BRIDGE_CLOSED_SUCCESS,
+    BridgeEvent::TRAFFIC_RESUMED_SUCCESS, BridgeEvent::INDICATOR_UPDATE_SUCCESS,
+    BridgeEvent::SYSTEM_SAFE_SUCCESS, BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS,
+    BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED,
+    BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED, BridgeEvent::MANUAL_TRAFFIC_STOP_REQUESTED,
+    BridgeEvent::MANUAL_TRAFFIC_RESUME_REQUESTED, BridgeEvent::STATE_CHANGED,
+    BridgeEvent::SIMULATION_ENABLED, BridgeEvent::SIMULATION_DISABLED,
+    BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED
+};
+constexpr size_t BROADCAST_EVENT_COUNT = sizeof(BROADCAST_EVENTS) / sizeof(BROADCAST_EVENTS[0]);
+
+// Shaped like the firmware's command subscribers: a member function reached through `this`
+class CommandHandler {
+public:
+    void onCommand(const Command& command) { total_ += static_cast<int>(command.action) + 1; }
+    int total() const { return total_; }
+
+private:
+    int total_ = 0;
+};
+
+// Four `this`-capturing subscribers called in turn, as CommandBus::publish() does
+template <typename Callback>
+void dispatchTable(benchmark::State& state) {
+    constexpr int SUBSCRIBERS = 4;
+    CommandHandler handlers[SUBSCRIBERS];
+    std::vector<Callback> table;
+    for (CommandHandler& h : handlers) {
+        CommandHandler* self = &h;
+        table.emplace_back([self](const Command& c) { self->onCommand(c); });
+    }
+    Command cmd;
+    cmd.target = CommandTarget::MOTOR_CONTROL;
+    cmd.action = CommandAction::RAISE_BRIDGE;
+
+    for (auto _ : state) {
+        for (const Callback& callback : table) {
+            callback(cmd);
+        }
+    }
+    benchmark::DoNotOptimize(handlers[0].total());
+    state.SetItemsProcessed(state.iterations() * SUBSCRIBERS);
+    state.counters["callableBytes"] = sizeof(Callback);
+}
+
+}  // namespace
+
+// One payload-free publish + processEvents(), N subscribers on the event
+static void BM_EventBusPublishProcess(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus;
+    uint32_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bus.subscribe(BridgeEvent::BOAT_DETECTED, [c = &calls](EventData*) { ++*c; });
+    }
+    bus.seal();
+
+    for (auto _ : state) {
+        bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+        benchmark::DoNotOptimize(bus.processEvents());
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventBusPublishProcess)->Apply(subscriberCounts);
+
+// Same with a typed payload (StateChangeData), the event every module listens for
+static void BM_EventBusPublishProcessTyped(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus;
+    uint32_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED,
+            [c = &calls](const StateChangeData&) { ++*c; });
+    }
+    bus.seal();
+
+    for (auto _ : state) {
+        bus.emplace<StateChangeData>(BridgeState::OPENING, BridgeState::STOPPING_TRAFFIC);
+        benchmark::DoNotOptimize(bus.processEvents());
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventBusPublishProcessTyped)->Apply(subscriberCounts);
+
+// The pointer API the typed path replaced: a pool-allocated payload, and a virtual
+// getEventEnum() check plus static_cast in every subscriber
+static void BM_EventBusPublishProcessPointer(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus;
+    uint32_t sum = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bus.subscribe(BridgeEvent::STATE_CHANGED, [s = &sum](EventData* d) {
+            if (d && d->getEventEnum() == BridgeEvent::STATE_CHANGED) {
+                *s += static_cast<uint32_t>(static_cast<StateChangeData*>(d)->getNewState());
+            }
+        });
+    }
+    bus.seal();
+
+    for (auto _ : state) {
+        bus.publish(BridgeEvent::STATE_CHANGED, new StateChangeData(BridgeState::OPENING, BridgeState::STOPPING_TRAFFIC));
+        benchmark::DoNotOptimize(bus.processEvents());
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventBusPublishProcessPointer)->Apply(subscriberCounts);
+
+// A full normal ring (64 events) published, then drained by one processEvents()
+static void BM_EventBusBurst(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus;
+    uint32_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bus.subscribe(BridgeEvent::BOAT_DETECTED, [c = &calls](EventData*) { ++*c; });
+    }
+    bus.seal();
+
+    constexpr size_t BURST = EventBus::DEFAULT_NORMAL_QUEUE_CAPACITY;
+    for (auto _ : state) {
+        for (size_t i = 0; i < BURST; ++i) {
+            bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+        }
+        benchmark::DoNotOptimize(bus.processEvents());
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_EventBusBurst)->Apply(subscriberCounts);
+
+// Subscribing a broadcaster to 26 events: one subscription per event (arg 0, the old setup)
+// or one EventMask subscription (arg 1). Each iteration builds and seals a fresh bus.
+static void BM_BroadcasterSubscribe(benchmark::State& state) {
+    const bool useMask = state.range(0) != 0;
+    uint32_t calls = 0;
+    size_t entries = 0;
+    for (auto _ : state) {
+        EventBus bus;
+        if (useMask) {
+            EventMask mask;
+            for (BridgeEvent ev : BROADCAST_EVENTS) mask = mask.with(ev);
+            bus.subscribe(mask, [c = &calls](BridgeEvent, EventData*) { ++*c; });
+        } else {
+            for (BridgeEvent ev : BROADCAST_EVENTS) bus.subscribe(ev, [c = &calls](EventData*) { ++*c; });
+        }
+        bus.seal();
+        entries = bus.subscriptionCount();
+    }
+    state.SetLabel(useMask ? "mask" : "per-event");
+    state.counters["entries"] = static_cast<double>(entries);
+    state.counters["tableBytes"] = static_cast<double>(entries * sizeof(EventSubscription));
+}
+BENCHMARK(BM_BroadcasterSubscribe)->Arg(0)->Arg(1);
+
+// One of each of the 26 events published and dispatched to that broadcaster
+static void BM_BroadcasterDispatch(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    const bool useMask = state.range(0) != 0;
+    EventBus bus;
+    uint32_t calls = 0;
+    if (useMask) {
+        EventMask mask;
+        for (BridgeEvent ev : BROADCAST_EVENTS) mask = mask.with(ev);
+        bus.subscribe(mask, [c = &calls](BridgeEvent, EventData*) { ++*c; });
+    } else {
+        for (BridgeEvent ev : BROADCAST_EVENTS) bus.subscribe(ev, [c = &calls](EventData*) { ++*c; });
+    }
+    bus.seal();
+
+    for (auto _ : state) {
+        for (BridgeEvent ev : BROADCAST_EVENTS) bus.emplace<SimpleEventData>(ev);
+        benchmark::DoNotOptimize(bus.processEvents());
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetLabel(useMask ? "mask" : "per-event");
+    state.SetItemsProcessed(state.iterations() * BROADCAST_EVENT_COUNT);
+}
+BENCHMARK(BM_BroadcasterDispatch)->Arg(0)->Arg(1);
+
+// CommandBus::publish with N subscribers on the target (dispatch is synchronous)
+static void BM_CommandBusPublish(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    CommandBus bus;
+    uint32_t calls = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bus.subscribe(CommandTarget::SIGNAL_CONTROL, [c = &calls](const Command&) { ++*c; });
+    }
+    bus.seal();
+
+    Command cmd;
+    cmd.target = CommandTarget::SIGNAL_CONTROL;
+    cmd.action = CommandAction::SET_CAR_TRAFFIC;
+    cmd.data = "Red";
+    for (auto _ : state) {
+        bus.publish(cmd);
+    }
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CommandBusPublish)->Apply(subscriberCounts);
+
+// Calling subscribers through std::function (the old tables) vs Delegate (inline, no heap)
+static void BM_DispatchStdFunction(benchmark::State& state) {
+    dispatchTable<std::function<void(const Command&)>>(state);
+}
+BENCHMARK(BM_DispatchStdFunction);
+
+static void BM_DispatchDelegate(benchmark::State& state) {
+    dispatchTable<Delegate<void(const Command&)>>(state);
+}
+BENCHMARK(BM_DispatchDelegate);
+
+// publish(FAULT_DETECTED) -> the FSM's ENTER_SAFE_STATE, with two UI subscribers doing
+// UI_WORK_US each registered ahead of it, as in setup(). Iteration time is publish to
+// command only; in registration order it would be at least 2 x UI_WORK_US.
+static void BM_FaultToSafeState(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus;
+    CommandBus commandBus;
+    BridgeStateMachine fsm(bus, commandBus);
+    for (int i = 0; i < 2; ++i) {
+        bus.subscribe(BridgeEvent::FAULT_DETECTED, [](EventData*) { busyWait(UI_WORK_US); });
+    }
+    BenchClock::time_point safeStateAt;
+    commandBus.subscribe(CommandTarget::CONTROLLER, [&safeStateAt](const Command& cmd) {
+        if (cmd.action == CommandAction::ENTER_SAFE_STATE) {
+            safeStateAt = BenchClock::now();
+        }
+    });
+    fsm.begin();
+    bus.seal();
+    commandBus.seal();
+
+    for (auto _ : state) {
+        const BenchClock::time_point publishedAt = BenchClock::now();
+        bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+        bus.processEvents();
+        state.SetIterationTime(std::chrono::duration<double>(safeStateAt - publishedAt).count());
+
+        // Back to IDLE for the next iteration
+        bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_CLEARED);
+        bus.processEvents();
+    }
+    state.counters["uiWorkAheadUs"] = 2 * UI_WORK_US;
+}
+BENCHMARK(BM_FaultToSafeState)->UseManualTime()->Unit(benchmark::kMicrosecond);
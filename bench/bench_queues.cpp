@@ -0,0 +1,241 @@
+// Queue and timer paths measured against the structures they replaced: the original
+// std::vector event queue, cross-thread hand-off through MpscQueue / emplaceRemote(), and
+// the timer wheel against polling every deadline. Run via the run_benchmarks target.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "EventBus.h"
+#include "Logger.h"
+#include "MpscQueue.h"
+#include "TimerWheel.h"
+
+namespace {
+
+// Reference copy of the original std::vector queue (insert for EMERGENCY, erase(begin) per pop)
+class LegacyVectorQueue {
+public:
+    void publish(BridgeEvent eventType, EventPriority priority) {
+        QueuedEvent newEvent{eventType, {}, priority, micros()};
+        if (priority == EventPriority::EMERGENCY) {
+            auto it = queue_.begin();
+            while (it != queue_.end() && it->priority == EventPriority::EMERGENCY) {
+                ++it;
+            }
+            queue_.insert(it, std::move(newEvent));
+        } else {
+            queue_.push_back(std::move(newEvent));
+        }
+    }
+
+    template <typename F>
+    void drain(F&& dispatch) {
+        while (!queue_.empty()) {
+            QueuedEvent event = std::move(queue_.front());
+            queue_.erase(queue_.begin());
+            dispatch(event.eventType);
+        }
+    }
+
+private:
+    std::vector<QueuedEvent> queue_;
+};
+
+constexpr int BURST = 10000;
+
+BridgeEvent burstEvent(int i) {
+    return (i % 2) ? BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS : BridgeEvent::BOAT_DETECTED_LEFT;
+}
+
+EventPriority burstPriority(int i) {
+    // One in ten events is safety-critical, matching beam-break/fault traffic mixed into sensor bursts
+    return (i % 10 == 0) ? EventPriority::EMERGENCY : EventPriority::NORMAL;
+}
+
+struct Item {
+    uint32_t producer = 0;
+    uint32_t seq = 0;
+};
+
+constexpr uint32_t PER_PRODUCER = 50000;
+
+void producerCounts(benchmark::internal::Benchmark* b) {
+    for (int producers : {1, 2, 4}) {
+        b->Arg(producers);
+    }
+}
+
+}  // namespace
+
+// A 10k-event burst (10% EMERGENCY) through the original vector queue, dispatched through
+// the same map + std::function table the bus had, so only the queue differs
+static void BM_Burst10kVectorQueue(benchmark::State& state) {
+    int dispatched = 0;
+    std::map<BridgeEvent, std::vector<std::function<void(EventData*)>>> subscribers;
+    auto count = [&dispatched](EventData*) { dispatched++; };
+    subscribers[BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS].push_back(count);
+    subscribers[BridgeEvent::BOAT_DETECTED_LEFT].push_back(count);
+
+    for (auto _ : state) {
+        LegacyVectorQueue queue;
+        for (int i = 0; i < BURST; ++i) {
+            queue.publish(burstEvent(i), burstPriority(i));
+        }
+        queue.drain([&subscribers](BridgeEvent eventType) {
+            auto it = subscribers.find(eventType);
+            if (it != subscribers.end()) {
+                for (const auto& callback : it->second) callback(nullptr);
+            }
+        });
+    }
+    benchmark::DoNotOptimize(dispatched);
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_Burst10kVectorQueue)->Unit(benchmark::kMillisecond);
+
+// The same burst through the bus's ring queues, sized for the whole burst so nothing drops
+static void BM_Burst10kRingQueues(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::WARN);
+    EventBus bus(BURST, BURST);
+    int dispatched = 0;
+    auto count = [&dispatched](EventData*) { dispatched++; };
+    bus.subscribe(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, count);
+    bus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, count);
+    bus.seal();
+
+    for (auto _ : state) {
+        for (int i = 0; i < BURST; ++i) {
+            bus.publish(burstEvent(i), nullptr, burstPriority(i));
+        }
+        bus.processEvents();
+    }
+    benchmark::DoNotOptimize(dispatched);
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_Burst10kRingQueues)->Unit(benchmark::kMillisecond);
+
+// N std::thread producers push PER_PRODUCER items each into a MpscQueue; this thread pops them all
+static void BM_MpscQueueProducers(benchmark::State& state) {
+    const int producerCount = static_cast<int>(state.range(0));
+    const uint64_t total = static_cast<uint64_t>(producerCount) * PER_PRODUCER;
+
+    for (auto _ : state) {
+        MpscQueue<Item, 1024> queue;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&queue, p]() {
+                for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                    while (!queue.tryPush(Item{static_cast<uint32_t>(p), i})) {
+                        std::this_thread::yield();  // Full - the consumer will catch up
+                    }
+                }
+            });
+        }
+        uint64_t received = 0;
+        Item item;
+        while (received < total) {
+            if (queue.tryPop(item)) {
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& t : producers) t.join();
+    }
+    state.SetItemsProcessed(state.iterations() * total);
+}
+BENCHMARK(BM_MpscQueueProducers)->Apply(producerCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// N producer threads emplaceRemote() (retrying when the hand-off queue is full) while this
+// thread runs processEvents(); "rejected" is the hand-off pushes that had to be retried
+static void BM_EventBusRemotePublish(benchmark::State& state) {
+    Logger::setLevel(Logger::Level::ERROR);  // Every retried push logs a WARN
+    const int producerCount = static_cast<int>(state.range(0));
+    const int total = producerCount * static_cast<int>(PER_PRODUCER);
+    uint64_t rejected = 0;
+
+    for (auto _ : state) {
+        EventBus bus;
+        std::atomic<int> dispatched{0};
+        bus.subscribe(BridgeEvent::BOAT_DETECTED, [&dispatched](EventData*) {
+            dispatched.fetch_add(1, std::memory_order_relaxed);
+        });
+        bus.seal();
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&bus]() {
+                for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                    while (!bus.emplaceRemote<SimpleEventData>(BridgeEvent::BOAT_DETECTED)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        while (dispatched.load(std::memory_order_relaxed) < total) {
+            bus.processEvents();
+            std::this_thread::yield();
+        }
+        for (auto& t : producers) t.join();
+        rejected += bus.getQueueStats().remoteDropped;
+    }
+    state.SetItemsProcessed(state.iterations() * total);
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EventBusRemotePublish)->Apply(producerCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// One 1 ms advance() with the whole pool armed far in the future (the idle-tick cost)
+static void BM_TimerWheelTick(benchmark::State& state) {
+    constexpr uint32_t FIRST_DEADLINE = 1000000;
+    std::unique_ptr<TimerWheel> wheel;
+    uint32_t now = 0;
+    int fired = 0;
+    auto arm = [&]() {
+        wheel.reset(new TimerWheel(0));
+        for (size_t i = 0; i < TimerWheel::MAX_TIMERS; ++i) {
+            wheel->schedule(0, FIRST_DEADLINE + static_cast<uint32_t>(i), [&fired]() { fired++; });
+        }
+        now = 0;
+    };
+    arm();
+
+    for (auto _ : state) {
+        wheel->advance(++now);
+        if (now == FIRST_DEADLINE - 1) {
+            state.PauseTiming();  // Re-arm before anything is due, so every tick stays idle
+            arm();
+            state.ResumeTiming();
+        }
+    }
+    benchmark::DoNotOptimize(fired);
+    state.counters["timers"] = TimerWheel::MAX_TIMERS;
+}
+BENCHMARK(BM_TimerWheelTick);
+
+// The loop the wheel replaced: compare every deadline against the clock on each tick
+static void BM_PollingTick(benchmark::State& state) {
+    std::vector<uint32_t> deadlines(TimerWheel::MAX_TIMERS);
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        deadlines[i] = 1000000 + static_cast<uint32_t>(i);
+    }
+    uint32_t now = 0;
+    uint32_t due = 0;
+
+    for (auto _ : state) {
+        if (++now == deadlines[0]) {
+            now = 1;  // Stay idle, like the wheel run
+        }
+        for (uint32_t deadline : deadlines) {
+            if (now >= deadline) {
+                due++;
+            }
+        }
+        benchmark::DoNotOptimize(due);
+    }
+    state.counters["timers"] = TimerWheel::MAX_TIMERS;
+}
+BENCHMARK(BM_PollingTick);
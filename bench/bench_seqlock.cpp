@@ -0,0 +1,100 @@
+// Network-core reads of the UI state while the control core keeps publishing it: the
+// SeqLock StateWriter uses against the mutex-guarded copy it replaced. Reader threads
+// load whole UiState copies; with the writer on, a background thread republishes as fast
+// as it can (far busier than a bridge cycle, which is a few dozen events). "stores" is
+// the writer's rate over the run - what readers cost the control core. Run via the
+// run_benchmarks target.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "SeqLock.h"
+#include "UiState.h"
+
+namespace {
+
+// The previous scheme: one lock around every read and write
+class MutexPublished {
+public:
+    void store(const UiState& value) {
+        std::lock_guard<std::mutex> lk(mu_);
+        value_ = value;
+    }
+    UiState load() const {
+        std::lock_guard<std::mutex> lk(mu_);
+        return value_;
+    }
+
+private:
+    mutable std::mutex mu_;
+    UiState value_;
+};
+
+// Republishes a changing state until stopped; thread 0 of each run owns it
+template <typename Published>
+class Writer {
+public:
+    void start(Published& published) {
+        stop_.store(false, std::memory_order_relaxed);
+        stores_ = 0;
+        thread_ = std::thread([this, &published]() {
+            UiState state;
+            while (!stop_.load(std::memory_order_relaxed)) {
+                ++state.version;
+                state.sectionVersion[state.version % UiState::SECTION_COUNT] = state.version;
+                state.bridgeLastChangeMs = state.version;
+                state.carLeft = (state.version & 1u) ? LightColour::RED : LightColour::GREEN;
+                published.store(state);
+                ++stores_;
+            }
+        });
+    }
+
+    uint64_t stop() {
+        stop_.store(true, std::memory_order_relaxed);
+        thread_.join();
+        return stores_;
+    }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+    uint64_t stores_ = 0;
+};
+
+template <typename Published>
+void readUnderWrites(benchmark::State& state) {
+    static Published published;
+    static Writer<Published> writer;
+    const bool writing = state.range(0) != 0;
+    if (state.thread_index() == 0 && writing) {
+        writer.start(published);
+    }
+
+    uint32_t versions = 0;
+    for (auto _ : state) {
+        const UiState copy = published.load();
+        versions += copy.version;
+        benchmark::DoNotOptimize(copy);
+    }
+    benchmark::DoNotOptimize(versions);
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0 && writing) {
+        state.counters["stores"] = benchmark::Counter(static_cast<double>(writer.stop()), benchmark::Counter::kIsRate);
+    }
+}
+
+}  // namespace
+
+// One consistent UiState copy per iteration, per reader thread; Arg = writer running
+static void BM_UiStateReadSeqLock(benchmark::State& state) {
+    readUnderWrites<SeqLock<UiState>>(state);
+}
+BENCHMARK(BM_UiStateReadSeqLock)->ArgName("writer")->Arg(0)->Arg(1)->ThreadRange(1, 4)->UseRealTime();
+
+static void BM_UiStateReadMutex(benchmark::State& state) {
+    readUnderWrites<MutexPublished>(state);
+}
+BENCHMARK(BM_UiStateReadMutex)->ArgName("writer")->Arg(0)->Arg(1)->ThreadRange(1, 4)->UseRealTime();
@@ -0,0 +1,320 @@
+// StateWriter and WebSocketServer hot paths: applying each event to the UI state,
+// building + serializing the snapshot / patch a broadcast sends, the bytes a bridge cycle
+// puts on air, and parsing a SET request arriving on the (loopback) WebSocket. Run via
+// the run_benchmarks target.
+
+#include <benchmark/benchmark.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ESPAsyncWebServer.h>
+#include "CommandBus.h"
+#include "DetectionSystem.h"
+#include "EventBus.h"
+#include "Logger.h"
+#include "StateWriter.h"
+#include "UiState.h"
+#include "WebSocketServer.h"
+
+// Every heap allocation in the process, for the per-event counts below
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size != 0 ? size : 1);
+    if (p == nullptr) {
+        std::abort();
+    }
+    return p;
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// One event StateWriter subscribes to, published with the payload the firmware uses
+struct EventCase {
+    BridgeEvent event;
+    void (*publish)(EventBus& bus, BridgeEvent event);
+};
+
+void publishSimple(EventBus& bus, BridgeEvent event) {
+    bus.emplace<SimpleEventData>(event);
+}
+void publishCarLight(EventBus& bus, BridgeEvent) {
+    bus.emplace<LightChangeData>(String("left"), String("Red"), true);
+}
+void publishBoatLight(EventBus& bus, BridgeEvent) {
+    bus.emplace<LightChangeData>(String("left"), String("Green"), false);
+}
+void publishSensorConfig(EventBus& bus, BridgeEvent) {
+    bus.emplace<SimulationSensorConfigData>(true, false, true);
+}
+void publishStateChange(EventBus& bus, BridgeEvent) {
+    bus.emplace<StateChangeData>(BridgeState::OPENING, BridgeState::STOPPING_TRAFFIC);
+}
+
+const EventCase EVENT_CASES[] = {
+    {BridgeEvent::BOAT_DETECTED, publishSimple},
+    {BridgeEvent::BOAT_DETECTED_LEFT, publishSimple},
+    {BridgeEvent::BOAT_DETECTED_RIGHT, publishSimple},
+    {BridgeEvent::BOAT_PASSED, publishSimple},
+    {BridgeEvent::BOAT_PASSED_LEFT, publishSimple},
+    {BridgeEvent::BOAT_PASSED_RIGHT, publishSimple},
+    {BridgeEvent::FAULT_DETECTED, publishSimple},
+    {BridgeEvent::FAULT_CLEARED, publishSimple},
+    {BridgeEvent::MANUAL_OVERRIDE_ACTIVATED, publishSimple},
+    {BridgeEvent::MANUAL_OVERRIDE_DEACTIVATED, publishSimple},
+    {BridgeEvent::TRAFFIC_STOPPED_SUCCESS, publishSimple},
+    {BridgeEvent::BRIDGE_OPENED_SUCCESS, publishSimple},
+    {BridgeEvent::BRIDGE_CLOSED_SUCCESS, publishSimple},
+    {BridgeEvent::TRAFFIC_RESUMED_SUCCESS, publishSimple},
+    {BridgeEvent::INDICATOR_UPDATE_SUCCESS, publishSimple},
+    {BridgeEvent::SYSTEM_SAFE_SUCCESS, publishSimple},
+    {BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED, publishSimple},
+    {BridgeEvent::SYSTEM_RESET_REQUESTED, publishSimple},
+    {BridgeEvent::SIMULATION_ENABLED, publishSimple},
+    {BridgeEvent::SIMULATION_DISABLED, publishSimple},
+    {BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, publishCarLight},
+    {BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, publishBoatLight},
+    {BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED, publishSensorConfig},
+    {BridgeEvent::STATE_CHANGED, publishStateChange},
+};
+constexpr int EVENT_CASE_COUNT = sizeof(EVENT_CASES) / sizeof(EVENT_CASES[0]);
+
+// One automatic boat cycle as StateWriter sees it, IDLE back to IDLE
+struct CycleStep {
+    BridgeEvent event;
+    BridgeState from = BridgeState::IDLE;  // STATE_CHANGED only
+    BridgeState to = BridgeState::IDLE;
+    const char* side = nullptr;            // Light changes only
+    const char* colour = nullptr;
+};
+
+const CycleStep BOAT_CYCLE[] = {
+    {BridgeEvent::BOAT_DETECTED_LEFT},
+    {BridgeEvent::STATE_CHANGED, BridgeState::IDLE, BridgeState::STOPPING_TRAFFIC},
+    {BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, {}, {}, "both", "Yellow"},
+    {BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, {}, {}, "both", "Red"},
+    {BridgeEvent::TRAFFIC_STOPPED_SUCCESS},
+    {BridgeEvent::STATE_CHANGED, BridgeState::STOPPING_TRAFFIC, BridgeState::OPENING},
+    {BridgeEvent::BRIDGE_OPENED_SUCCESS},
+    {BridgeEvent::STATE_CHANGED, BridgeState::OPENING, BridgeState::OPEN},
+    {BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, {}, {}, "left", "Green"},
+    {BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, {}, {}, "right", "Red"},
+    {BridgeEvent::BOAT_PASSED_LEFT},
+    {BridgeEvent::BOAT_PASSED},
+    {BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED},
+    {BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, {}, {}, "left", "Red"},
+    {BridgeEvent::STATE_CHANGED, BridgeState::OPEN, BridgeState::CLOSING},
+    {BridgeEvent::BRIDGE_CLOSED_SUCCESS},
+    {BridgeEvent::STATE_CHANGED, BridgeState::CLOSING, BridgeState::RESUMING_TRAFFIC},
+    {BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, {}, {}, "both", "Green"},
+    {BridgeEvent::TRAFFIC_RESUMED_SUCCESS},
+    {BridgeEvent::STATE_CHANGED, BridgeState::RESUMING_TRAFFIC, BridgeState::IDLE},
+};
+
+void publishStep(EventBus& bus, const CycleStep& step) {
+    switch (step.event) {
+        case BridgeEvent::STATE_CHANGED:
+            bus.emplace<StateChangeData>(step.to, step.from);
+            break;
+        case BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS:
+            bus.emplace<LightChangeData>(String(step.side), String(step.colour), true);
+            break;
+        case BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS:
+            bus.emplace<LightChangeData>(String(step.side), String(step.colour), false);
+            break;
+        default:
+            bus.emplace<SimpleEventData>(step.event);
+            break;
+    }
+}
+
+// A typical UI request: the boat light override on the control panel
+const char* const SET_REQUEST =
+    "{\"v\":1,\"id\":\"bench-1\",\"type\":\"request\",\"method\":\"SET\","
+    "\"path\":\"/traffic/boat/light\",\"payload\":{\"side\":\"left\",\"value\":\"Green\"}}";
+
+// StateWriter as wired in setup(), with its activity log already full (the steady state)
+struct StateFixture {
+    EventBus bus;
+    StateWriter state{bus};
+
+    StateFixture() {
+        Logger::setLevel(Logger::Level::WARN);
+        state.beginSubscriptions();
+        bus.seal();
+        for (size_t i = 0; i < ActivityLog::DEFAULT_CAPACITY; ++i) {
+            bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+            bus.processEvents();
+        }
+    }
+};
+
+}  // namespace
+
+// StateWriter::applyEvent (and its typed siblings) via the bus, one event type per run
+static void BM_StateWriterApplyEvent(benchmark::State& state) {
+    StateFixture f;
+    const EventCase& c = EVENT_CASES[state.range(0)];
+    state.SetLabel(bridgeEventToString(c.event));
+
+    for (auto _ : state) {
+        c.publish(f.bus, c.event);
+        benchmark::DoNotOptimize(f.bus.processEvents());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StateWriterApplyEvent)->DenseRange(0, EVENT_CASE_COUNT - 1);
+
+// 10k events through StateWriter - the boat cycle over and over, each published and
+// applied on its own. stateBytes is what every reader copies per load; allocsPerEvent
+// counts all heap allocations on the path, the payload Strings the publisher builds
+// included. The host String keeps short text inline, so on the ESP32 (where every String
+// owns a heap buffer) the old String-field model allocates more than it shows here.
+static void BM_StateWriterEventStream(benchmark::State& state) {
+    constexpr size_t EVENTS = 10000;
+    constexpr size_t CYCLE_STEPS = sizeof(BOAT_CYCLE) / sizeof(BOAT_CYCLE[0]);
+    StateFixture f;
+
+    uint64_t allocations = 0;
+    for (auto _ : state) {
+        const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < EVENTS; ++i) {
+            publishStep(f.bus, BOAT_CYCLE[i % CYCLE_STEPS]);
+            f.bus.processEvents();
+        }
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+    }
+    const double events = static_cast<double>(state.iterations()) * EVENTS;
+    state.SetItemsProcessed(static_cast<int64_t>(events));
+    state.counters["stateBytes"] = sizeof(UiState);
+    state.counters["allocsPerEvent"] = static_cast<double>(allocations) / events;
+}
+BENCHMARK(BM_StateWriterEventStream)->Unit(benchmark::kMillisecond);
+
+// buildSnapshot() alone, as sent to a client on connect
+static void BM_StateWriterBuildSnapshot(benchmark::State& state) {
+    StateFixture f;
+    for (auto _ : state) {
+        DynamicJsonDocument doc(1024);
+        f.state.buildSnapshot(doc);
+        benchmark::DoNotOptimize(doc.size());
+    }
+}
+BENCHMARK(BM_StateWriterBuildSnapshot);
+
+// serializeJson() of a built snapshot into a String
+static void BM_SnapshotSerialize(benchmark::State& state) {
+    StateFixture f;
+    DynamicJsonDocument doc(1024);
+    f.state.buildSnapshot(doc);
+    size_t bytes = 0;
+    for (auto _ : state) {
+        String out;
+        serializeJson(doc, out);
+        bytes += out.length();
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_SnapshotSerialize);
+
+// The serialize-once path GETs, connects and resyncs share: a warm cache is a String copy
+static void BM_StateWriterCachedSnapshot(benchmark::State& state) {
+    StateFixture f;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        bytes += f.state.snapshotPayloadJson().length();
+    }
+    state.SetBytesProcessed(bytes);
+    state.counters["misses"] = f.state.cacheStats().misses;
+}
+BENCHMARK(BM_StateWriterCachedSnapshot);
+
+// What a full-snapshot broadcast costs: build + serialize
+static void BM_SnapshotBuildAndSerialize(benchmark::State& state) {
+    StateFixture f;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        DynamicJsonDocument doc(1024);
+        f.state.buildSnapshot(doc);
+        String out;
+        serializeJson(doc, out);
+        bytes += out.length();
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_SnapshotBuildAndSerialize);
+
+// Bytes one client receives per bridge cycle when every event is broadcast on its own
+// (the worst case - coalescing only lowers it): arg 0 a full snapshot each time, as
+// before /system/patch, arg 1 a patch since the previous broadcast
+static void BM_BridgeCycleBytes(benchmark::State& state) {
+    StateFixture f;
+    const bool patches = state.range(0) != 0;
+    state.SetLabel(patches ? "patch" : "snapshot");
+
+    uint32_t version = f.state.version();
+    size_t bytes = 0;
+    size_t messages = 0;
+    for (auto _ : state) {
+        for (const CycleStep& step : BOAT_CYCLE) {
+            publishStep(f.bus, step);
+            f.bus.processEvents();
+            if (f.state.version() == version) {
+                continue;  // No broadcast for an event that changed nothing
+            }
+
+            DynamicJsonDocument doc(1024);
+            if (!patches || !f.state.buildPatch(doc, version)) {
+                doc.clear();
+                f.state.buildSnapshot(doc);
+            }
+            version = doc["payload"]["seq"];
+            String out;
+            serializeJson(doc, out);
+            bytes += out.length();
+            messages++;
+        }
+    }
+    state.counters["bytesPerCycle"] = benchmark::Counter(static_cast<double>(bytes) / state.iterations());
+    state.counters["messagesPerCycle"] = benchmark::Counter(static_cast<double>(messages) / state.iterations());
+}
+BENCHMARK(BM_BridgeCycleBytes)->Arg(0)->Arg(1);
+
+// WebSocketServer::handleWsEvent for one SET request: parse, dispatch, build + send the response
+static void BM_WebSocketSetRequest(benchmark::State& state) {
+    StateFixture f;
+    CommandBus commandBus;
+    DetectionSystem detection(f.bus);
+    WebSocketServer server(80, f.state, commandBus, f.bus, detection);
+
+    // The native WiFi connects on the first attempt; the next loop starts the server
+    server.configureWiFi("bench", "bench");
+    server.networkLoop();
+    server.networkLoop();
+    AsyncWebSocket* ws = AsyncWebSocket::find("/ws");
+    if (!ws) {
+        state.SkipWithError("WebSocket server did not start");
+        return;
+    }
+
+    size_t responseBytes = 0;
+    const uint32_t client = ws->connectClient([r = &responseBytes](uint32_t, bool, const uint8_t*, size_t len) {
+        *r += len;
+    });
+    const String request(SET_REQUEST);
+    for (auto _ : state) {
+        ws->receiveText(client, request);
+    }
+    ws->disconnectClient(client);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["responseBytes"] = benchmark::Counter(static_cast<double>(responseBytes) / state.iterations());
+}
+BENCHMARK(BM_WebSocketSetRequest);
@@ -14,7 +14,7 @@ function App() {
   const { packetsSent, packetsReceived, lastSentAt, lastReceivedAt, incrementSent, incrementReceived } =
     usePacketTracking();
 
-  const { activityLog, logActivity } = useActivityLog();
+  const { activityLog, logActivity, receiveDeviceLog, syncDeviceLog } = useActivityLog();
 
   const {
     bridgeStatus,
@@ -40,7 +40,8 @@ function App() {
     setBoatTrafficStatus,
     setSystemStatus,
     incrementReceived,
-    logActivity,
+    receiveDeviceLog,
+    syncDeviceLog,
     carTrafficStatus,
     boatTrafficStatus,
   });
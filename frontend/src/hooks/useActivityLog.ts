@@ -1,19 +1,88 @@
-import { useState } from "react";
+import { useCallback, useRef, useState } from "react";
 import { ActivityEntry } from "../types/GenTypes";
+import { getLog } from "../lib/api";
+import { ActivityLogLine } from "../lib/schema";
 
 export function useActivityLog() {
   const [activityLog, setActivityLog] = useState<ActivityEntry[]>([]);
+  const deviceSeqRef = useRef<number>(-1); // Last ESP log line shown
+  const pullingRef = useRef(false);
+  const heldLinesRef = useRef<ActivityLogLine[]>([]); // Patch lines that arrived mid-pull
 
-  const logActivity = (type: "sent" | "received", message: string) => {
+  const logActivity = useCallback((type: "sent" | "received", message: string) => {
     setActivityLog((prev) => [
       { type, message, timestamp: Date.now() },
       ...prev.slice(0, 49),
     ]);
-  };
+  }, []);
+
+  // Each ESP line once, in seq order
+  const showDeviceLines = useCallback(
+    (lines: ActivityLogLine[]) => {
+      for (const line of lines) {
+        if (line.seq > deviceSeqRef.current) {
+          logActivity("received", line.text);
+          deviceSeqRef.current = line.seq;
+        }
+      }
+    },
+    [logActivity]
+  );
+
+  // Fetches only the ESP lines after the last one shown (the newest page the first time)
+  const pullDeviceLog = useCallback(async () => {
+    if (pullingRef.current) return;
+    pullingRef.current = true;
+    try {
+      for (;;) {
+        const since = deviceSeqRef.current;
+        const page = await getLog(since >= 0 ? since : undefined);
+        if (page.dropped > 0) {
+          logActivity("received", `(${page.dropped} earlier log lines no longer on the device)`);
+        }
+        showDeviceLines(page.lines);
+        if (!page.more || page.lines.length === 0) break;
+      }
+    } catch (err) {
+      console.error("Activity log fetch error:", err);
+    } finally {
+      pullingRef.current = false;
+      const held = heldLinesRef.current;
+      heldLinesRef.current = [];
+      showDeviceLines(held);
+    }
+  }, [logActivity, showDeviceLines]);
+
+  // Lines pushed with a /system/patch
+  const receiveDeviceLog = useCallback(
+    (lines: ActivityLogLine[]) => {
+      if (pullingRef.current) {
+        heldLinesRef.current.push(...lines); // Shown after the older lines being fetched
+        return;
+      }
+      showDeviceLines(lines);
+    },
+    [showDeviceLines]
+  );
+
+  // A snapshot's "logNext": pull what we lack. Behind our cursor means the ESP restarted
+  // its log (a reboot), so start over from its newest lines.
+  const syncDeviceLog = useCallback(
+    (logNext: number) => {
+      if (logNext - 1 < deviceSeqRef.current) {
+        deviceSeqRef.current = -1;
+      }
+      if (logNext - 1 > deviceSeqRef.current) {
+        pullDeviceLog();
+      }
+    },
+    [pullDeviceLog]
+  );
 
   return {
     activityLog,
     logActivity,
+    receiveDeviceLog,
+    syncDeviceLog,
   };
 }
-
@@ -1,32 +1,16 @@
 import { useEffect, useRef, useState } from "react";
-import { getESPClient, getBridgeState, getCarTrafficState, getBoatTrafficState, getSystemState, reconnectWebSocket } from "../lib/api";
-import { BridgeStatus, CarTrafficStatus, BoatTrafficStatus, SystemStatus, EventMsgT } from "../lib/schema";
+import { getESPClient, getBridgeState, getCarTrafficState, getBoatTrafficState, getSystemState, getSnapshot, reconnectWebSocket } from "../lib/api";
+import { BridgeStatus, CarTrafficStatus, BoatTrafficStatus, SystemStatus, EventMsgT, ActivityLogLine } from "../lib/schema";
 import { IP } from "../types/GenTypes";
 
-function parseLogLine(line: string): { sequence: number | null; message: string } {
-  const separatorIndex = line.indexOf("|");
-  if (separatorIndex === -1) {
-    return { sequence: null, message: line };
-  }
-
-  const possibleSeq = Number(line.slice(0, separatorIndex));
-  if (!Number.isFinite(possibleSeq)) {
-    return { sequence: null, message: line };
-  }
-
-  return {
-    sequence: possibleSeq,
-    message: line.slice(separatorIndex + 1).trim(),
-  };
-}
-
 interface UseESPWebSocketProps {
   setBridgeStatus: React.Dispatch<React.SetStateAction<BridgeStatus | null>>;
   setCarTrafficStatus: React.Dispatch<React.SetStateAction<CarTrafficStatus | null>>;
   setBoatTrafficStatus: React.Dispatch<React.SetStateAction<BoatTrafficStatus | null>>;
   setSystemStatus: React.Dispatch<React.SetStateAction<SystemStatus | null>>;
   incrementReceived: (count?: number) => void;
-  logActivity: (type: "sent" | "received", message: string) => void;
+  receiveDeviceLog: (lines: ActivityLogLine[]) => void;
+  syncDeviceLog: (logNext: number) => void;
   carTrafficStatus: CarTrafficStatus | null;
   boatTrafficStatus: BoatTrafficStatus | null;
 }
@@ -42,13 +26,14 @@ export function useESPWebSocket({
   setBoatTrafficStatus,
   setSystemStatus,
   incrementReceived,
-  logActivity,
+  receiveDeviceLog,
+  syncDeviceLog,
   carTrafficStatus,
   boatTrafficStatus,
 }: UseESPWebSocketProps) {
   const lastBridgeStateRef = useRef<string | null>(null);
-  const lastLogSeqRef = useRef<number>(-1);
-  const legacyLogRef = useRef<Set<string>>(new Set());
+  const stateSeqRef = useRef<number | null>(null);
+  const resyncingRef = useRef(false);
   const clientRef = useRef<ReturnType<typeof getESPClient> | null>(null);
   const pollFunctionRef = useRef<(() => Promise<void>) | null>(null);
 
@@ -56,13 +41,15 @@ export function useESPWebSocket({
     const client = getESPClient(IP.AARON_4);
     clientRef.current = client;
 
-    client.onEvent((evt: EventMsgT) => {
-      if (evt.type !== "event" || evt.path !== "/system/snapshot") return;
-      const payload: any = evt.payload || {};
+    // Applies whichever sections the payload carries (a snapshot has all of them)
+    const applyState = (payload: any) => {
+      if (typeof payload.seq === "number") {
+        if (stateSeqRef.current !== null && payload.seq < stateSeqRef.current) return; // Stale resync
+        stateSeqRef.current = payload.seq;
+      }
       const bridge = payload.bridge || {};
       const traffic = payload.traffic || {};
       const sys = payload.system || {};
-      const logArr: string[] = Array.isArray(payload.log) ? payload.log : [];
 
       if (bridge.state)
         setBridgeStatus({
@@ -114,32 +101,46 @@ export function useESPWebSocket({
         incrementReceived();
       }
 
-      if (logArr.length) {
-        const seenLegacy = legacyLogRef.current;
-        let highestSequence = lastLogSeqRef.current;
-
-        for (const line of logArr) {
-          const { sequence, message } = parseLogLine(line);
-          if (sequence !== null) {
-            if (sequence > highestSequence) {
-              logActivity("received", message);
-              highestSequence = sequence;
-            }
-            continue;
-          }
-
-          if (!seenLegacy.has(message)) {
-            logActivity("received", message);
-            seenLegacy.add(message);
-          }
-        }
-
-        if (seenLegacy.size > 512) {
-          legacyLogRef.current = new Set(Array.from(seenLegacy).slice(-256));
-        }
-
-        lastLogSeqRef.current = highestSequence;
+      // Patches bring their new log lines; a snapshot only says where the log is up to
+      if (Array.isArray(payload.log)) receiveDeviceLog(payload.log);
+      if (typeof payload.logNext === "number") syncDeviceLog(payload.logNext);
+    };
+
+    // Snapshots and patches carry the state version ("seq") they bring the UI to; a patch
+    // also says which version it starts from. A patch starting past ours means we missed
+    // one, so fetch a full snapshot instead of applying it.
+    const resync = async () => {
+      if (resyncingRef.current) return;
+      resyncingRef.current = true;
+      try {
+        const snapshot = await getSnapshot();
+        incrementReceived();
+        applyState(snapshot);
+      } catch (err) {
+        console.error("Snapshot resync error:", err);
+      } finally {
+        resyncingRef.current = false;
+      }
+    };
+
+    client.onEvent((evt: EventMsgT) => {
+      if (evt.type !== "event") return;
+      const payload: any = evt.payload || {};
+      if (evt.path === "/system/snapshot") {
+        stateSeqRef.current = null; // Sent on connect - the ESP may have rebooted, so take it as is
+        applyState(payload);
+        return;
+      }
+      if (evt.path !== "/system/patch") return;
+
+      const from = Number(payload.from);
+      const seq = Number(payload.seq);
+      if (stateSeqRef.current === null || from > stateSeqRef.current) {
+        resync();
+        return;
       }
+      if (seq <= stateSeqRef.current) return; // Already covered by a newer snapshot
+      applyState(payload);
     });
 
     const poll = async () => {
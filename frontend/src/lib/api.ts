@@ -6,6 +6,8 @@ import type {
   SystemStatus,
   ResetResponse,
   SimulationSensorsStatus,
+  StateSnapshot,
+  ActivityLogPage,
 } from "./schema";
 
 let client: ESPWebSocketClient | null = null;
@@ -36,6 +38,16 @@ export const getBoatTrafficState = () =>
 
 export const getSystemState = () => getESPClient().request<SystemStatus>("GET", "/system/status");
 
+// Full state with its version; used to resync after a gap in /system/patch events
+export const getSnapshot = () => getESPClient().request<StateSnapshot>("GET", "/system/snapshot");
+
+// Activity log lines after `since` (the newest page if omitted)
+export const getLog = (since?: number) =>
+  getESPClient().request<ActivityLogPage>(
+    "GET",
+    since === undefined ? "/system/log" : `/system/log?since=${since}`
+  );
+
 export const setBridgeState = (state: "Open" | "Closed") =>
   getESPClient().request<BridgeStatus, { state: "Open" | "Closed" }>("SET", "/bridge/state", {
     state,
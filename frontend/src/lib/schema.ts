@@ -98,6 +98,37 @@ export interface SystemStatus {
   receivedAt?: number;
 }
 
+// One ESP activity log line; seq goes up by one per line
+export interface ActivityLogLine {
+  seq: number;
+  ms: number; // ESP uptime when logged
+  text: string;
+}
+
+// Payload of /system/snapshot (every section, plus "logNext", the first log line it does
+// not cover) and /system/patch (changed sections and new log lines only, plus "from")
+export interface StateSnapshot {
+  seq: number;
+  from?: number;
+  bridge?: Partial<BridgeStatus> & { manualMode?: boolean };
+  traffic?: {
+    car?: Partial<CarTrafficStatus>;
+    boat?: Partial<BoatTrafficStatus>;
+  };
+  system?: Partial<SystemStatus>;
+  log?: ActivityLogLine[];
+  logNext?: number;
+}
+
+// Payload of /system/log: lines after "since" (-1 = the newest page), oldest first
+export interface ActivityLogPage {
+  since: number;
+  next: number; // Seq the ESP's next line will get
+  dropped: number; // Lines after "since" already overwritten on the ESP
+  more: boolean; // Ask again from the last line
+  lines: ActivityLogLine[];
+}
+
 export interface Timed<T> {
   receivedAt: number;
   data: T;
@@ -0,0 +1,372 @@
+#include "Arduino.h"
+
+#include <poll.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "NativeHal.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+
+struct Pin {
+    uint8_t mode = 0;
+    int input = -1;  // -1 = not set by the simulation
+    int output = LOW;
+    int analog = 0;
+    unsigned long pulseUs = 0;
+};
+
+std::mutex pinsMutex;
+std::array<Pin, NativeHal::PIN_COUNT> pins;
+std::atomic<uint32_t> writes{0};
+NativeHal::OutputObserver outputObserver = nullptr;
+void* outputObserverContext = nullptr;
+
+std::mutex serialMutex;
+std::deque<char> serialInput;
+
+Pin* pinAt(uint8_t pin) {
+    return pin < pins.size() ? &pins[pin] : nullptr;
+}
+
+void notifyOutput(uint8_t pin, int value) {
+    NativeHal::OutputObserver observer;
+    void* context;
+    {
+        std::lock_guard<std::mutex> lock(pinsMutex);
+        observer = outputObserver;
+        context = outputObserverContext;
+    }
+    if (observer) {
+        observer(context, pin, value);
+    }
+}
+
+const auto startTime = std::chrono::steady_clock::now();
+
+}  // namespace
+
+// ---------------------------------------------------------------- String
+
+bool String::equalsIgnoreCase(const String& other) const {
+    return s_.size() == other.s_.size() &&
+           std::equal(s_.begin(), s_.end(), other.s_.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+bool String::endsWith(const String& suffix) const {
+    return s_.size() >= suffix.s_.size() && s_.compare(s_.size() - suffix.s_.size(), suffix.s_.size(), suffix.s_) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        std::swap(from, to);
+    }
+    if (from >= s_.size()) {
+        return String();
+    }
+    return String(s_.substr(from, to - from));
+}
+
+void String::toLowerCase() {
+    for (char& c : s_) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : s_) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::trim() {
+    const size_t first = s_.find_first_not_of(" \t\r\n\f\v");
+    if (first == std::string::npos) {
+        s_.clear();
+        return;
+    }
+    const size_t last = s_.find_last_not_of(" \t\r\n\f\v");
+    s_ = s_.substr(first, last - first + 1);
+}
+
+void String::replace(const String& find, const String& with) {
+    if (find.s_.empty()) {
+        return;
+    }
+    for (size_t pos = s_.find(find.s_); pos != std::string::npos; pos = s_.find(find.s_, pos + with.s_.size())) {
+        s_.replace(pos, find.s_.size(), with.s_);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < s_.size()) {
+        s_.erase(index, count);
+    }
+}
+
+std::string String::format(long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+        return "-" + formatUnsigned(static_cast<unsigned long>(-(value + 1)) + 1, base);
+    }
+    return formatUnsigned(static_cast<unsigned long>(value), base);
+}
+
+std::string String::formatUnsigned(unsigned long value, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+    std::string digits;
+    do {
+        const unsigned digit = static_cast<unsigned>(value % base);
+        digits.insert(digits.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10));
+        value /= base;
+    } while (value != 0);
+    return digits;
+}
+
+std::string String::formatFloat(double value, unsigned char decimals) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    return buffer;
+}
+
+// ---------------------------------------------------------------- Serial
+
+void HardwareSerial::begin(unsigned long) {
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+}
+
+int HardwareSerial::available() {
+    {
+        std::lock_guard<std::mutex> lock(serialMutex);
+        if (!serialInput.empty()) {
+            return static_cast<int>(serialInput.size());
+        }
+    }
+    if (eof_) {
+        return 0;
+    }
+    pollfd fd{STDIN_FILENO, POLLIN, 0};
+    if (poll(&fd, 1, 0) <= 0 || !(fd.revents & (POLLIN | POLLHUP))) {
+        return 0;
+    }
+    char buffer[256];
+    const ssize_t n = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (n <= 0) {
+        eof_ = true;  // Input closed (e.g. piped script finished) - stop polling it
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(serialMutex);
+    serialInput.insert(serialInput.end(), buffer, buffer + n);
+    return static_cast<int>(serialInput.size());
+}
+
+int HardwareSerial::read() {
+    if (available() == 0) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(serialMutex);
+    const char c = serialInput.front();
+    serialInput.pop_front();
+    return static_cast<unsigned char>(c);
+}
+
+String HardwareSerial::readStringUntil(char terminator) {
+    // Like the Arduino version, gives up when input runs dry (no 1 s timeout here)
+    std::string line;
+    for (int c = read(); c >= 0 && c != terminator; c = read()) {
+        line += static_cast<char>(c);
+    }
+    return String(line);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return std::fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+    return std::fwrite(data, 1, len, stdout);
+}
+
+void HardwareSerial::flush() {
+    std::fflush(stdout);
+}
+
+int HardwareSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int n = std::vprintf(format, args);
+    va_end(args);
+    return n;
+}
+
+// ---------------------------------------------------------------- GPIO
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    if (Pin* p = pinAt(pin)) {
+        p->mode = mode;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    {
+        std::lock_guard<std::mutex> lock(pinsMutex);
+        Pin* p = pinAt(pin);
+        if (!p) {
+            return;
+        }
+        p->output = value ? HIGH : LOW;
+        writes.fetch_add(1, std::memory_order_relaxed);
+    }
+    notifyOutput(pin, value ? HIGH : LOW);
+}
+
+int digitalRead(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    const Pin* p = pinAt(pin);
+    if (!p) {
+        return LOW;
+    }
+    if (p->input >= 0) {
+        return p->input;
+    }
+    if (p->mode == OUTPUT) {
+        return p->output;
+    }
+    return p->mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    {
+        std::lock_guard<std::mutex> lock(pinsMutex);
+        Pin* p = pinAt(pin);
+        if (!p) {
+            return;
+        }
+        p->analog = value;
+        writes.fetch_add(1, std::memory_order_relaxed);
+    }
+    notifyOutput(pin, value);
+}
+
+int analogRead(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    const Pin* p = pinAt(pin);
+    return p && p->input > 0 ? 4095 : 0;
+}
+
+unsigned long pulseIn(uint8_t pin, uint8_t, unsigned long timeoutUs) {
+    unsigned long width = 0;
+    {
+        std::lock_guard<std::mutex> lock(pinsMutex);
+        if (const Pin* p = pinAt(pin)) {
+            width = p->pulseUs;
+        }
+    }
+    return width <= timeoutUs ? width : 0;
+}
+
+// ---------------------------------------------------------------- Timing
+
+unsigned long millis() {
+    return static_cast<unsigned long>(static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count()));
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()));
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+    if (fromHigh == fromLow) {
+        return toLow;
+    }
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+void EspClass::restart() {
+    std::fflush(stdout);
+    std::exit(0);
+}
+
+// ---------------------------------------------------------------- Simulation hooks
+
+namespace NativeHal {
+
+void setDigitalInput(uint8_t pin, int level) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    if (Pin* p = pinAt(pin)) {
+        p->input = level ? HIGH : LOW;
+    }
+}
+
+void setPulseWidth(uint8_t pin, unsigned long widthUs) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    if (Pin* p = pinAt(pin)) {
+        p->pulseUs = widthUs;
+    }
+}
+
+int digitalOutput(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    const Pin* p = pinAt(pin);
+    return p ? p->output : LOW;
+}
+
+int analogOutput(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    const Pin* p = pinAt(pin);
+    return p ? p->analog : 0;
+}
+
+uint32_t outputWrites() {
+    return writes.load(std::memory_order_relaxed);
+}
+
+void setOutputObserver(OutputObserver observer, void* context) {
+    std::lock_guard<std::mutex> lock(pinsMutex);
+    outputObserver = observer;
+    outputObserverContext = context;
+}
+
+void pushSerialInput(const std::string& text) {
+    std::lock_guard<std::mutex> lock(serialMutex);
+    serialInput.insert(serialInput.end(), text.begin(), text.end());
+}
+
+void reset() {
+    {
+        std::lock_guard<std::mutex> lock(pinsMutex);
+        pins.fill(Pin());
+        outputObserver = nullptr;
+        outputObserverContext = nullptr;
+    }
+    writes.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(serialMutex);
+    serialInput.clear();
+}
+
+}  // namespace NativeHal
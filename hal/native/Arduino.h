@@ -0,0 +1,181 @@
+#pragma once
+
+// Native (Linux) stand-in for the ESP32 Arduino core: String, Serial, GPIO and timing.
+// Pins are simulated (see NativeHal.h); Serial is stdin/stdout.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+typedef uint8_t byte;
+
+// Arduino WString subset, backed by std::string
+class String {
+public:
+    String() = default;
+    String(const char* cstr) : s_(cstr ? cstr : "") {}
+    String(const char* cstr, unsigned int length) : s_(cstr ? std::string(cstr, length) : std::string()) {}
+    String(const std::string& str) : s_(str) {}
+    explicit String(char c) : s_(1, c) {}
+    explicit String(int value, unsigned char base = 10) : s_(format(static_cast<long>(value), base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : s_(formatUnsigned(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : s_(format(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : s_(formatUnsigned(value, base)) {}
+    explicit String(float value, unsigned char decimals = 2) : s_(formatFloat(value, decimals)) {}
+    explicit String(double value, unsigned char decimals = 2) : s_(formatFloat(value, decimals)) {}
+
+    String& operator=(const char* cstr) {
+        s_ = cstr ? cstr : "";
+        return *this;
+    }
+
+    const char* c_str() const { return s_.c_str(); }
+    unsigned int length() const { return static_cast<unsigned int>(s_.size()); }
+    bool isEmpty() const { return s_.empty(); }
+    bool reserve(unsigned int size) {
+        s_.reserve(size);
+        return true;
+    }
+
+    char charAt(unsigned int index) const { return index < s_.size() ? s_[index] : '\0'; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    bool concat(const String& str) { s_ += str.s_; return true; }
+    bool concat(const char* cstr) { if (cstr) s_ += cstr; return true; }
+    bool concat(const char* cstr, unsigned int length) { if (cstr) s_.append(cstr, length); return true; }
+    bool concat(char c) { s_ += c; return true; }
+
+    String& operator+=(const String& str) { concat(str); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    bool equals(const String& other) const { return s_ == other.s_; }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const { return s_.compare(0, prefix.s_.size(), prefix.s_) == 0; }
+    bool endsWith(const String& suffix) const;
+
+    int indexOf(char c, unsigned int from = 0) const { return position(s_.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return position(s_.find(str.s_, from)); }
+    int lastIndexOf(char c) const { return position(s_.rfind(c)); }
+
+    String substring(unsigned int from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+    void replace(const String& find, const String& with);
+    void remove(unsigned int index, unsigned int count = static_cast<unsigned int>(-1));
+
+    long toInt() const { return std::strtol(s_.c_str(), nullptr, 10); }
+    float toFloat() const { return std::strtof(s_.c_str(), nullptr); }
+
+    bool operator==(const String& other) const { return s_ == other.s_; }
+    bool operator!=(const String& other) const { return s_ != other.s_; }
+    bool operator==(const char* cstr) const { return s_ == (cstr ? cstr : ""); }
+    bool operator!=(const char* cstr) const { return !(*this == cstr); }
+    bool operator<(const String& other) const { return s_ < other.s_; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+    friend String operator+(const String& a, const char* b) { return String(a.s_ + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.s_); }
+    friend String operator+(const String& a, char c) { return String(a.s_ + c); }
+
+private:
+    static int position(size_t pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+    static std::string format(long value, unsigned char base);
+    static std::string formatUnsigned(unsigned long value, unsigned char base);
+    static std::string formatFloat(double value, unsigned char decimals);
+
+    std::string s_;
+};
+
+// Serial port on stdin/stdout. available()/read() never block.
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    operator bool() const { return true; }
+
+    int available();
+    int read();
+    String readStringUntil(char terminator);
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t* data, size_t len);
+    size_t write(const char* str) { return write(reinterpret_cast<const uint8_t*>(str), std::strlen(str)); }
+    void flush();
+    int availableForWrite() { return 4096; }  // stdout never pushes back
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str()); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int decimals = 2) { return printf("%.*f", decimals, value); }
+
+    size_t println() { return write("\n"); }
+    template <typename T>
+    size_t println(const T& value) {
+        const size_t n = print(value);
+        return n + println();
+    }
+
+private:
+    bool eof_ = false;
+};
+
+extern HardwareSerial Serial;
+
+// GPIO - backed by the simulated pin table in NativeHal.h
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int analogRead(uint8_t pin);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeoutUs = 1000000UL);
+
+// Timing - real time since start-up (firmware modules read time through Clock.h)
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+template <typename T, typename L, typename H>
+T constrain(T value, L low, H high) {
+    return value < low ? static_cast<T>(low) : (value > high ? static_cast<T>(high) : value);
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh);
+
+// Heap figures reported by the firmware at boot; a Linux process has no fixed heap
+class EspClass {
+public:
+    uint32_t getHeapSize() { return 0; }
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getFreePsram() { return 0; }
+    void restart();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,3 @@
+#pragma once
+
+// Native (Linux) stand-in: the firmware includes AsyncUDP but sends nothing over it
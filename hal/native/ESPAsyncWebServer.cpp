@@ -0,0 +1,192 @@
+#include "ESPAsyncWebServer.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Sockets attached with addHandler(), by URL (see AsyncWebSocket::find())
+std::mutex registryMutex;
+std::unordered_map<std::string, AsyncWebSocket*> registry;
+
+}  // namespace
+
+void AsyncWebServerRequest::send(int, const char*, const String&) {
+    // No HTTP transport on the native build
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler) {
+    if (auto* socket = dynamic_cast<AsyncWebSocket*>(handler)) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry[socket->url().c_str()] = socket;
+    }
+    return *handler;
+}
+
+void AsyncWebSocketClient::text(const char* message, size_t len) {
+    if (sink_) {
+        sink_(id_, false, reinterpret_cast<const uint8_t*>(message), len);
+    }
+}
+
+void AsyncWebSocketClient::text(AsyncWebSocketMessageBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(server_->mutex_);
+    (*buffer)++;
+    text(reinterpret_cast<const char*>(buffer->get()), buffer->length());
+    (*buffer)--;
+    // Like the real library, the buffer stays on the socket until the next textAll()/binaryAll()
+}
+
+void AsyncWebSocketClient::binary(const uint8_t* data, size_t len) {
+    if (sink_) {
+        sink_(id_, true, data, len);
+    }
+}
+
+void AsyncWebSocketClient::close(uint16_t, const char*) {
+    server_->disconnectClient(id_);
+}
+
+AsyncWebSocket::~AsyncWebSocket() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = registry.find(url_.c_str());
+    if (it != registry.end() && it->second == this) {
+        registry.erase(it);
+    }
+}
+
+AsyncWebSocket* AsyncWebSocket::find(const String& url) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = registry.find(url.c_str());
+    return it == registry.end() ? nullptr : it->second;
+}
+
+void AsyncWebSocket::onEvent(AwsEventHandler handler) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    handler_ = std::move(handler);
+}
+
+size_t AsyncWebSocket::count() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return clients_.size();
+}
+
+AsyncWebSocketClient* AsyncWebSocket::client(uint32_t id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto it = clients_.find(id);
+    return it == clients_.end() ? nullptr : it->second.get();
+}
+
+void AsyncWebSocket::textAll(const char* message, size_t len) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    for (auto& entry : clients_) {
+        entry.second->text(message, len);
+    }
+    cleanBuffers();
+}
+
+void AsyncWebSocket::textAll(AsyncWebSocketMessageBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    buffer->lock();
+    for (auto& entry : clients_) {
+        (*buffer)++;
+        entry.second->text(reinterpret_cast<const char*>(buffer->get()), buffer->length());
+        (*buffer)--;
+    }
+    buffer->unlock();
+    cleanBuffers();
+}
+
+AsyncWebSocketMessageBuffer* AsyncWebSocket::makeBuffer(size_t size) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    buffers_.push_back(std::make_unique<AsyncWebSocketMessageBuffer>(size));
+    return buffers_.back().get();
+}
+
+AsyncWebSocketMessageBuffer* AsyncWebSocket::makeBuffer(const uint8_t* data, size_t size) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    buffers_.push_back(std::make_unique<AsyncWebSocketMessageBuffer>(data, size));
+    return buffers_.back().get();
+}
+
+void AsyncWebSocket::binaryAll(const uint8_t* data, size_t len) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    for (auto& entry : clients_) {
+        entry.second->binary(data, len);
+    }
+    cleanBuffers();
+}
+
+void AsyncWebSocket::closeAll(uint16_t, const char*) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::vector<uint32_t> ids;
+    for (const auto& entry : clients_) {
+        ids.push_back(entry.first);
+    }
+    for (uint32_t id : ids) {
+        disconnectClient(id);
+    }
+}
+
+uint32_t AsyncWebSocket::connectClient(AsyncWebSocketClient::FrameSink sink) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const uint32_t id = nextId_++;
+    auto client = std::make_unique<AsyncWebSocketClient>(this, id, std::move(sink));
+    AsyncWebSocketClient* raw = client.get();
+    clients_.emplace(id, std::move(client));
+    raise(raw, WS_EVT_CONNECT, nullptr, nullptr, 0);
+    return id;
+}
+
+void AsyncWebSocket::disconnectClient(uint32_t id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto it = clients_.find(id);
+    if (it == clients_.end()) {
+        return;
+    }
+    std::unique_ptr<AsyncWebSocketClient> client = std::move(it->second);
+    clients_.erase(it);
+    raise(client.get(), WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+}
+
+bool AsyncWebSocket::receiveText(uint32_t id, const String& message) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    AsyncWebSocketClient* target = client(id);
+    if (!target) {
+        return false;
+    }
+    AwsFrameInfo info{};
+    info.message_opcode = WS_TEXT;
+    info.opcode = WS_TEXT;
+    info.final = 1;
+    info.index = 0;
+    info.len = message.length();
+    std::vector<uint8_t> data(message.c_str(), message.c_str() + message.length());
+    raise(target, WS_EVT_DATA, &info, data.data(), data.size());
+    return true;
+}
+
+// Caller holds mutex_
+size_t AsyncWebSocket::bufferCount() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return buffers_.size();
+}
+
+void AsyncWebSocket::cleanBuffers() {
+    buffers_.remove_if([](const std::unique_ptr<AsyncWebSocketMessageBuffer>& buffer) {
+        return buffer->canDelete();
+    });
+}
+
+void AsyncWebSocket::raise(AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len) {
+    if (handler_) {
+        handler_(this, client, type, arg, data, len);
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+// Native (Linux) stand-in for ESPAsyncWebServer. There is no socket: a WebSocket is a
+// loopback whose clients are attached in-process (connectClient()), so tests, benchmarks
+// and the native firmware can exchange frames with WebSocketServer directly.
+
+#include <Arduino.h>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class AsyncWebSocket;
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+
+typedef struct {
+    uint8_t message_opcode;
+    uint32_t num;
+    uint8_t final;
+    uint8_t masked;
+    uint8_t opcode;
+    uint64_t len;
+    uint8_t mask[4];
+    uint64_t index;
+} AwsFrameInfo;
+
+class AsyncWebServerRequest {
+public:
+    void send(int code, const char* contentType, const String& content);
+};
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() = default;
+};
+
+// One frame's bytes, shared by every client it is sent to (makeBuffer() + textAll(buffer)).
+// Owned by its socket and freed once no send holds it and it is not locked; the loopback
+// delivers synchronously, so that is as soon as the send returns.
+class AsyncWebSocketMessageBuffer {
+public:
+    explicit AsyncWebSocketMessageBuffer(size_t size) : data_(size + 1, 0) {}
+    AsyncWebSocketMessageBuffer(const uint8_t* data, size_t size) : data_(data, data + size) { data_.push_back(0); }
+
+    uint8_t* get() { return data_.data(); }
+    size_t length() const { return data_.size() - 1; }
+    void lock() { locked_ = true; }
+    void unlock() { locked_ = false; }
+    uint32_t count() const { return count_; }
+    bool canDelete() const { return count_ == 0 && !locked_; }
+    void operator++(int) { count_++; }
+    void operator--(int) { if (count_ > 0) count_--; }
+
+private:
+    std::vector<uint8_t> data_;  // Zero-terminated, like the library's
+    bool locked_ = false;
+    uint32_t count_ = 0;
+};
+
+class AsyncWebSocketClient {
+public:
+    // Receives every frame the server sends this client (binary = false for text)
+    using FrameSink = std::function<void(uint32_t clientId, bool binary, const uint8_t* data, size_t len)>;
+
+    AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id, FrameSink sink)
+        : server_(server), id_(id), sink_(std::move(sink)) {}
+
+    uint32_t id() const { return id_; }
+    AsyncWebSocket* server() const { return server_; }
+    bool canSend() const { return true; }
+
+    void text(const char* message, size_t len);
+    void text(const char* message) { text(message, std::strlen(message)); }
+    void text(const String& message) { text(message.c_str(), message.length()); }
+    void text(AsyncWebSocketMessageBuffer* buffer);
+    void binary(const uint8_t* data, size_t len);
+    void close(uint16_t code = 0, const char* message = nullptr);
+
+private:
+    AsyncWebSocket* server_;
+    uint32_t id_;
+    FrameSink sink_;
+};
+
+using AwsEventHandler = std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                                           void* arg, uint8_t* data, size_t len)>;
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+    explicit AsyncWebSocket(const String& url) : url_(url) {}
+    ~AsyncWebSocket();
+
+    const String& url() const { return url_; }
+
+    void onEvent(AwsEventHandler handler);
+
+    size_t count() const;
+    AsyncWebSocketClient* client(uint32_t id);
+    bool availableForWriteAll() { return true; }
+    void cleanupClients(uint16_t /*maxClients*/ = 8) {}
+
+    void textAll(const char* message, size_t len);
+    void textAll(const char* message) { textAll(message, std::strlen(message)); }
+    void textAll(const String& message) { textAll(message.c_str(), message.length()); }
+    void textAll(AsyncWebSocketMessageBuffer* buffer);
+    void binaryAll(const uint8_t* data, size_t len);
+    void closeAll(uint16_t code = 0, const char* message = nullptr);
+
+    // A zeroed buffer of size bytes (+ terminator) to serialize a frame into, or a copy of data
+    AsyncWebSocketMessageBuffer* makeBuffer(size_t size = 0);
+    AsyncWebSocketMessageBuffer* makeBuffer(const uint8_t* data, size_t size);
+
+    // Loopback side: attach a client (raises WS_EVT_CONNECT) and returns its id
+    uint32_t connectClient(AsyncWebSocketClient::FrameSink sink);
+    void disconnectClient(uint32_t id);
+    // Delivers message from client id as one complete text frame (WS_EVT_DATA)
+    bool receiveText(uint32_t id, const String& message);
+    // Buffers from makeBuffer() not yet freed (only textAll()/binaryAll() free them)
+    size_t bufferCount() const;
+
+    // The socket registered at url by a running AsyncWebServer::addHandler(), or nullptr.
+    // How tests and benchmarks reach a socket that is a private member of its owner.
+    static AsyncWebSocket* find(const String& url);
+
+private:
+    friend class AsyncWebSocketClient;
+
+    void raise(AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len);
+    void cleanBuffers();
+
+    String url_;
+    AwsEventHandler handler_;
+    mutable std::recursive_mutex mutex_;
+    std::map<uint32_t, std::unique_ptr<AsyncWebSocketClient>> clients_;
+    std::list<std::unique_ptr<AsyncWebSocketMessageBuffer>> buffers_;
+    uint32_t nextId_ = 1;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) : port_(port) {}
+
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+    void on(const char* /*uri*/, WebRequestMethod /*method*/, std::function<void(AsyncWebServerRequest*)> /*onRequest*/) {}
+    void begin() { running_ = true; }
+    void end() { running_ = false; }
+    bool isRunning() const { return running_; }
+
+private:
+    uint16_t port_;
+    bool running_ = false;
+};
@@ -0,0 +1,38 @@
+#include "FastLED.h"
+
+#include <algorithm>
+
+CFastLED FastLED;
+
+CRGB::CRGB(const CHSV& hsv) {
+    // Six-sector HSV -> RGB; close enough to FastLED's rainbow for a simulated strip
+    const uint8_t region = hsv.h / 43;
+    const uint8_t remainder = static_cast<uint8_t>((hsv.h - region * 43) * 6);
+    const uint8_t p = static_cast<uint8_t>((hsv.v * (255 - hsv.s)) >> 8);
+    const uint8_t q = static_cast<uint8_t>((hsv.v * (255 - ((hsv.s * remainder) >> 8))) >> 8);
+    const uint8_t t = static_cast<uint8_t>((hsv.v * (255 - ((hsv.s * (255 - remainder)) >> 8))) >> 8);
+    switch (region) {
+        case 0: r = hsv.v; g = t; b = p; break;
+        case 1: r = q; g = hsv.v; b = p; break;
+        case 2: r = p; g = hsv.v; b = t; break;
+        case 3: r = p; g = q; b = hsv.v; break;
+        case 4: r = t; g = p; b = hsv.v; break;
+        default: r = hsv.v; g = p; b = q; break;
+    }
+}
+
+void CFastLED::clear(bool writeData) {
+    if (leds_) {
+        std::fill(leds_, leds_ + count_, CRGB());
+    }
+    if (writeData) {
+        show();
+    }
+}
+
+void CFastLED::show() {
+    if (leds_) {
+        std::copy(leds_, leds_ + std::min(count_, MAX_LEDS), shown_);
+    }
+    shows_++;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+// Native (Linux) stand-in for FastLED: the strip is a frame buffer that show() publishes
+
+#include <cstdint>
+
+struct CHSV {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+    CHSV(uint8_t hue, uint8_t sat, uint8_t val) : h(hue), s(sat), v(val) {}
+};
+
+struct CRGB {
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Cyan = 0x00FFFF,
+        Green = 0x008000,
+        Orange = 0xFFA500,
+        Purple = 0x800080,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00,
+    };
+
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+
+    CRGB() = default;
+    CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(HTMLColorCode code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {}
+    CRGB(const CHSV& hsv);
+
+    bool operator==(const CRGB& other) const { return r == other.r && g == other.g && b == other.b; }
+    bool operator!=(const CRGB& other) const { return !(*this == other); }
+};
+
+// Chipset and colour-order tags for addLeds<>()
+enum ESPIChipsets { WS2812B };
+enum EOrder { RGB, GRB };
+
+class CFastLED {
+public:
+    template <ESPIChipsets CHIPSET, uint8_t DATA_PIN, EOrder ORDER>
+    CFastLED& addLeds(CRGB* leds, int count) {
+        leds_ = leds;
+        count_ = count;
+        return *this;
+    }
+
+    void setBrightness(uint8_t brightness) { brightness_ = brightness; }
+    uint8_t getBrightness() const { return brightness_; }
+
+    void clear(bool writeData = false);
+    void show();
+
+    // Simulation side: the strip as of the last show()
+    const CRGB* shown() const { return shown_; }
+    int size() const { return count_; }
+    uint32_t showCount() const { return shows_; }
+
+    static constexpr int MAX_LEDS = 64;
+
+private:
+    CRGB* leds_ = nullptr;
+    int count_ = 0;
+    uint8_t brightness_ = 255;
+    CRGB shown_[MAX_LEDS];
+    uint32_t shows_ = 0;
+};
+
+extern CFastLED FastLED;
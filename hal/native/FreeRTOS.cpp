@@ -0,0 +1,75 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+struct NativeTask {
+    std::string name;
+    UBaseType_t priority;
+    BaseType_t coreId;
+};
+
+namespace {
+const auto startTime = std::chrono::steady_clock::now();
+}  // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t, void* parameters,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId) {
+    // Tasks never return on the target, so the thread and its handle live for the whole run
+    NativeTask* task = new NativeTask{name ? name : "", priority, coreId};
+    std::thread(fn, parameters).detach();
+    if (createdTask) {
+        *createdTask = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* parameters,
+                       UBaseType_t priority, TaskHandle_t* createdTask) {
+    return xTaskCreatePinnedToCore(fn, name, stackDepth, parameters, priority, createdTask, -1);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* storage) {
+    storage->given = false;  // Created empty, as on FreeRTOS
+    return storage;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    const auto given = [semaphore]() { return semaphore->given; };
+    if (ticks == portMAX_DELAY) {
+        semaphore->cv.wait(lock, given);
+    } else if (!semaphore->cv.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), given)) {
+        return pdFALSE;
+    }
+    semaphore->given = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    {
+        std::lock_guard<std::mutex> lock(semaphore->mutex);
+        if (semaphore->given) {
+            return pdFALSE;
+        }
+        semaphore->given = true;
+    }
+    semaphore->cv.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t) {
+    // Static storage - nothing to free
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// Simulated board behind the native Arduino shim - lets tests, benchmarks and the
+// native firmware drive inputs and observe outputs without hardware.
+
+#include <cstdint>
+#include <string>
+
+namespace NativeHal {
+
+static constexpr uint8_t PIN_COUNT = 40;  // ESP32 GPIO 0..39
+
+// Level digitalRead() returns for an input pin. Inputs with INPUT_PULLUP read HIGH
+// until set; everything else reads LOW.
+void setDigitalInput(uint8_t pin, int level);
+
+// Echo width pulseIn() reports for pin (0 = timeout, as with no echo)
+void setPulseWidth(uint8_t pin, unsigned long widthUs);
+
+// Last value written with digitalWrite() / analogWrite()
+int digitalOutput(uint8_t pin);
+int analogOutput(uint8_t pin);
+
+// Number of digitalWrite()/analogWrite() calls since the last reset()
+uint32_t outputWrites();
+
+// Called after every digitalWrite()/analogWrite() on the writing thread, so a harness
+// can timestamp when a command reaches the hardware. nullptr removes it; reset() too.
+using OutputObserver = void (*)(void* context, uint8_t pin, int value);
+void setOutputObserver(OutputObserver observer, void* context);
+
+// Lines returned by Serial, ahead of anything on stdin
+void pushSerialInput(const std::string& text);
+
+// Back to power-on state: every pin unconfigured, no queued serial input
+void reset();
+
+}  // namespace NativeHal
@@ -0,0 +1,25 @@
+#include "WiFi.h"
+
+#include <cstdio>
+
+WiFiClass WiFi;
+
+String IPAddress::toString() const {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%u.%u.%u.%u", octets_[0], octets_[1], octets_[2], octets_[3]);
+    return String(text);
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char*) {
+    status_ = (ssid && *ssid) ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+    return status_;
+}
+
+bool WiFiClass::disconnect(bool) {
+    status_ = WL_DISCONNECTED;
+    return true;
+}
+
+IPAddress WiFiClass::localIP() const {
+    return status_ == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
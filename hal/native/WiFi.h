@@ -0,0 +1,42 @@
+#pragma once
+
+// Native (Linux) stand-in for the ESP32 WiFi station: begin() connects at once to the
+// host's loopback interface
+
+#include <Arduino.h>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class IPAddress {
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets_{a, b, c, d} {}
+    String toString() const;
+
+private:
+    uint8_t octets_[4] = {0, 0, 0, 0};
+};
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t mode) { mode_ = mode; return true; }
+    wl_status_t begin(const char* ssid, const char* password);
+    bool disconnect(bool wifiOff = false);
+    wl_status_t status() const { return status_; }
+    IPAddress localIP() const;
+
+private:
+    wifi_mode_t mode_ = WIFI_OFF;
+    wl_status_t status_ = WL_DISCONNECTED;
+};
+
+extern WiFiClass WiFi;
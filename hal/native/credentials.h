@@ -0,0 +1,8 @@
+#pragma once
+
+// Native build fallback, used only when include/credentials.h does not exist.
+// The native WiFi "connects" at once, so the WebSocket server starts on the loopback
+// transport in ESPAsyncWebServer.h.
+
+#define WIFI_SSID "native-loopback"
+#define WIFI_PASSWORD "native-loopback"
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include "freertos/FreeRTOS.h"
+
+// Binary semaphore only - the one kind the firmware creates
+struct StaticSemaphore_t {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool given = false;
+};
+typedef StaticSemaphore_t* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* storage);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
@@ -0,0 +1,36 @@
+// Arduino core entry point for the native build: setup() once, then loop() until killed
+//
+//   bridge_native                  # run until Ctrl-C; console commands on stdin
+//   bridge_native --seconds 30     # stop after 30 s (perf record / valgrind runs)
+
+#include <Arduino.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    unsigned long seconds = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--seconds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    while (seconds == 0 || std::chrono::steady_clock::now() < end) {
+        loop();
+    }
+
+    // The FreeRTOS tasks are detached threads that never return; skip static destructors
+    // rather than tear the buses down underneath them
+    Serial.flush();
+    std::_Exit(0);
+}
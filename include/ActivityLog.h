@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * ActivityLog - fixed ring of fixed-width activity log entries
+ *
+ * An entry is its sequence number, the state version it was pushed at, a timestamp and
+ * a code with three byte-sized arguments; the text is only built when a reader formats
+ * the line. The ring is allocated once, at construction, and a push into a full ring
+ * overwrites the oldest entry - pushing never allocates or moves anything.
+ *
+ * push() from one task (StateWriter's dispatch task); reads from any task. The lock is
+ * held only to copy fixed-size entries in or out.
+ */
+class ActivityLog {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+    static constexpr uint8_t NO_ARG = 0xFF;
+
+    struct Entry {
+        uint32_t seq;          // Line number, from 0
+        uint32_t version;      // State version the line was pushed at
+        uint32_t timestampMs;  // Clock::millis() at the push
+        uint8_t code;          // Meaning is the pusher's; args likewise
+        uint8_t args[3];
+    };
+
+    explicit ActivityLog(size_t capacity = DEFAULT_CAPACITY);
+
+    ActivityLog(const ActivityLog&) = delete;
+    ActivityLog& operator=(const ActivityLog&) = delete;
+
+    // Writer only. Returns the entry's seq
+    uint32_t push(uint32_t version, uint32_t timestampMs, uint8_t code,
+                  uint8_t arg0 = NO_ARG, uint8_t arg1 = NO_ARG, uint8_t arg2 = NO_ARG);
+
+    size_t capacity() const { return capacity_; }
+    uint32_t nextSeq() const;         // Seq the next push gets
+    uint32_t firstSeq() const;        // Oldest seq still held (nextSeq() when empty)
+    uint32_t droppedVersion() const;  // Newest version an overwritten entry had (0 = none yet)
+
+    // Seq of the oldest entry pushed after state version `version` (nextSeq() if none)
+    uint32_t firstSeqAfterVersion(uint32_t version) const;
+
+    // Copies up to max entries with seq >= fromSeq, oldest first; returns how many.
+    // Entries already overwritten are skipped, so the first one copied may be past fromSeq.
+    size_t read(uint32_t fromSeq, Entry* out, size_t max) const;
+
+private:
+    const size_t capacity_;
+    std::unique_ptr<Entry[]> entries_;
+
+    mutable std::mutex mu_;
+    uint32_t nextSeq_ = 0;
+    uint32_t droppedVersion_ = 0;
+
+    // Caller holds mu_
+    uint32_t firstSeqLocked() const;
+    const Entry& at(uint32_t seq) const { return entries_[seq % capacity_]; }
+};
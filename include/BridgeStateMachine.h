@@ -11,7 +11,6 @@ public:
     BridgeStateMachine(EventBus& eventBus, CommandBus& commandBus);
     void begin();
     void handleEvent(const BridgeEvent& event);
-    void checkTimeouts();  // Check for emergency timeouts
     BridgeState getCurrentState() const;
     String getStateString() const;
     
@@ -26,6 +25,7 @@ private:
     
     // Emergency timeout tracking
     unsigned long openingStateEntryTime_ = 0;      // When bridge entered OPENING state
+    TimerId passageTimer_ = INVALID_TIMER_ID;      // BOAT_PASSAGE_TIMEOUT_MS after openingStateEntryTime_
 
     static const char* sideName(BoatSide s) {
         switch (s) { case BoatSide::LEFT: return "left"; case BoatSide::RIGHT: return "right"; default: return "unknown"; }
@@ -45,6 +45,11 @@ private:
     bool maybeStartPendingCycle();
     void startCooldown();
     void resetCooldown();
+    void onCooldownElapsed();
+    // Arms/disarms the boat passage deadline alongside openingStateEntryTime_
+    void startPassageTimer();
+    void stopPassageTimer();
+    void onPassageTimeout();
     void beginCycleForSide(BoatSide side);
     void startActiveBoatWindow(BoatSide side);
     void endActiveBoatWindow(const char* reason);
@@ -59,6 +64,7 @@ private:
     bool greenWindowActive_ = false;
     bool cooldownActive_ = false;
     unsigned long cooldownStartTime_ = 0;
+    TimerId cooldownTimer_ = INVALID_TIMER_ID;
     uint8_t sidesServedThisOpening_ = 0;
     bool boatPassedInWindow_ = false;
     static constexpr uint8_t MAX_SIDES_PER_OPEN = 2;
@@ -73,6 +73,10 @@ enum class BridgeEvent {
     STATE_CHANGED
 };
 
+// Number of BridgeEvent values, used to size tables indexed directly by event
+// STATE_CHANGED must remain the last enumerator
+constexpr size_t BRIDGE_EVENT_COUNT = static_cast<size_t>(BridgeEvent::STATE_CHANGED) + 1;
+
 // Convert BridgeEvent to readable string
 inline const char* bridgeEventToString(BridgeEvent event) {
     switch (event) {
@@ -120,6 +124,10 @@ enum class CommandTarget {
     SAFETY_MANAGER
 };
 
+// Number of CommandTarget values, used to size tables indexed directly by target
+// SAFETY_MANAGER must remain the last enumerator
+constexpr size_t COMMAND_TARGET_COUNT = static_cast<size_t>(CommandTarget::SAFETY_MANAGER) + 1;
+
 enum class CommandAction {
     // Controller Actions
     ENTER_SAFE_STATE,
@@ -150,3 +158,8 @@ struct Command {
     CommandAction action;
     String data;
 };
+
+// Token returned by EventBus/CommandBus subscribe(), used to remove that one subscription
+// 0 is never issued, so it can mean "not subscribed"
+typedef uint32_t SubscriptionId;
+static const SubscriptionId INVALID_SUBSCRIPTION_ID = 0;
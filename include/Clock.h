@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Clock - where the firmware modules get the time
+ *
+ * Modules call Clock::millis() / Clock::micros() rather than the Arduino functions,
+ * so the time source can be swapped without touching them:
+ *   - SystemClock (the default) is the real clock: Arduino millis()/micros() on the
+ *     target; on the host (UNIT_TEST) milliseconds come from the test's mock_millis
+ *     and microseconds from the steady clock
+ *   - VirtualClock (VirtualClock.h) only moves when told to, and can jump straight to
+ *     the next EventBus deadline, so a full bridge cycle runs in microseconds
+ *
+ * Both wrap like the Arduino counters (uint32_t ms ~49.7 days, us ~71.6 minutes), so
+ * compare times by subtraction.
+ *
+ * install() is meant for setup() or a test fixture, before the tasks start.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    virtual uint32_t nowMs() = 0;
+    virtual uint32_t nowUs() = 0;
+
+    // The installed clock's time
+    static uint32_t millis() { return active_->nowMs(); }
+    static uint32_t micros() { return active_->nowUs(); }
+
+    // Makes clock the time source for every module (nullptr = back to the SystemClock);
+    // returns the previously installed clock
+    static Clock* install(Clock* clock);
+    static Clock& current() { return *active_; }
+
+protected:
+    constexpr Clock() = default;
+
+private:
+    static Clock* active_;
+};
+
+class SystemClock : public Clock {
+public:
+    constexpr SystemClock() = default;
+
+    uint32_t nowMs() override;
+    uint32_t nowUs() override;
+};
@@ -8,11 +8,12 @@
 #endif
 
 // Standard library includes (from C++ Standard Library namespace "std")
-#include <map>             // For std::map (key-value storage, like HashMap in Java)
+#include <array>           // For std::array (fixed-size table indexed by CommandTarget)
+#include <atomic>          // For std::atomic (sealed flag read without the mutex)
 #include <vector>          // For std::vector (dynamic array, like ArrayList in Java)
-#include <functional>      // For std::function (storing callbacks/function pointers)
 #include <mutex>           // For std::mutex (thread synchronization)
 #include "BridgeSystemDefs.h"  // Project-specific definitions (Command struct, etc.)
+#include "Delegate.h"          // Fixed-size callback type (no heap allocation)
 
 /**
  * CommandBus - Central command distribution system for outgoing instructions
@@ -25,7 +26,12 @@
  * - Subsystems (Motor, Signal) subscribe to receive specific commands
  * 
  * Thread-safe implementation with mutex protection for multi-threaded environments
+ *
+ * Subscribers register during setup(); seal() then freezes the table so publish()
+ * can dispatch without locking, copying or searching.
  */
+using CommandCallback = Delegate<void(const Command&)>;
+
 class CommandBus {
 public:
     // Constructor & Destructor
@@ -40,12 +46,18 @@ public:
     void publish(const Command& command);
     
     // Registers a callback function to be called when commands for specified target are published
-    // std::function is a wrapper that can store any callable object (function pointer, lambda, etc.)
-    // Thread-safe: protected by mutex
-    void subscribe(CommandTarget target, std::function<void(const Command&)> callback);
+    // CommandCallback is a Delegate: it stores a lambda/function inline, and a capture that is
+    // too large to fit is a compile error instead of a heap allocation
+    // Returns a token for unsubscribe(), or INVALID_SUBSCRIPTION_ID if rejected
+    // Thread-safe: protected by mutex. Rejected once the bus is sealed
+    SubscriptionId subscribe(CommandTarget target, CommandCallback callback);
+
+    // Removes the one subscription identified by the token subscribe() returned
+    // Thread-safe: protected by mutex. Returns false if unknown or the bus is sealed
+    bool unsubscribe(SubscriptionId id);
     
     // Removes all callbacks for the specified target
-    // Thread-safe: protected by mutex
+    // Thread-safe: protected by mutex. Rejected once the bus is sealed
     void unsubscribe(CommandTarget target);
     
     // Utility methods
@@ -55,15 +67,30 @@ public:
     // Thread-safe: protected by mutex
     bool hasSubscribers(CommandTarget target) const;
     
-    // Removes all subscriptions
+    // Removes all subscriptions (and unseals the table)
     // Thread-safe: protected by mutex
     void clear();
 
+    // Freezes the subscriber table - call once at the end of setup()
+    void seal();
+    bool isSealed() const { return sealed.load(std::memory_order_acquire); }
+
 private:
-    // Maps command targets to their list of callback functions
-    // Example: MOTOR -> [openBridgeFunction, logCommandFunction]
-    // Each vector can grow dynamically as new callbacks are added
-    std::map<CommandTarget, std::vector<std::function<void(const Command&)>>> subscribers;
+    struct Subscription {
+        CommandCallback callback;
+        SubscriptionId id;
+    };
+
+    // Callback lists indexed directly by CommandTarget value
+    // Example: subscribers[MOTOR_CONTROL] -> [openBridgeFunction, logCommandFunction]
+    // Vectors only grow before seal()
+    std::array<std::vector<Subscription>, COMMAND_TARGET_COUNT> subscribers;
+
+    // Next token for subscribe(); 0 is INVALID_SUBSCRIPTION_ID
+    SubscriptionId nextSubscriptionId = 1;
+
+    // Set by seal(); the table is read-only while this is true
+    std::atomic<bool> sealed{false};
     
     // Mutex for thread synchronization
     // Protects access to the subscribers map during concurrent operations
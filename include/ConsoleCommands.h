@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
+#include "TraceRecorder.h"
 
 class MotorControl;
 class DetectionSystem;
@@ -20,6 +22,9 @@ public:
   bool isStreamingLeft() const { return (streamMask_ & STREAM_LEFT) != 0; }
   bool isStreamingRight() const { return (streamMask_ & STREAM_RIGHT) != 0; }
 
+  // A 'trace dump' goes out a line per poll(); the control loop polls faster meanwhile
+  bool isDumpingTrace() const { return traceDumping_.load(std::memory_order_acquire); }
+
 private:
   MotorControl& motor_;
   DetectionSystem& detect_;
@@ -29,6 +34,14 @@ private:
   bool handleCommand(const String& cmd);
   void printHelp();
   void printStatus();
+  void printMetrics();
+  bool handleTraceCommand(const String& cmd);
+
+  // Trace dump in progress: one base64 line per pass, only when Serial can take it
+  // without blocking, so the control task never waits on the UART
+  TraceRecorder::DumpCursor traceDump_{};
+  std::atomic<bool> traceDumping_{false};
+  void pumpTraceDump();
 
   // Streaming of ultrasonic readings (no timestamps)
   static constexpr uint8_t STREAM_LEFT  = 0x01;
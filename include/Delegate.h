@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Inline storage for a Delegate: room for a lambda capturing `this` plus a few
+// pointers/values, or a member-function pointer together with its object
+#define DELEGATE_STORAGE_SIZE (4 * sizeof(void*))
+
+/**
+ * Delegate - fixed-size, non-allocating callback used by EventBus and CommandBus
+ *
+ * Drop-in for std::function in the bus subscriber tables. The callable is stored
+ * inline in a small buffer; one that does not fit (or is over-aligned) is a
+ * compile error rather than a silent heap allocation. Calling it is one indirect
+ * call through a per-type stub.
+ *
+ * Trivially copyable callables (every subscriber in the firmware captures only
+ * `this` and plain values) are copied with memcpy and need no destructor.
+ *
+ *   Delegate<void(const Command&)> d = [this](const Command& c) { handleCommand(c); };
+ *   auto d2 = Delegate<void(const Command&)>::bind<&Controller::handleCommand>(this);
+ */
+template <typename Signature, size_t Capacity = DELEGATE_STORAGE_SIZE>
+class Delegate;
+
+template <typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+    // True if F can be stored without allocating; used by the constructor's static_assert
+    template <typename F>
+    static constexpr bool fits() {
+        using Fn = std::decay_t<F>;
+        return sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value && std::is_copy_constructible<Fn>::value;
+    }
+
+    Delegate() noexcept = default;
+    Delegate(std::nullptr_t) noexcept {}
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Delegate>::value &&
+                                          std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+    Delegate(F&& callable) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity, "callable too large for Delegate inline storage - capture less");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable over-aligned for Delegate storage");
+        static_assert(std::is_nothrow_move_constructible<Fn>::value, "Delegate callables must be nothrow-movable");
+        static_assert(std::is_copy_constructible<Fn>::value, "Delegate callables must be copyable");
+
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(callable));
+        invoke_ = &invokeStub<Fn>;
+        manage_ = std::is_trivially_copyable<Fn>::value ? nullptr : &manageStub<Fn>;
+    }
+
+    // Binds a member function to an object without going through a lambda
+    template <auto Method, typename C>
+    static Delegate bind(C* object) {
+        return Delegate([object](Args... args) -> R {
+            return (object->*Method)(std::forward<Args>(args)...);
+        });
+    }
+
+    Delegate(const Delegate& other) { copyFrom(other); }
+    Delegate(Delegate&& other) noexcept { moveFrom(other); }
+
+    Delegate& operator=(const Delegate& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Delegate& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~Delegate() { reset(); }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+    // Calling an empty Delegate is a programming error; callers check operator bool first
+    R operator()(Args... args) const {
+        return invoke_(const_cast<unsigned char*>(storage_), std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        if (manage_) {
+            manage_(Op::DESTROY, storage_, nullptr);
+        }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+private:
+    enum class Op { COPY, MOVE, DESTROY };
+
+    using InvokeFn = R (*)(void*, Args...);
+    using ManageFn = void (*)(Op, void* self, void* other);
+
+    template <typename Fn>
+    static R invokeStub(void* storage, Args... args) {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    }
+
+    // Only instantiated for callables that are not trivially copyable
+    template <typename Fn>
+    static void manageStub(Op op, void* self, void* other) {
+        switch (op) {
+            case Op::COPY:
+                ::new (self) Fn(*static_cast<const Fn*>(other));
+                break;
+            case Op::MOVE:
+                ::new (self) Fn(std::move(*static_cast<Fn*>(other)));
+                static_cast<Fn*>(other)->~Fn();
+                break;
+            case Op::DESTROY:
+                static_cast<Fn*>(self)->~Fn();
+                break;
+        }
+    }
+
+    void copyFrom(const Delegate& other) {
+        if (other.manage_) {
+            other.manage_(Op::COPY, storage_, const_cast<unsigned char*>(other.storage_));
+        } else {
+            std::memcpy(storage_, other.storage_, Capacity);
+        }
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+    }
+
+    void moveFrom(Delegate& other) noexcept {
+        if (other.manage_) {
+            other.manage_(Op::MOVE, storage_, other.storage_);
+        } else {
+            std::memcpy(storage_, other.storage_, Capacity);
+        }
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    InvokeFn invoke_ = nullptr;
+    ManageFn manage_ = nullptr;
+};
@@ -6,10 +6,20 @@
 
 class DetectionSystem {
 public:
+    // Event threshold (critical distance) for BOAT_DETECTED/BOAT_PASSED
+    static constexpr float DETECT_THRESHOLD_CM = 10.0f;
+    static constexpr unsigned long SAMPLE_INTERVAL_MS = 100;  // 10 Hz
+    static constexpr unsigned long DETECT_HOLD_MS = 800;      // must stay within detect range to trigger
+
     DetectionSystem(EventBus& eventBus);  // Constructor accepting EventBus reference
 
     void begin();   // Initialization method
     void update();  // Method to be called periodically
+    unsigned long msUntilNextSample() const;  // How long update() has nothing to do (0 = sample due)
+
+    // The part of update() after the sensors are read: raw distances in cm, <0 = no echo.
+    // Host harnesses feed synthetic distance profiles through here.
+    void processSample(float leftRawDist, float rightRawDist);
 
     // New method to check if the system has been initialized
     bool isInitialized() const;  // Add this method to check initialization status
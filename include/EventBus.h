@@ -8,14 +8,26 @@
     #include <Arduino.h>
 #endif
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
 #include <vector>
-#include <functional>
 #include <mutex>          
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include "BridgeSystemDefs.h"
+#include "Delegate.h"
+#include "EventPool.h"
+#include "LatencyHistogram.h"
+#include "MpscQueue.h"
+#include "TimerWheel.h"
+#include "WakeSignal.h"
 
 // Forward declaration
 class EventData;
+class TraceRecorder;
 
 enum class BoatEventSide {
     UNKNOWN,
@@ -33,14 +45,70 @@ enum class EventPriority {
     EMERGENCY  // Safety-critical events that take precedence
 };
 
+static_assert(BRIDGE_EVENT_COUNT <= 64, "EventMask holds one bit per BridgeEvent");
+
+/**
+ * Set of BridgeEvents, one bit per event
+ * Lets one subscriber cover many events with a single stored callback:
+ *   bus.subscribe(EventMask{E::FAULT_DETECTED, E::FAULT_CLEARED}, cb);
+ *   bus.subscribe(EventMask::all().without(E::BEAM_BREAK_ACTIVE), cb);
+ */
+class EventMask {
+public:
+    constexpr EventMask() = default;
+    constexpr EventMask(std::initializer_list<BridgeEvent> events) {
+        for (BridgeEvent event : events) {
+            bits_ |= bit(event);
+        }
+    }
+
+    // Every BridgeEvent, including ones added to the enum later
+    static constexpr EventMask all() {
+        return EventMask(BRIDGE_EVENT_COUNT == 64 ? ~0ULL : (1ULL << BRIDGE_EVENT_COUNT) - 1);
+    }
+
+    constexpr bool contains(BridgeEvent event) const { return (bits_ & bit(event)) != 0; }
+    constexpr bool empty() const { return bits_ == 0; }
+    constexpr uint64_t bits() const { return bits_; }
+
+    constexpr EventMask with(BridgeEvent event) const { return EventMask(bits_ | bit(event)); }
+    constexpr EventMask without(BridgeEvent event) const { return EventMask(bits_ & ~bit(event)); }
+    constexpr EventMask operator|(EventMask other) const { return EventMask(bits_ | other.bits_); }
+
+private:
+    explicit constexpr EventMask(uint64_t bits) : bits_(bits) {}
+    static constexpr uint64_t bit(BridgeEvent event) { return 1ULL << static_cast<unsigned>(event); }
+
+    uint64_t bits_ = 0;
+};
+
+/**
+ * Concrete payload class tag
+ * Lets typed subscribers accept pointer-API payloads without RTTI (disabled on ESP32)
+ */
+enum class EventPayloadKind {
+    GENERIC,
+    SIMPLE,
+    STATE_CHANGE,
+    LIGHT_CHANGE,
+    BOAT,
+    SIMULATION_SENSOR_CONFIG
+};
+
 /**
  * Base class for all event data
  * Used to pass additional information with events
+ *
+ * Payloads are allocated from EventPool rather than the general heap;
+ * `new`/`delete` on any EventData subclass goes through the pool automatically.
  */
 class EventData {
 public:
     // Virtual destructor enables proper cleanup of derived classes
     virtual ~EventData();
+
+    static void* operator new(size_t size) { return EventPool::allocate(size); }
+    static void operator delete(void* ptr) { EventPool::release(ptr); }
     
     // Returns a string representation of the event type
     // 'virtual' allows derived classes to override this method
@@ -53,6 +121,9 @@ public:
 
     // Helper so callers can check if this payload carries boat side info
     virtual BoatEventSide getBoatEventSide() const { return BoatEventSide::UNKNOWN; }
+
+    // Which concrete payload class this is (see EventPayloadKind)
+    virtual EventPayloadKind getPayloadKind() const { return EventPayloadKind::GENERIC; }
 };
 
 /**
@@ -64,10 +135,13 @@ private:
     BridgeEvent eventType_;
     
 public:
+    static constexpr EventPayloadKind KIND = EventPayloadKind::SIMPLE;
+
     explicit SimpleEventData(BridgeEvent eventType) : eventType_(eventType) {}
     
     const char* getEventType() const override;
     BridgeEvent getEventEnum() const override { return eventType_; }
+    EventPayloadKind getPayloadKind() const override { return KIND; }
 };
 
 /**
@@ -80,11 +154,14 @@ private:
     BridgeState previousState_;
     
 public:
+    static constexpr EventPayloadKind KIND = EventPayloadKind::STATE_CHANGE;
+
     StateChangeData(BridgeState newState, BridgeState previousState) 
         : newState_(newState), previousState_(previousState) {}
     
     const char* getEventType() const override { return "STATE_CHANGED"; }
     BridgeEvent getEventEnum() const override { return BridgeEvent::STATE_CHANGED; }
+    EventPayloadKind getPayloadKind() const override { return KIND; }
     
     BridgeState getNewState() const { return newState_; }
     BridgeState getPreviousState() const { return previousState_; }
@@ -101,6 +178,8 @@ private:
     bool isCarLight_;  // true for car light, false for boat light
     
 public:
+    static constexpr EventPayloadKind KIND = EventPayloadKind::LIGHT_CHANGE;
+
     LightChangeData(const String& side, const String& color, bool isCarLight) 
         : side_(side), color_(color), isCarLight_(isCarLight) {}
     
@@ -111,6 +190,7 @@ public:
     BridgeEvent getEventEnum() const override { 
         return isCarLight_ ? BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS : BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS; 
     }
+    EventPayloadKind getPayloadKind() const override { return KIND; }
     
     const String& getSide() const { return side_; }
     const String& getColor() const { return color_; }
@@ -123,12 +203,15 @@ private:
     BoatEventSide side_;
 
 public:
+    static constexpr EventPayloadKind KIND = EventPayloadKind::BOAT;
+
     BoatEventData(BridgeEvent eventType, BoatEventSide side)
         : eventType_(eventType), side_(side) {}
 
     const char* getEventType() const override { return bridgeEventToString(eventType_); }
     BridgeEvent getEventEnum() const override { return eventType_; }
     BoatEventSide getBoatEventSide() const override { return side_; }
+    EventPayloadKind getPayloadKind() const override { return KIND; }
 };
 
 class SimulationSensorConfigData : public EventData {
@@ -138,6 +221,8 @@ private:
     bool beamBreakEnabled_;
 
 public:
+    static constexpr EventPayloadKind KIND = EventPayloadKind::SIMULATION_SENSOR_CONFIG;
+
     SimulationSensorConfigData(bool ultrasonicLeftEnabled,
                                bool ultrasonicRightEnabled,
                                bool beamBreakEnabled)
@@ -147,19 +232,135 @@ public:
 
     const char* getEventType() const override { return "SIMULATION_SENSOR_CONFIG_CHANGED"; }
     BridgeEvent getEventEnum() const override { return BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED; }
+    EventPayloadKind getPayloadKind() const override { return KIND; }
 
     bool isUltrasonicLeftEnabled() const { return ultrasonicLeftEnabled_; }
     bool isUltrasonicRightEnabled() const { return ultrasonicRightEnabled_; }
     bool isBeamBreakEnabled() const { return beamBreakEnabled_; }
 };
 
+/**
+ * Owning handle for a payload published through the pointer API (publish(type, new X(...)))
+ * Move-only; the payload is deleted when the queued event holding it is destroyed
+ */
+class OwnedEventData {
+public:
+    explicit OwnedEventData(EventData* data) : data_(data) {}
+    OwnedEventData(OwnedEventData&& other) noexcept : data_(other.data_) { other.data_ = nullptr; }
+    OwnedEventData& operator=(OwnedEventData&& other) noexcept {
+        if (this != &other) {
+            delete data_;
+            data_ = other.data_;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+    OwnedEventData(const OwnedEventData&) = delete;
+    OwnedEventData& operator=(const OwnedEventData&) = delete;
+    ~OwnedEventData() { delete data_; }
+
+    EventData* get() const { return data_; }
+
+private:
+    EventData* data_;
+};
+
+/**
+ * Event payload stored by value inside the queue
+ * The built-in payload types live inline (no allocation, no ownership to track);
+ * anything else published through the pointer API is carried as OwnedEventData.
+ */
+using EventPayload = std::variant<std::monostate,
+                                  SimpleEventData,
+                                  StateChangeData,
+                                  LightChangeData,
+                                  BoatEventData,
+                                  SimulationSensorConfigData,
+                                  OwnedEventData>;
+
+// True if T is one of the payload types EventPayload stores inline
+template <typename T, typename Variant = EventPayload>
+struct IsInlineEventPayload;
+
+template <typename T, typename... Types>
+struct IsInlineEventPayload<T, std::variant<Types...>>
+    : std::integral_constant<bool, (std::is_same<T, Types>::value || ...) &&
+                                   std::is_base_of<EventData, T>::value> {};
+
+// Typed view of a payload: T stored inline, or a pointer-API payload whose kind is T's
+// Returns nullptr if the payload is something else
+template <typename T>
+const T* payloadAs(const EventPayload& payload) {
+    if (const T* inlineData = std::get_if<T>(&payload)) {
+        return inlineData;
+    }
+    if (const OwnedEventData* owned = std::get_if<OwnedEventData>(&payload)) {
+        const EventData* data = owned->get();
+        if (data && data->getPayloadKind() == T::KIND) {
+            return static_cast<const T*>(data);
+        }
+    }
+    return nullptr;
+}
+
+// EventData view of a payload for pointer-API subscribers (nullptr when there is none)
+EventData* payloadPointer(EventPayload& payload);
+
 /**
  * Represents a subscription to an event type
  * Contains both the callback function and its priority
+ * Exactly one of callback / payloadCallback is set
+ * Callbacks are Delegates: stored inline, never heap-allocated
  */
+using EventCallback = Delegate<void(EventData*)>;
+using EventPayloadCallback = Delegate<void(const EventPayload&)>;
+// Mask subscribers cover several events, so they are also told which one fired
+using EventMaskCallback = Delegate<void(BridgeEvent, EventData*)>;
+// Timer callback for callAfter()
+using TimerCallback = TimerWheel::Callback;
+
 struct EventSubscription {
-    std::function<void(EventData*)> callback;  // Function to call when event occurs
-    EventPriority priority;                    // Priority of this subscription
+    EventCallback callback;                 // Pointer-API subscriber
+    EventPayloadCallback payloadCallback;   // Typed subscriber, see subscribe<T>()
+    EventMaskCallback maskCallback;         // Multi-event subscriber, see subscribe(EventMask, ...)
+    EventMask mask;                         // Events a mask subscriber receives
+    EventPriority priority;                 // EMERGENCY subscribers run before NORMAL ones
+    SubscriptionId id;                      // Token handed back by subscribe()
+    const char* label = nullptr;            // Owner name for metrics, see EventBus::SubscriberLabel
+    // Cleared by unsubscribe(); dispatch skips the entry until the list is compacted
+    std::atomic<bool> active{true};
+    // Callback timing, written only by the dispatching task (see getSubscriberTimings())
+    std::atomic<uint32_t> calls{0};
+    std::atomic<uint32_t> totalUs{0};       // Wraps after ~71 min of cumulative callback time
+    std::atomic<uint32_t> maxUs{0};
+
+    EventSubscription() = default;
+    EventSubscription(EventSubscription&& other) noexcept
+        : callback(std::move(other.callback)),
+          payloadCallback(std::move(other.payloadCallback)),
+          maskCallback(std::move(other.maskCallback)),
+          mask(other.mask),
+          priority(other.priority),
+          id(other.id),
+          label(other.label),
+          active(other.active.load(std::memory_order_relaxed)),
+          calls(other.calls.load(std::memory_order_relaxed)),
+          totalUs(other.totalUs.load(std::memory_order_relaxed)),
+          maxUs(other.maxUs.load(std::memory_order_relaxed)) {}
+    EventSubscription& operator=(EventSubscription&& other) noexcept {
+        callback = std::move(other.callback);
+        payloadCallback = std::move(other.payloadCallback);
+        maskCallback = std::move(other.maskCallback);
+        mask = other.mask;
+        priority = other.priority;
+        id = other.id;
+        label = other.label;
+        active.store(other.active.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        calls.store(other.calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        totalUs.store(other.totalUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        maxUs.store(other.maxUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
 };
 
 /**
@@ -168,9 +369,76 @@ struct EventSubscription {
  */
 struct QueuedEvent {
     BridgeEvent eventType;          // Type of event (from BridgeSystemDefs.h enum)
-    EventData* eventData;           // Additional data associated with the event
+    EventPayload payload;           // Additional data associated with the event, held by value
     EventPriority priority;         // Priority level (NORMAL or EMERGENCY)
-    unsigned long timestamp;        // When the event was queued (milliseconds)
+    unsigned long timestamp;        // When the event was published (micros()), for queue-wait metrics
+};
+
+/**
+ * Fixed-capacity FIFO of queued events
+ * Storage is allocated once in the constructor and never grows, so push/pop
+ * are O(1) and the queue never reallocates once the system is running.
+ * push() fails (returns false) when the ring is full - the caller decides the drop policy.
+ * Not thread-safe on its own; EventBus guards it with eventQueue_mutex.
+ */
+class EventRingQueue {
+public:
+    explicit EventRingQueue(size_t capacity);
+
+    bool push(QueuedEvent&& event);  // false if full (event is left untouched)
+    bool pop(QueuedEvent& out);      // false if empty
+
+    // O(1) exchange of contents with a ring of any capacity (storage is swapped, not copied)
+    void swap(EventRingQueue& other) noexcept;
+
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == slots_.size(); }
+    size_t size() const { return count_; }
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    std::vector<QueuedEvent> slots_;  // Sized once, never resized
+    size_t head_ = 0;                 // Index of the oldest event
+    size_t count_ = 0;                // Number of events currently stored
+};
+
+/**
+ * Queue health counters, readable at runtime for diagnostics
+ * Dropped counts are cumulative since boot (or the last clear())
+ */
+struct EventQueueStats {
+    uint32_t emergencyDropped;   // EMERGENCY events rejected because their ring was full
+    uint32_t normalDropped;      // NORMAL events rejected because their ring was full
+    size_t emergencyHighWater;   // Deepest the EMERGENCY ring has been
+    size_t normalHighWater;      // Deepest the NORMAL ring has been
+    size_t emergencyCapacity;
+    size_t normalCapacity;
+    uint32_t remoteDropped;      // Cross-core publishes rejected because the hand-off queue was full
+    size_t remoteCapacity;
+    uint32_t budgetStops;        // processEvents() calls that hit their budget with events still pending
+};
+
+// One subscriber's callback timing (see EventBus::getSubscriberTimings())
+struct SubscriberTiming {
+    SubscriptionId id;
+    const char* label;           // nullptr if subscribed outside a SubscriberLabel scope
+    bool mask;                   // subscribe(EventMask) entry; event is then meaningless
+    BridgeEvent event;
+    EventPriority priority;
+    uint32_t calls;
+    uint32_t totalUs;
+    uint32_t maxUs;
+};
+
+// Snapshot of how the event-processing task spends its time (see waitForWork())
+struct EventLoopStats {
+    uint32_t waits;              // waitForWork() calls
+    uint32_t notifiedWakeups;    // Woken early by a publish
+    uint32_t timeoutWakeups;     // Slept until the deadline
+    float idlePercent;           // Share of time spent blocked in waitForWork()
+    uint32_t wakeLatencySamples; // processEvents() calls that found newly published events
+    uint32_t wakeLatencyAvgUs;   // Publish → start of dispatch
+    uint32_t wakeLatencyMaxUs;
 };
 
 /**
@@ -180,17 +448,64 @@ struct QueuedEvent {
  * Events represent facts about what has already happened (e.g., BOAT_DETECTED)
  * 
  * Thread-safe implementation with mutex protection
+ *
+ * Subscribers are registered during setup(), then the table is frozen with seal().
+ * Once sealed, dispatch reads the table without locking or allocating.
+ *
+ * Dispatch is swap-and-drain: processEvents() swaps the publish rings with a
+ * pair of dispatch rings under the queue lock (O(1)), then runs callbacks with
+ * the lock released. Events published from callbacks land in the fresh publish
+ * rings and are picked up by the next swap.
+ *
+ * Tasks on the other core (network / AsyncTCP) publish with publishRemote() or
+ * emplaceRemote(): a lock-free hand-off queue that the control core drains at the
+ * start of processEvents(), so a slow subscriber never blocks a network-side publish.
  */
 class EventBus {
 public:
-    EventBus();
+    // Default ring sizes; a 5 ms control tick rarely sees more than a handful of events
+    static constexpr size_t DEFAULT_EMERGENCY_QUEUE_CAPACITY = 16;
+    static constexpr size_t DEFAULT_NORMAL_QUEUE_CAPACITY = 64;
+    // Cross-core hand-off; remote publishes are UI/console commands, a few per second
+    static constexpr size_t REMOTE_QUEUE_CAPACITY = 32;
+    // processEvents() default: no event-count limit
+    static constexpr size_t NO_EVENT_LIMIT = SIZE_MAX;
+
+    // Both rings are allocated here (before setup() runs for global instances) and never reallocate
+    explicit EventBus(size_t emergencyCapacity = DEFAULT_EMERGENCY_QUEUE_CAPACITY,
+                      size_t normalCapacity = DEFAULT_NORMAL_QUEUE_CAPACITY);
     ~EventBus();
     
     // Core functionality methods - all thread-safe
     
     // Registers a function to be called when the specified event type occurs
-    // priority parameter determines if this is a normal or emergency handler
-    void subscribe(BridgeEvent eventType, std::function<void(EventData*)> callback, EventPriority priority = EventPriority::NORMAL);
+    // priority parameter determines if this is a normal or emergency handler;
+    // for each event, EMERGENCY handlers are called before NORMAL ones
+    // Returns a token for unsubscribe(), or INVALID_SUBSCRIPTION_ID if rejected
+    // Rejected (with an error log) once the bus has been sealed
+    // The callback must fit in a Delegate (checked at compile time)
+    SubscriptionId subscribe(BridgeEvent eventType, EventCallback callback, EventPriority priority = EventPriority::NORMAL);
+
+    // Typed subscription - the callback gets the payload as const T&, with no cast
+    //   bus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED,
+    //                                  [](const StateChangeData& d) { ... });
+    // Events of that type whose payload is not a T are skipped
+    template <typename T, typename Callback>
+    SubscriptionId subscribe(BridgeEvent eventType, Callback callback, EventPriority priority = EventPriority::NORMAL) {
+        static_assert(IsInlineEventPayload<T>::value, "subscribe<T> needs one of the EventPayload types");
+        return subscribePayload(eventType, [callback](const EventPayload& payload) {
+            if (const T* data = payloadAs<T>(payload)) {
+                callback(*data);
+            }
+        }, priority);
+    }
+
+    // One subscription for every event in the mask, stored once (not once per event)
+    // The callback is told which event fired; eventData may be nullptr for payload-free events
+    // For each event, subscribers run EMERGENCY first; within a priority, per-event
+    // subscribers run before mask subscribers, and mask subscribers in registration order
+    SubscriptionId subscribe(EventMask events, EventMaskCallback callback,
+                             EventPriority priority = EventPriority::NORMAL);
     
 
     
@@ -199,6 +514,14 @@ public:
     // Adds an event to the processing queue
     // eventData can contain additional information about the event
     // priority determines if this event is processed before normal events
+    //
+    // Drop policy: each priority has its own fixed ring. If the ring for the
+    // event's priority is full, the NEW event is dropped (its eventData is
+    // deleted, since the bus owns it once published), the matching overflow
+    // counter is incremented and a warning is logged once per overflow burst.
+    // Events already queued are never evicted, so a sequence of success events
+    // the state machine is waiting on cannot be lost to a later flood, and a
+    // NORMAL flood can never push out EMERGENCY events.
     
     // void publish(BridgeEvent eventType, EventData* eventData = nullptr,           // This is real
     //              EventPriority priority = EventPriority::NORMAL);
@@ -209,36 +532,291 @@ public:
                     EventPriority priority = EventPriority::NORMAL);
 
     //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+    // Queues an already-built payload by value; emplace() and publish() both end up here
+    virtual void publishPayload(BridgeEvent eventType, EventPayload&& payload,
+                                EventPriority priority = EventPriority::NORMAL);
+
+    // Builds a T payload and publishes it under T's own event type
+    //   bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
+    //   bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+    // Built-in payload types are constructed inline in the queue slot's variant;
+    // other EventData subclasses fall back to the event pool.
+    template <typename T, EventPriority Priority = EventPriority::NORMAL, typename... Args>
+    void emplace(Args&&... args) {
+        static_assert(std::is_base_of<EventData, T>::value, "emplace<T> needs an EventData payload type");
+        if constexpr (IsInlineEventPayload<T>::value) {
+            EventPayload payload(std::in_place_type<T>, std::forward<Args>(args)...);
+            const BridgeEvent eventType = std::get<T>(payload).getEventEnum();
+            publishPayload(eventType, std::move(payload), Priority);
+        } else {
+            T* eventData = new T(std::forward<Args>(args)...);
+            publish(eventData->getEventEnum(), eventData, Priority);
+        }
+    }
+
+    // Lock-free publish for tasks that are not the event-processing task (e.g. the network core)
+    // Never takes eventQueue_mutex: the event goes into an MPSC hand-off queue and is moved
+    // into the priority rings by the next processEvents() call on the control core.
+    // Returns false, releasing the payload and counting the drop, if the hand-off queue is full.
+    bool publishRemote(BridgeEvent eventType, EventPayload&& payload,
+                       EventPriority priority = EventPriority::NORMAL);
+
+    // emplace() counterpart of publishRemote()
+    template <typename T, EventPriority Priority = EventPriority::NORMAL, typename... Args>
+    bool emplaceRemote(Args&&... args) {
+        static_assert(std::is_base_of<EventData, T>::value, "emplaceRemote<T> needs an EventData payload type");
+        if constexpr (IsInlineEventPayload<T>::value) {
+            EventPayload payload(std::in_place_type<T>, std::forward<Args>(args)...);
+            const BridgeEvent eventType = std::get<T>(payload).getEventEnum();
+            return publishRemote(eventType, std::move(payload), Priority);
+        } else {
+            T* eventData = new T(std::forward<Args>(args)...);
+            const BridgeEvent eventType = eventData->getEventEnum();
+            return publishRemote(eventType, EventPayload(std::in_place_type<OwnedEventData>, eventData), Priority);
+        }
+    }
     
     
-    // Removes a previously registered callback for an event
-    void unsubscribe(BridgeEvent eventType, std::function<void(EventData*)> callback);
-    
+    // Removes the subscription identified by the token subscribe() returned, in O(1)
+    // Safe from inside a callback during processEvents() and after seal(): the entry is
+    // only marked inactive and dispatch skips it. The list is compacted later, outside
+    // dispatch (after processEvents() or at seal()); a sealed table is never compacted.
+    // Returns false if the token is unknown, stale or already removed
+    bool unsubscribe(SubscriptionId id);
+
+    // Deferred work on the bus's timer wheel (see TimerWheel.h)
+    // Timers fire at the start of processEvents(), on the event-processing task, so a
+    // deadline is never polled by the subsystem that armed it. Resolution is the
+    // processEvents() period (5 ms on the control core).
+
+    // Publishes eventType (with a SimpleEventData payload) delayMs from now
+    TimerId publishAfter(uint32_t delayMs, BridgeEvent eventType,
+                         EventPriority priority = EventPriority::NORMAL);
+
+    // Runs callback delayMs from now; re-arm from inside the callback for periodic work
+    TimerId callAfter(uint32_t delayMs, TimerCallback callback);
+
+    // Stops a pending timer; false if it already fired or the id is stale
+    bool cancelTimer(TimerId id);
+
+    // Milliseconds until the next timer is due (0 if overdue), or TimerWheel::NO_TIMER
+    // Lets the control loop decide how long it may sleep
+    uint32_t msUntilNextTimer() const;
+
     // Event processing - thread-safe
     
-    // Processes all pending events in priority order
-    // EMERGENCY events are processed before any NORMAL events
-    // Call this method regularly from the "main" loop
-    void processEvents();
+    // Fires due timers, then processes pending events in priority order and returns how
+    // many events were dispatched (timers are not counted against the budget)
+    // EMERGENCY events are processed before any NORMAL events, including NORMAL events
+    // carried over from an earlier call
+    // Stops after maxEvents events, or once maxMicros have elapsed (0 = no time limit);
+    // at least one event is dispatched per call so the queue always makes progress.
+    // Anything left over is carried to the next call. With no limits it runs until the
+    // queues are empty, including events published by the callbacks themselves.
+    // Callbacks run without eventQueue_mutex held.
+    // Call this method regularly from the "main" loop - only one task may call it, and
+    // it is the only consumer of the cross-core hand-off queue
+    size_t processEvents(size_t maxEvents = NO_EVENT_LIMIT, uint32_t maxMicros = 0);
+
+    // Blocks the event-processing task until there is something to do: an event is
+    // published (any task, including publishRemote()), a timer is armed or falls due,
+    // or maxWaitMs passes - whichever comes first. Returns at once if events are
+    // already queued. Returns true if woken by a publish.
+    // maxWaitMs is the caller's own nearest deadline (sensor sampling etc.) and must be finite.
+    // Call from the same task as processEvents()
+    bool waitForWork(uint32_t maxWaitMs);
+
+    // True if events are queued or carried over from a budget-limited processEvents()
+    // Call from the processEvents() task
+    bool hasPendingEvents() const;
     
     // Utility methods - thread-safe
     
-    // Removes all events and optionally all subscriptions
+    // Removes all events, pending timers and subscriptions
+    // Also unseals the subscriber table
+    // Must not run concurrently with processEvents()
     void clear();
+
+    // Freezes the subscriber table - call once at the end of setup()
+    // After this, dispatch needs no lock, no allocation and no tree lookup
+    void seal();
+    bool isSealed() const { return sealed.load(std::memory_order_acquire); }
     
     // Returns true if the event type has any subscribers
     bool hasSubscriptions(BridgeEvent eventType) const;
 
+    // Snapshot of queue overflow counters and high-water marks
+    EventQueueStats getQueueStats() const;
+
+    // Idle time and wake-to-dispatch latency of the processEvents() task
+    EventLoopStats getLoopStats() const;
+
+    // Per-event latency histograms, recorded by processEvents()
+    // Queue wait: publish → start of dispatch. Dispatch: all subscribers of one event.
+    const LatencyHistogram& queueWaitHistogram(BridgeEvent eventType) const;
+    const LatencyHistogram& dispatchHistogram(BridgeEvent eventType) const;
+
+    // Fills out[] with the callback timing of up to capacity subscriptions and returns how
+    // many were written; the one that stalls the control core has the largest maxUs
+    size_t getSubscriberTimings(SubscriberTiming* out, size_t capacity) const;
+    size_t subscriptionCount() const;
+
+    // Zeroes the histograms and per-subscriber timings
+    void resetMetrics();
+
+    // Names every subscription made while it is in scope, for the metrics above
+    //   EventBus::SubscriberLabel label(m_eventBus, "SafetyManager");
+    // label must outlive the bus (a string literal)
+    class SubscriberLabel {
+    public:
+        SubscriberLabel(EventBus& bus, const char* label) : bus_(bus), previous_(bus.subscriberLabel) {
+            bus_.subscriberLabel = label;
+        }
+        ~SubscriberLabel() { bus_.subscriberLabel = previous_; }
+        SubscriberLabel(const SubscriberLabel&) = delete;
+        SubscriberLabel& operator=(const SubscriberLabel&) = delete;
+
+    private:
+        EventBus& bus_;
+        const char* previous_;
+    };
+
+    // Writes every publish, drop and dispatch to recorder (nullptr turns tracing off)
+    // Set before the tasks start; the recorder must outlive the bus
+    void setTraceRecorder(TraceRecorder* recorder) { trace = recorder; }
+    TraceRecorder* traceRecorder() const { return trace; }
+
+    // Snapshot of the payload pool (shared by every EventBus instance)
+    EventPoolStats getPoolStats() const { return EventPool::getStats(); }
+
 private:
-    // Maps event types to their list of subscribers
-    std::map<BridgeEvent, std::vector<EventSubscription>> subscribers;
+    // Subscriber lists indexed directly by BridgeEvent value, plus one shared
+    // list (MASK_LIST) for subscribe(EventMask) entries
+    static constexpr size_t MASK_LIST = BRIDGE_EVENT_COUNT;
+    std::array<std::vector<EventSubscription>, BRIDGE_EVENT_COUNT + 1> subscribers;
+
+    // Where each live subscription sits, so unsubscribe() is O(1)
+    // SubscriptionId = generation << 16 | (slot index + 1); the generation is bumped when a
+    // slot is freed, so a stale token can never remove a later subscription
+    struct SubscriptionSlot {
+        uint16_t generation = 0;
+        uint8_t eventIndex = 0;   // Which subscribers[] list
+        bool used = false;
+        bool deferred = false;    // Still in deferredSubscriptions (added during dispatch)
+        uint16_t position = 0;    // Index into that list (or into deferredSubscriptions)
+    };
+    std::vector<SubscriptionSlot> subscriptionSlots;
+    std::vector<uint16_t> freeSlots;
+
+    // Subscriptions added from inside a callback; inserting mid-dispatch would move the
+    // Delegate that is currently running, so they are applied after dispatch instead
+    std::vector<EventSubscription> deferredSubscriptions;
+    // Inactive entries waiting for compactSubscribers()
+    size_t pendingRemovals = 0;
+    // Applied to new subscriptions; set by SubscriberLabel
+    const char* subscriberLabel = nullptr;
+    // True while processEvents() is running callbacks (read under subscribers_mutex)
+    bool dispatching = false;
+
+    // Set by seal(); the subscriber table is read-only while this is true
+    std::atomic<bool> sealed{false};
     
-    // Queue of events waiting to be processed
-    std::vector<QueuedEvent> eventQueue;
+    // Events waiting to be processed, one ring per priority
+    // EMERGENCY ring is always drained before the NORMAL ring
+    // Publishers push here under eventQueue_mutex
+    EventRingQueue emergencyQueue;
+    EventRingQueue normalQueue;
+
+    // Events taken by processEvents() and being dispatched; swapped with the rings above
+    // Owned by the processEvents() task, so read without the queue lock
+    EventRingQueue emergencyBatch;
+    EventRingQueue normalBatch;
+
+    // Set when an EMERGENCY event is queued, so a long NORMAL batch can be
+    // interrupted without taking the queue lock between events
+    std::atomic<bool> emergencyPending{false};
+    uint32_t budgetStops = 0;
+
+    // Overflow tracking (see publish() for the drop policy)
+    uint32_t emergencyDropped = 0;
+    uint32_t normalDropped = 0;
+    size_t emergencyHighWater = 0;
+    size_t normalHighWater = 0;
+    bool emergencyOverflowReported = false;  // Log once per overflow burst
+    bool normalOverflowReported = false;
+
+    // Latency histograms per BridgeEvent; fixed memory, written only by processEvents()
+    struct EventTimings {
+        LatencyHistogram queueWait;
+        LatencyHistogram dispatch;
+    };
+    std::array<EventTimings, BRIDGE_EVENT_COUNT> eventTimings;
+
+    // Deadlines armed through publishAfter()/callAfter(); advanced by processEvents()
+    TimerWheel timers;
+
+    // Binary flight recorder, see setTraceRecorder()
+    TraceRecorder* trace = nullptr;
+
+    // Wakes waitForWork(); signalled by every publish path and by timer scheduling
+    WakeSignal wakeSignal;
+    // micros() of the oldest publish not yet seen by processEvents() (0 = none), for latency stats
+    std::atomic<uint32_t> wakeRequestUs{0};
+
+    // waitForWork()/processEvents() timing, guarded by eventQueue_mutex
+    uint32_t loopWaits = 0;
+    uint32_t loopNotifiedWakeups = 0;
+    uint32_t loopTimeoutWakeups = 0;
+    uint64_t loopIdleUs = 0;
+    uint64_t loopBusyUs = 0;
+    unsigned long lastWakeUs = 0;   // When the last waitForWork() returned (0 = never waited)
+    uint32_t wakeLatencySamples = 0;
+    uint64_t wakeLatencyTotalUs = 0;
+    uint32_t wakeLatencyMaxUs = 0;
+
+    // Cross-core hand-off (see publishRemote()); producers never touch eventQueue_mutex
+    MpscQueue<QueuedEvent, REMOTE_QUEUE_CAPACITY> remoteQueue;
+    std::atomic<uint32_t> remoteDropped{0};
+    std::atomic<bool> remoteOverflowReported{false};
     
     // Mutexes for thread synchronisation
     mutable std::recursive_mutex subscribers_mutex;  // Protects subscribers map (recursive for nested calls)
-    std::recursive_mutex eventQueue_mutex;           // Protects event queue (recursive for nested calls)
+    mutable std::recursive_mutex eventQueue_mutex;   // Protects event queues (recursive for nested calls)
+
+    // Shared by both subscribe() overloads
+    SubscriptionId subscribePayload(BridgeEvent eventType, EventPayloadCallback callback,
+                                    EventPriority priority);
+    // Allocates a slot/token and inserts the subscription (or defers it during dispatch)
+    // Caller holds subscribers_mutex
+    SubscriptionId addSubscription(size_t eventIndex, EventSubscription&& subscription);
+    // Keeps a subscriber list ordered EMERGENCY first, registration order within a priority
+    void insertByPriority(size_t eventIndex, EventSubscription&& subscription);
+    // Resolves a token to its slot, or nullptr if unknown/stale
+    SubscriptionSlot* findSlot(SubscriptionId id);
+    void freeSlot(SubscriptionId id);
+    // Applies deferred subscriptions and drops inactive entries; caller holds
+    // subscribers_mutex, not dispatching and not sealed
+    void compactSubscribers();
+
+    // Pushes onto the ring for the event's priority, applying the drop policy
+    // Caller holds eventQueue_mutex; false if the event was dropped
+    bool enqueueLocked(QueuedEvent&& event);
+    // Moves everything in the hand-off queue into the rings; caller holds eventQueue_mutex
+    void drainRemoteEvents();
+
+    // Swaps any non-empty publish ring into its (empty) dispatch ring; takes eventQueue_mutex
+    void refillBatches();
+    // Next event to dispatch in priority order; false when nothing is pending
+    bool takeNextEvent(QueuedEvent& out);
+    // Runs the subscribers for one event
+    void dispatchEvent(QueuedEvent& event);
+    // Trace record for a finished dispatch (no-op without a recorder)
+    void traceDispatch(QueuedEvent& event, unsigned long startUs, uint32_t durationUs);
+    // Releases the payload of every queued event and empties all rings
+    void discardQueuedEvents();
+    // Stamps the publish time (if none is pending) and wakes waitForWork()
+    void signalWake();
 };
 
 // Global instance declaration
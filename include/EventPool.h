@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fixed-size block pool
+ * BlockCount blocks of BlockSize bytes live inside the object itself; free blocks
+ * form an intrusive singly linked list, so allocate/release are O(1) and never touch the heap.
+ * Not thread-safe on its own; EventPool guards it with a mutex.
+ */
+template <size_t BlockSize, size_t BlockCount>
+class FixedBlockPool {
+    static_assert(BlockSize >= sizeof(void*), "Block must be able to hold the free-list link");
+    static_assert(BlockSize % alignof(std::max_align_t) == 0, "Block size must keep every block aligned");
+
+public:
+    FixedBlockPool() {
+        // Thread every block onto the free list, lowest address first
+        for (size_t i = 0; i + 1 < BlockCount; ++i) {
+            blocks_[i].next = &blocks_[i + 1];
+        }
+        blocks_[BlockCount - 1].next = nullptr;
+        freeList_ = &blocks_[0];
+    }
+
+    // Returns nullptr when every block is in use
+    void* allocate() {
+        if (!freeList_) {
+            return nullptr;
+        }
+        Block* block = freeList_;
+        freeList_ = block->next;
+        inUse_++;
+        if (inUse_ > highWater_) {
+            highWater_ = inUse_;
+        }
+        return block->bytes;
+    }
+
+    // ptr must come from allocate() on this pool (check with owns())
+    void release(void* ptr) {
+        Block* block = static_cast<Block*>(ptr);
+        block->next = freeList_;
+        freeList_ = block;
+        inUse_--;
+    }
+
+    bool owns(const void* ptr) const {
+        const uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+        const uintptr_t first = reinterpret_cast<uintptr_t>(&blocks_[0]);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(&blocks_[BlockCount]);
+        return p >= first && p < end;
+    }
+
+    size_t inUse() const { return inUse_; }
+    size_t highWater() const { return highWater_; }
+    static constexpr size_t capacity() { return BlockCount; }
+    static constexpr size_t blockSize() { return BlockSize; }
+
+private:
+    union alignas(std::max_align_t) Block {
+        Block* next;                      // Valid while the block is free
+        unsigned char bytes[BlockSize];   // Payload storage while the block is in use
+    };
+
+    Block blocks_[BlockCount];
+    Block* freeList_ = nullptr;
+    size_t inUse_ = 0;
+    size_t highWater_ = 0;
+};
+
+/**
+ * Pool health counters, readable at runtime for diagnostics
+ * Exhaustion counts are cumulative since boot
+ */
+struct EventPoolStats {
+    size_t smallBlockSize;
+    size_t smallCapacity;
+    size_t smallInUse;
+    size_t smallHighWater;
+    size_t largeBlockSize;
+    size_t largeCapacity;
+    size_t largeInUse;
+    size_t largeHighWater;
+    uint32_t exhausted;   // Allocations that fell back to the heap because the pools were full
+    uint32_t oversize;    // Allocations bigger than the large block (always heap)
+};
+
+/**
+ * EventPool - size-class slab for EventData payloads
+ *
+ * EventData overrides operator new/delete to come here, so every payload
+ * published through the pointer API (`publish(type, new SimpleEventData(...))`)
+ * is carved from one of two static block pools instead of the general heap.
+ * EventBus::emplace<T>() of a built-in payload type needs no allocation at all -
+ * it is stored inline in the queue (see EventPayload in EventBus.h).
+ *
+ * Small blocks hold the fixed-size payloads (SimpleEventData, BoatEventData,
+ * StateChangeData, ...); large blocks hold LightChangeData and its two Strings.
+ * A small request spills into the large pool before giving up. If both are
+ * full the payload comes from the heap so an event is never lost to the pool,
+ * the exhaustion counter is incremented and a warning is logged once per burst.
+ *
+ * Thread-safe: payloads are created on both cores (network task and control task).
+ */
+namespace EventPool {
+
+// Sized so both EventBus rings (16 + 64) can be full of small payloads at once
+constexpr size_t SMALL_BLOCK_SIZE = 32;
+constexpr size_t SMALL_BLOCK_COUNT = 96;
+
+// LightChangeData carries two Strings; light changes arrive a few at a time
+constexpr size_t LARGE_BLOCK_SIZE = 96;
+constexpr size_t LARGE_BLOCK_COUNT = 16;
+
+void* allocate(size_t size);
+void release(void* ptr);
+
+EventPoolStats getStats();
+
+} // namespace EventPool
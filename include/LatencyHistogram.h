@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * LatencyHistogram - fixed-size, log2-bucketed histogram of microsecond durations
+ *
+ * Bucket 0 holds 0 us; bucket i (1..BUCKETS-2) holds [2^(i-1), 2^i) us; the last
+ * bucket holds everything from 2^(BUCKETS-2) us (~0.5 s) up. Percentiles are
+ * reported as the upper edge of their bucket, so they are accurate to within 2x -
+ * enough to tell a 50 us handler from a 5 ms one.
+ *
+ * Single writer (the event-processing task), any number of readers: counters are
+ * relaxed atomics updated with load+store, so record() costs no locked instruction
+ * and a reader on the other core never sees a torn value.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 21;
+
+    struct Summary {
+        uint32_t count;
+        uint32_t p50Us;
+        uint32_t p90Us;
+        uint32_t p99Us;
+        uint32_t maxUs;
+    };
+
+    void record(uint32_t us) {
+        bump(buckets_[bucketFor(us)]);
+        bump(count_);
+        if (us > max_.load(std::memory_order_relaxed)) {
+            max_.store(us, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint32_t bucketCount(size_t bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+
+    Summary summary() const {
+        Summary s;
+        s.count = count();
+        s.p50Us = percentile(50);
+        s.p90Us = percentile(90);
+        s.p99Us = percentile(99);
+        s.maxUs = max_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Upper edge (us) of the bucket holding the given percentile; 0 when empty
+    // The top bucket is open-ended, so it reports the recorded maximum instead
+    uint32_t percentile(uint32_t pct) const {
+        const uint32_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        const uint64_t rank = (static_cast<uint64_t>(total) * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += bucketCount(i);
+            if (seen >= rank) {
+                return (i + 1 < BUCKETS) ? upperEdgeUs(i) : max_.load(std::memory_order_relaxed);
+            }
+        }
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    // Largest value that lands in bucket i (bucket 0 is exactly 0 us)
+    static uint32_t upperEdgeUs(size_t bucket) {
+        return bucket == 0 ? 0 : (1u << bucket) - 1;
+    }
+
+    static size_t bucketFor(uint32_t us) {
+        if (us == 0) {
+            return 0;
+        }
+        const size_t bits = 32 - static_cast<size_t>(__builtin_clz(us));  // 1 → 1, 2..3 → 2, ...
+        return bits < BUCKETS ? bits : BUCKETS - 1;
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static void bump(std::atomic<uint32_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint32_t>, BUCKETS> buckets_{};
+    std::atomic<uint32_t> count_{0};
+    std::atomic<uint32_t> max_{0};
+};
@@ -10,7 +10,6 @@ public:
     
     void begin();
     void setState();
-    void update();  // Call from main loop for blinking
     void halt();
     
 private:
@@ -24,13 +23,15 @@ private:
     CRGB leds[NUM_LEDS];
     BridgeState currentState;
     bool isBlinking;
-    unsigned long lastBlinkTime;
+    TimerId blinkTimer;  // Re-armed every BLINK_INTERVAL_MS while isBlinking
     bool blinkState;  // true = on, false = off
     
+    static constexpr uint32_t BLINK_INTERVAL_MS = 500;  // 1 Hz blink (500ms on, 500ms off)
+    
     void setSolidColor(CRGB color);
     void setBlinkingColor(CRGB color);
     void rainbowStartup();
-    void updateBlinking();
+    void onBlinkTimer();
     CRGB getStateColor(BridgeState state);
     bool shouldBlink(BridgeState state);
 };
@@ -12,6 +12,7 @@ public:
     void lowerBridge();
     void halt();
     void checkProgress();       // Check motor operation progress (non-blocking)
+    bool isMotorRunning() const { return m_motorRunning; }  // checkProgress() only has work while true
     
     // Testing and calibration methods
     void testMotor();      // For initial testing
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Bounded lock-free multi-producer / single-consumer queue
+ *
+ * Array of cells, each with a sequence number (Dmitry Vyukov's bounded queue).
+ * Producers claim a slot with one CAS on the enqueue index and publish it by
+ * bumping the cell's sequence; the single consumer reads cells in order and
+ * hands them back by advancing the sequence one lap. No locks, no allocation
+ * after construction, and a producer never waits for the consumer - a full
+ * queue makes tryPush() fail immediately.
+ *
+ * tryPush() may be called from any task/core; tryPop() only from one consumer.
+ * Capacity must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any producer. Returns false (item left untouched) if the queue is full
+    bool tryPush(T&& item) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & MASK];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Cell is free for this lap - try to claim it
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS failure reloaded pos; retry
+            } else if (diff < 0) {
+                // Consumer has not freed this cell yet - queue is full
+                return false;
+            } else {
+                // Another producer claimed it first
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only. Oldest ready item, or nullptr if nothing is ready
+    // The item stays queued (and owned by the queue) until tryPop()
+    const T* peek() const {
+        const Cell& cell = cells_[dequeuePos_ & MASK];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0) {
+            return nullptr;
+        }
+        return &cell.value;
+    }
+
+    // Single consumer only. Returns false if nothing is ready
+    bool tryPop(T& out) {
+        Cell& cell = cells_[dequeuePos_ & MASK];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0) {
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.sequence.store(dequeuePos_ + Capacity, std::memory_order_release);
+        dequeuePos_++;
+        return true;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Cell cells_[Capacity];
+    alignas(64) std::atomic<size_t> enqueuePos_{0};  // Shared by producers
+    alignas(64) size_t dequeuePos_ = 0;              // Consumer only
+};
@@ -17,7 +17,7 @@
  * 
  * Integration:
  * - Subscribes to all events for safety monitoring
- * - Monitors state transition times
+ * - Arms an EventBus timer for each expected state transition
  * - Directly calls motor stop and light control functions in emergencies
  */
 
@@ -29,9 +29,6 @@ public:
     // Initialize the safety manager
     void begin();
     
-    // Update method called from main loop to handle periodic safety checks
-    void update();
-    
     // Emergency stop handling
     void triggerEmergency(const char* reason);
     bool isEmergencyActive() const;
@@ -66,9 +63,9 @@ private:
     bool m_emergencyActive;
     bool m_simulationMode;
     
-    // State transition monitoring
+    // State transition monitoring - one EventBus timer per watched transition
     BridgeEvent m_lastStateEvent;
-    unsigned long m_stateEventTime;
+    TimerId m_transitionTimer;
     
     // Expected state transitions and timeouts (milliseconds)
     static constexpr unsigned long BOAT_DETECTED_TIMEOUT_MS = 2000;        // 2 seconds
@@ -82,7 +79,9 @@ private:
     
     // Private methods
     void enterSafeState(const char* reason);
-    void checkStateTransitionTimeouts();
+    void startTransitionTimer(BridgeEvent stateEvent);
+    void stopTransitionTimer();
+    void onStateTransitionTimeout();
     void onEvent(EventData* data);
     void handleCommand(const Command& command);
     
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Single-writer sequence lock around a trivially copyable value
+ *
+ * The writer makes the sequence odd, copies the value in and makes it even again; a
+ * reader copies the value out between two reads of the sequence and keeps the copy only
+ * if both were the same even number, otherwise it tries again. Readers never block the
+ * writer and never write shared memory, so any number of them (on either core) cost the
+ * writer nothing. The value is stored as relaxed atomic words, so a copy that races a
+ * store is discarded rather than being undefined behaviour.
+ *
+ * store() from one task only; load() / tryLoad() from any task.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable type");
+
+public:
+    explicit SeqLock(const T& initial = T()) { store(initial); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer only
+    void store(const T& value) {
+        uint32_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any task. Spins only while a store() is in flight (a few dozen word writes)
+    T load() const {
+        T value;
+        while (!tryLoad(value)) {
+        }
+        return value;
+    }
+
+    // Any task. One attempt; false (out untouched) if it overlapped a store()
+    bool tryLoad(T& out) const {
+        const uint32_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+        uint32_t words[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    // Completed stores, the constructor's included
+    uint32_t stores() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> words_[WORDS];
+};
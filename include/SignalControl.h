@@ -12,7 +12,6 @@ public:
     void resumeTraffic();
     void halt();
     void resetToIdleState();
-    void update();  // Called from main loop to process timing
     
     // Car traffic controls (both sides together)
     void setCarTraffic(const String& color);
@@ -50,16 +49,26 @@ private:
         COMPLETE
     };
     
+    // Phase lengths; each phase is one EventBus timer, armed when the previous one ends
+    static constexpr uint32_t YELLOW_WARNING_MS = 6000;   // Green→Yellow, then Red
+    static constexpr uint32_t RED_CLEARANCE_MS = 6000;    // Red before SUCCESS (12s total)
+    static constexpr uint32_t RESUME_RED_HOLD_MS = 2000;  // Red before Green on resume
+    
     Operation m_currentOperation;
     StopPhase m_stopPhase;
     ResumePhase m_resumePhase;
-    unsigned long m_operationStartTime;
+    TimerId m_operationTimer;   // Ends the current stop/resume phase
     
     // Boat queue timer state
     bool m_boatQueueActive;
-    unsigned long m_boatQueueStartTime;
+    TimerId m_boatQueueTimer;   // Fires BOAT_GREEN_PERIOD_EXPIRED
     String m_boatQueueSide;  // Which side's light is green ("left" or "right")
     
     // Pedestrian crossing timer state
     unsigned long m_pedestrianTimerStartTime;  // When pedestrian crossing period started (0 if inactive)
+    
+    // Timer callbacks (run from EventBus::processEvents())
+    void onOperationPhaseElapsed();
+    void onBoatGreenPeriodElapsed();
+    void cancelOperationTimer();
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "WakeSignal.h"
+
+/**
+ * SnapshotCoalescer - dirty version + rate limit for the UI snapshot broadcast
+ *
+ * Producers (the control core's EventBus subscriber) only call markDirty(): one relaxed
+ * increment and a wake, no JSON. The consumer (the network task) asks takeDue() and,
+ * when it says yes, builds and sends one snapshot that covers every change since the
+ * last one. The first change after a quiet period goes out at once; changes inside
+ * intervalMs of a send are held and coalesced into the next.
+ *
+ * Any number of producers, one consumer. Counters may be read from any task.
+ */
+class SnapshotCoalescer {
+public:
+    static constexpr uint32_t DEFAULT_INTERVAL_MS = 50;
+    static constexpr uint32_t NOT_DIRTY = UINT32_MAX;  // msUntilDue() with nothing to send
+
+    struct Stats {
+        uint32_t marked;      // markDirty() calls
+        uint32_t sent;        // Snapshots takeDue() released
+        uint32_t suppressed;  // Marks folded into another mark's snapshot
+    };
+
+    explicit SnapshotCoalescer(uint32_t intervalMs = DEFAULT_INTERVAL_MS) : intervalMs_(intervalMs) {}
+
+    SnapshotCoalescer(const SnapshotCoalescer&) = delete;
+    SnapshotCoalescer& operator=(const SnapshotCoalescer&) = delete;
+
+    // 0 sends on every takeDue() that has a change (no rate limit, still coalesced)
+    void setIntervalMs(uint32_t intervalMs) { intervalMs_.store(intervalMs, std::memory_order_relaxed); }
+    uint32_t intervalMs() const { return intervalMs_.load(std::memory_order_relaxed); }
+
+    // Any task: the state behind the snapshot changed
+    void markDirty();
+
+    // Consumer: true if a snapshot should be sent now; the caller then sends exactly one
+    bool takeDue(uint32_t nowMs);
+
+    // Consumer: ms until takeDue() would say yes (0 = now), or NOT_DIRTY
+    uint32_t msUntilDue(uint32_t nowMs) const;
+
+    // Consumer: sleeps until markDirty() or timeoutMs; true if woken by a mark
+    bool wait(uint32_t timeoutMs) { return wake_.wait(timeoutMs); }
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    std::atomic<uint32_t> intervalMs_;
+    std::atomic<uint32_t> version_{0};
+    WakeSignal wake_;
+
+    // Consumer-owned; the counters are atomic only so stats() can run on another task
+    uint32_t sentVersion_ = 0;
+    uint32_t lastSentMs_ = 0;
+    bool everSent_ = false;
+    std::atomic<uint32_t> marked_{0};
+    std::atomic<uint32_t> sent_{0};
+    std::atomic<uint32_t> suppressed_{0};
+};
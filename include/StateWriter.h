@@ -1,9 +1,13 @@
 #pragma once
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <atomic>
+#include <functional>
 #include <mutex>
-#include <vector>
+#include "ActivityLog.h"
 #include "EventBus.h"
+#include "SeqLock.h"
+#include "UiState.h"
 #include "BridgeSystemDefs.h"
 #include "SignalControl.h"
 
@@ -12,7 +16,7 @@ class SignalControl;
 
 class StateWriter {
 public:
-  explicit StateWriter(EventBus& bus);
+  explicit StateWriter(EventBus& bus, size_t logCapacity = ActivityLog::DEFAULT_CAPACITY);
 
   void beginSubscriptions();
   void attachConsole(ConsoleCommands* console);
@@ -23,45 +27,121 @@ public:
   void fillBoatTrafficStatus(JsonObject obj) const;
   void fillSystemStatus(JsonObject obj) const;
 
+  // Every change bumps the state version. A snapshot carries all of the state and the
+  // version ("seq") it is at least as new as, plus "logNext", the seq of the first log
+  // line it does not cover (the log itself is fetched with fillLog). A patch carries only
+  // the sections and log lines changed after sinceVersion ("from"), up to "seq".
   void buildSnapshot(JsonDocument& out) const;
+  void fillSnapshot(JsonObject payload) const;
+  // False when the log has already dropped lines the patch would need - send a snapshot
+  bool buildPatch(JsonDocument& out, uint32_t sinceVersion) const;
+  uint32_t version() const;
 
-  std::vector<String> getActivityLog() const;
+  // One consistent copy of the published state; lock-free, callable from any task
+  UiState state() const { return published_.load(); }
+
+  // The same, serialized once and shared by every GET, connect and resync until the state
+  // (or a value shown live - pedestrian countdown, log level, streaming) moves on
+  String bridgeStatusJson() const;
+  String carTrafficStatusJson() const;
+  String boatTrafficStatusJson() const;
+  String systemStatusJson() const;
+  String snapshotPayloadJson() const;
+  String snapshotJson() const;
+
+  struct CacheStats {
+    uint32_t hits;
+    uint32_t misses;
+  };
+  CacheStats cacheStats() const;
+
+  // Activity log lines with seq > sinceSeq, oldest first, at most LOG_PAGE_LINES of them
+  // ("more" says to ask again from the last one). LOG_LATEST gives the newest page. Lines
+  // already overwritten are reported as "dropped".
+  static constexpr size_t LOG_PAGE_LINES = 32;
+  static constexpr uint32_t LOG_LATEST = UINT32_MAX;
+  void fillLog(JsonObject payload, uint32_t sinceSeq) const;
 
 private:
   EventBus& bus_;
   ConsoleCommands* console_ = nullptr;
   SignalControl* signalControl_ = nullptr;
-  mutable std::mutex mu_;
-
-  String bridgeState_ = "IDLE";
-  bool bridgeLockEngaged_ = true;
-  uint32_t bridgeLastChangeMs_ = 0;
-
-  String carLeft_ = "Green";
-  String carRight_ = "Green";
-  
-  String boatLeft_ = "Red";
-  String boatRight_ = "Red";
-  
-  // Boat green period timer tracking
-  uint32_t boatTimerStartMs_ = 0;  // When boat green period started (0 = inactive)
-  String boatTimerSide_ = "";       // Which side has green ("left" or "right", empty if inactive)
-
-  bool inFault_ = false;
-  bool manualMode_ = false;
-  bool simulationMode_ = false;
-  bool simUltrasonicLeftEnabled_ = false;
-  bool simUltrasonicRightEnabled_ = false;
-  bool simBeamBreakEnabled_ = false;
-
-  static constexpr size_t LOG_CAP_ = 64;
-  std::vector<String> log_;
-  uint32_t logSeq_ = 0;
-
-  void onEvent(EventData* data);
-  void applyEvent(BridgeEvent ev, EventData* data);
-  void pushLog(const String& line);
+
+  // The apply* handlers run on the EventBus dispatch task only: they change state_ and
+  // publish a copy of it, which readers on any task take without a lock
+  UiState state_;
+  SeqLock<UiState> published_;
+
+  // Snapshot sections, for the version each last changed at
+  enum Section : uint8_t {
+    SECTION_BRIDGE = 1 << 0,
+    SECTION_CAR = 1 << 1,
+    SECTION_BOAT = 1 << 2,
+    SECTION_SYSTEM = 1 << 3,
+  };
+
+  // Activity log lines as codes + byte args, formatted when read
+  enum ActivityCode : uint8_t {
+    ACT_EVENT,          // "Event: <event>"                       args: event
+    ACT_REQUEST,        // "Request: <event>[ (car=<c>,<c>)]"     args: event, colour, colour
+    ACT_TEXT,           // A fixed message                        args: ActivityText
+    ACT_STATE_CHANGED,  // "Bridge state changed: <from> -> <to>" args: state, state
+    ACT_SENSORS,        // "Simulation sensors updated: ..."      args: 3 flags
+    ACT_CAR_LIGHTS,     // "Car lights set to <colour>"           args: colour
+    ACT_CAR_LIGHT,      // "Car light (<side>) set to <colour>"   args: side, colour
+    ACT_BOAT_LIGHT,     // "Boat light (<side>) set to <colour>"  args: side, colour
+    ACT_LIGHTS_NOW,     // "<text> lights now <c>/<c>"            args: ActivityText, colour, colour
+  };
+  enum ActivityText : uint8_t {
+    TEXT_SIMULATION_ENABLED,
+    TEXT_SIMULATION_DISABLED,
+    TEXT_BRIDGE_OPENED,
+    TEXT_FAULT_DETECTED,
+    TEXT_SYSTEM_SAFE,
+    TEXT_SYSTEM_RESET,
+    TEXT_TRAFFIC_STOPPED,
+    TEXT_BRIDGE_CLOSED,
+    TEXT_TRAFFIC_RESUMED,
+  };
+  ActivityLog log_;
+
+  void touch(uint8_t sections);
+  void publish();
+
+  // Serialized JSON by what it was built from: a state version plus the live values
+  enum CacheSlot : uint8_t { CACHE_BRIDGE, CACHE_CAR, CACHE_BOAT, CACHE_SYSTEM, CACHE_SNAPSHOT, CACHE_SLOTS };
+  struct CachedJson {
+    bool valid = false;
+    uint32_t version = 0;
+    uint64_t live = 0;
+    String json;
+  };
+  mutable std::mutex cacheMu_;
+  mutable CachedJson cache_[CACHE_SLOTS];
+  mutable std::atomic<uint32_t> cacheHits_{0};
+  mutable std::atomic<uint32_t> cacheMisses_{0};
+
+  static uint32_t sectionVersion(const UiState& s, Section section);
+  uint64_t liveKey(uint8_t sections) const;
+  String cachedJson(CacheSlot slot, uint32_t version, uint64_t live,
+                    const std::function<void(JsonObject)>& fill) const;
+
+  // From one published copy, so every section of a snapshot or patch agrees
+  void fillBridgeStatus(JsonObject obj, const UiState& s) const;
+  static void fillCarTrafficStatus(JsonObject obj, const UiState& s);
+  static void fillBoatTrafficStatus(JsonObject obj, const UiState& s);
+  void fillSystemStatus(JsonObject obj, const UiState& s) const;
+  void fillSnapshot(JsonObject payload, const UiState& s) const;
+
+  void applyEvent(BridgeEvent ev);
+  void applyStateChange(const StateChangeData& stateData);
+  void applySensorConfig(const SimulationSensorConfigData& cfgData);
+  void applyCarLight(const LightChangeData& lightData);
+  void applyBoatLight(const LightChangeData& lightData);
+  void pushLog(ActivityCode code, uint8_t arg0 = ActivityLog::NO_ARG, uint8_t arg1 = ActivityLog::NO_ARG,
+               uint8_t arg2 = ActivityLog::NO_ARG);
+  static void addLogLine(JsonArray lines, const ActivityLog::Entry& entry);
+  static size_t formatLogMessage(const ActivityLog::Entry& entry, char* out, size_t size);
 
   static const char* eventName(BridgeEvent ev);
-  static const char* stateToString(BridgeState state);
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "Delegate.h"
+
+// Handle for a scheduled timer; 0 is never issued
+typedef uint32_t TimerId;
+static const TimerId INVALID_TIMER_ID = 0;
+
+/**
+ * TimerWheel - hierarchical timing wheel for deferred work
+ *
+ * 1 ms resolution, four levels of 64 slots (1 ms, 64 ms, ~4.1 s and ~4.4 min per
+ * slot), so any delay up to ~4.6 hours lands in one slot. Timers come from a fixed
+ * pool and sit in intrusive lists:
+ *   - schedule() and cancel() are O(1)
+ *   - advance() touches one slot per elapsed millisecond; a timer is moved down a
+ *     level at most three times before it fires
+ *
+ * Time is passed in by the caller (millis() on the target), so the wheel itself
+ * has no clock and is driven directly in tests.
+ *
+ * Thread safety: every method takes the wheel's mutex, but callbacks run with it
+ * released, so a callback may schedule or cancel timers (including re-arming itself).
+ */
+class TimerWheel {
+public:
+    using Callback = Delegate<void()>;
+
+    // The firmware arms a handful of deadlines at once; the pool never grows
+    static constexpr size_t MAX_TIMERS = 32;
+    // Returned by nextDueIn() when nothing is scheduled
+    static constexpr uint32_t NO_TIMER = UINT32_MAX;
+
+    explicit TimerWheel(uint32_t nowMs = 0);
+
+    // Runs callback once, delayMs after nowMs (0 = on the next advance())
+    // Delays past the wheel's range are clamped to it
+    // Returns INVALID_TIMER_ID if the pool is exhausted or the callback is empty
+    TimerId schedule(uint32_t nowMs, uint32_t delayMs, Callback callback);
+
+    // Stops a pending timer; false if it already fired, was cancelled or is unknown
+    // Stale ids are safe: an id comes back only after 2^27 - 1 re-arms of one pool slot
+    bool cancel(TimerId id);
+
+    // Fires every timer due at or before nowMs, in deadline order; returns how many ran
+    // Only one task may call this
+    size_t advance(uint32_t nowMs);
+
+    // Milliseconds from nowMs until the earliest pending timer (0 if overdue),
+    // or NO_TIMER when none are pending
+    uint32_t nextDueIn(uint32_t nowMs) const;
+
+    size_t pending() const;
+
+    // Drops every pending timer without running it
+    void clear();
+
+private:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned SLOT_MASK = SLOTS - 1;
+    static constexpr unsigned LEVELS = 4;
+    static constexpr uint32_t MAX_DELAY_MS = (1u << (SLOT_BITS * LEVELS)) - 1;
+    static constexpr uint16_t NIL = UINT16_MAX;
+    // TimerId = generation << INDEX_BITS | slot index; generation 0 is skipped, so no id is 0
+    static constexpr unsigned INDEX_BITS = 5;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = UINT32_MAX >> INDEX_BITS;
+    static_assert(MAX_TIMERS <= (1u << INDEX_BITS), "pool index must fit in the id");
+
+    struct Node {
+        Callback callback;
+        uint32_t expires = 0;
+        uint16_t next = NIL;
+        uint16_t prev = NIL;
+        uint32_t generation = 1;
+        uint16_t bucket = 0;  // level * SLOTS + slot, while linked
+        bool used = false;
+    };
+
+    std::array<Node, MAX_TIMERS> nodes_;
+    std::array<uint16_t, LEVELS * SLOTS> buckets_;
+    uint16_t freeList_ = NIL;  // Chained through Node::next
+    size_t pending_ = 0;
+    uint32_t current_;         // Next tick to process
+    mutable std::mutex mutex_;
+
+    // Puts a node in the bucket for its deadline; caller holds mutex_
+    void link(uint16_t index);
+    void unlink(uint16_t index);
+    void release(uint16_t index);
+    // Re-files every timer in one bucket of a higher level; caller holds mutex_
+    void cascade(unsigned level, unsigned slot);
+    Node* find(TimerId id);
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "BridgeSystemDefs.h"
+#include "Delegate.h"
+#include "EventBus.h"
+
+/**
+ * What a trace record describes
+ */
+enum class TraceKind : uint8_t {
+    PUBLISH,         // Queued by publish() on the control core
+    PUBLISH_REMOTE,  // Queued by publishRemote() from the network core
+    DROP,            // Rejected by a full queue
+    DISPATCH         // Delivered to all subscribers; durationUs is set
+};
+
+/**
+ * One fixed-size trace entry (12 bytes, little-endian on the ESP32)
+ * Layout is read by tools/trace_decode.py - bump TraceRecorder::FORMAT_VERSION if it changes
+ */
+struct TraceRecord {
+    uint32_t timestampUs;  // micros() at publish / dispatch start (wraps every ~71 min)
+    uint8_t kind;          // TraceKind
+    uint8_t event;         // BridgeEvent
+    uint8_t side;          // BoatEventSide of the payload (UNKNOWN if it has none)
+    uint8_t priority;      // EventPriority
+    uint16_t queueDepth;   // Events still queued after this one was queued / dispatched
+    uint16_t durationUs;   // DISPATCH only, saturates at 65535
+};
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord layout is part of the dump format");
+
+/**
+ * TraceRecorder - binary flight recorder for EventBus traffic
+ *
+ * Attach one to an EventBus with setTraceRecorder() and every publish, drop and
+ * dispatch is written into a preallocated ring of CAPACITY records; once full, the
+ * oldest records are overwritten. record() is lock-free and may be called from both
+ * cores at once. A writer that laps the ring onto a slot another writer is still
+ * filling drops its record (see overruns()) rather than tear the slot.
+ *
+ * dump() streams the ring (oldest first) behind a small header. Recording is paused
+ * while it runs, so the dump is a consistent snapshot. beginDump() / readDump() /
+ * endDump() produce the same bytes a few at a time, for a caller that cannot block
+ * for the whole dump; recording stays paused until endDump(). One dump at a time.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t CAPACITY = 4096;  // 48 KB of records
+    static constexpr uint32_t MAGIC = 0x43525442;  // "BTRC" as little-endian bytes
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr size_t CHUNK_RECORDS = 32;
+
+    // Receives the dump in pieces: the header, then up to CHUNK_RECORDS records at a time
+    // Every piece is a multiple of 3 bytes, so each can be base64-encoded on its own
+    using DumpSink = Delegate<void(const uint8_t*, size_t)>;
+
+    TraceRecorder() = default;
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    void record(TraceKind kind, BridgeEvent event, BoatEventSide side, EventPriority priority,
+                size_t queueDepth, uint32_t timestampUs, uint32_t durationUs = 0);
+
+    // Recording is on by default
+    void setEnabled(bool enabled) { enabled_.store(enabled); }
+    bool isEnabled() const { return enabled_.load(); }
+
+    // Records currently held (at most CAPACITY) and records written since the last clear()
+    size_t size() const;
+    uint32_t totalRecorded() const { return head_.load(std::memory_order_relaxed); }
+    // Records dropped because their slot was still being written by a lapped writer
+    uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+    // Copies up to capacity records, oldest first; returns how many were copied
+    size_t snapshot(TraceRecord* out, size_t capacity);
+
+    // Writes the header and every held record to sink, oldest first; returns the record count
+    // Header: magic u32, version u16, record size u16, record count u32, total recorded u32,
+    // capacity u32, micros() at dump u32
+    size_t dump(const DumpSink& sink);
+
+    // Where an incremental dump is up to
+    struct DumpCursor {
+        uint8_t header[HEADER_SIZE];
+        uint32_t first;   // Sequence number of the oldest record dumped
+        size_t records;   // Records in the dump
+        size_t offset;    // Bytes of the dump already read
+        bool wasEnabled;  // Recording state to restore at endDump()
+    };
+
+    // Pauses recording and fixes the records to dump; false if another dump is running
+    bool beginDump(DumpCursor& cursor);
+    // Copies the next bytes of the dump (header first, as dump() writes it) into out; returns
+    // how many, 0 once it is all read. A multiple of 3 bytes whenever max is.
+    size_t readDump(DumpCursor& cursor, uint8_t* out, size_t max) const;
+    void endDump(const DumpCursor& cursor);
+
+    void clear();
+
+private:
+    // Stops new records and waits for writers already inside record(); returns the old enabled flag
+    bool pause();
+    void fillHeader(uint8_t* header, size_t held, uint32_t total) const;
+
+    std::array<TraceRecord, CAPACITY> records_{};
+    std::array<std::atomic<bool>, CAPACITY> busy_{};  // Slot is being written
+    std::atomic<uint32_t> overruns_{0};
+    std::atomic<uint32_t> head_{0};     // Sequence number of the next record
+    std::atomic<bool> enabled_{true};
+    std::atomic<uint32_t> writers_{0};  // Threads currently inside record()
+    std::atomic<bool> dumping_{false};  // A dump (either kind) is in progress
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BridgeSystemDefs.h"
+
+enum class LightColour : uint8_t { RED, YELLOW, GREEN };
+
+// "both" only arrives on car light changes; NONE is the idle boat timer
+enum class LightSide : uint8_t { NONE, LEFT, RIGHT, BOTH };
+
+// Names the UI and the activity log use, looked up only when serializing
+constexpr const char* LIGHT_COLOUR_NAMES[] = {"Red", "Yellow", "Green"};
+constexpr const char* LIGHT_SIDE_NAMES[] = {"", "left", "right", "both"};
+constexpr const char* BRIDGE_STATE_NAMES[] = {
+    "IDLE", "STOPPING_TRAFFIC", "OPENING", "OPEN", "CLOSING", "RESUMING_TRAFFIC", "FAULT",
+    "MANUAL_MODE", "MANUAL_OPENING", "MANUAL_OPEN", "MANUAL_CLOSING", "MANUAL_CLOSED",
+};
+static_assert(sizeof(BRIDGE_STATE_NAMES) / sizeof(BRIDGE_STATE_NAMES[0]) ==
+                  static_cast<size_t>(BridgeState::MANUAL_CLOSED) + 1,
+              "BRIDGE_STATE_NAMES must list every BridgeState");
+
+constexpr const char* toString(LightColour colour) {
+    return LIGHT_COLOUR_NAMES[static_cast<uint8_t>(colour)];
+}
+constexpr const char* toString(LightSide side) {
+    return LIGHT_SIDE_NAMES[static_cast<uint8_t>(side)];
+}
+constexpr const char* toString(BridgeState state) {
+    return static_cast<size_t>(state) < sizeof(BRIDGE_STATE_NAMES) / sizeof(BRIDGE_STATE_NAMES[0])
+               ? BRIDGE_STATE_NAMES[static_cast<size_t>(state)]
+               : "UNKNOWN_STATE";
+}
+
+/**
+ * UiState - everything the UI shows about the bridge, as one plain struct
+ *
+ * StateWriter builds it on the control core and publishes whole copies through a
+ * SeqLock; the network core reads one consistent copy without taking a lock. Lights,
+ * sides and the bridge state are enums and the flags are bits, so an event is a few
+ * byte stores and the struct is a handful of words to copy. The activity log is not
+ * part of it.
+ */
+struct UiState {
+    static constexpr size_t SECTION_COUNT = 4;  // bridge, car, boat, system
+
+    UiState()
+        : bridgeLockEngaged(true), manualMode(false), inFault(false), simulationMode(false),
+          simUltrasonicLeftEnabled(false), simUltrasonicRightEnabled(false), simBeamBreakEnabled(false) {}
+
+    // Every change bumps version; each section records the version it last changed at
+    uint32_t version = 0;
+    uint32_t sectionVersion[SECTION_COUNT] = {};
+
+    uint32_t bridgeLastChangeMs = 0;
+    // Boat green period timer tracking
+    uint32_t boatTimerStartMs = 0;  // When boat green period started (0 = inactive)
+
+    BridgeState bridgeState = BridgeState::IDLE;
+
+    LightColour carLeft = LightColour::GREEN;
+    LightColour carRight = LightColour::GREEN;
+    LightColour boatLeft = LightColour::RED;
+    LightColour boatRight = LightColour::RED;
+    LightSide boatTimerSide = LightSide::NONE;  // Which side has green (NONE if inactive)
+
+    bool bridgeLockEngaged : 1;
+    bool manualMode : 1;
+    bool inFault : 1;
+    bool simulationMode : 1;
+    bool simUltrasonicLeftEnabled : 1;
+    bool simUltrasonicRightEnabled : 1;
+    bool simBeamBreakEnabled : 1;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Clock.h"
+
+class EventBus;
+
+/**
+ * VirtualClock - discrete-event time for host simulation and tests
+ *
+ * Time stands still until advanced. The run*() methods drive an EventBus the way the
+ * control task would, but instead of sleeping until the next deadline they jump to
+ * it: dispatch everything pending, move the clock to the earliest armed timer, fire
+ * it, repeat. Every timer fires on its exact millisecond, and nothing in between
+ * costs anything, so minutes of bridge operation run in microseconds.
+ *
+ * Install it with Clock::install() before constructing the modules under test, and
+ * drive it from one thread.
+ */
+class VirtualClock : public Clock {
+public:
+    explicit VirtualClock(uint32_t startMs = 0);
+
+    uint32_t nowMs() override;
+    uint32_t nowUs() override;
+
+    // Moves time without dispatching anything
+    void set(uint32_t ms);
+    void advance(uint32_t ms);
+
+    // Runs bus up to targetMs, stopping on every timer deadline on the way; returns the
+    // number of deadlines visited. A target in the past only drains the queue.
+    size_t runUntil(EventBus& bus, uint32_t targetMs);
+    size_t runFor(EventBus& bus, uint32_t ms) { return runUntil(bus, nowMs() + ms); }
+
+    // Jumps from deadline to deadline until no timer is armed, or limitMs have passed
+    // (periodic timers never go idle); true if the bus went idle
+    bool runUntilIdle(EventBus& bus, uint32_t limitMs);
+
+    // Dispatches until nothing is queued, including events the callbacks publish
+    static void drain(EventBus& bus);
+
+private:
+    uint64_t nowUs_;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef UNIT_TEST
+    #include <condition_variable>
+    #include <mutex>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+#endif
+
+/**
+ * WakeSignal - latched "there is work" flag a single task can sleep on
+ *
+ * notify() may be called from any task, any number of times; the next wait()
+ * returns immediately if a notify() happened since the previous wait() returned.
+ * On the target this is a statically allocated FreeRTOS binary semaphore; the host
+ * (UNIT_TEST) build uses a mutex + condition variable with the same semantics.
+ *
+ * Not for use from an ISR.
+ */
+class WakeSignal {
+public:
+    WakeSignal();
+    ~WakeSignal();
+
+    WakeSignal(const WakeSignal&) = delete;
+    WakeSignal& operator=(const WakeSignal&) = delete;
+
+    // Wakes the waiter, or makes its next wait() return at once
+    void notify();
+
+    // Blocks for up to timeoutMs (0 = just poll); true if notified, false on timeout
+    bool wait(uint32_t timeoutMs);
+
+private:
+#ifdef UNIT_TEST
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool signalled_ = false;
+#else
+    StaticSemaphore_t storage_;
+    SemaphoreHandle_t semaphore_;
+#endif
+};
@@ -3,10 +3,13 @@
 #include <AsyncUDP.h>
 #include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include <atomic>
+#include <functional>
 #include "StateWriter.h"
 #include "CommandBus.h"
 #include "EventBus.h"
 #include "DetectionSystem.h"
+#include "SnapshotCoalescer.h"
 
 class ConsoleCommands;
 
@@ -18,6 +21,16 @@ public:
     void networkLoop();
     void attachConsole(ConsoleCommands* console);
 
+    // Registers the snapshot broadcast subscriptions; must run in setup() before the EventBus is sealed
+    void beginSubscriptions();
+
+    // Snapshots go out at most once per interval (network task), covering every change since the last
+    void setBroadcastIntervalMs(uint32_t intervalMs) { snapshots_.setIntervalMs(intervalMs); }
+    SnapshotCoalescer::Stats broadcastStats() const { return snapshots_.stats(); }
+
+    // Network task: sleeps up to maxMs, less if a held snapshot falls due; a state change wakes it
+    void waitForWork(uint32_t maxMs);
+
 private:
     StateWriter& state_;
     CommandBus& commandBus_;
@@ -38,6 +51,15 @@ private:
     String ssid_;
     String password_;
 
+    // Control core marks, network task sends
+    SnapshotCoalescer snapshots_;
+    uint32_t broadcastVersion_ = 0;  // StateWriter version the clients were last brought to
+
+    // What went on air: patches, full snapshots (connects, resyncs) and their bytes
+    std::atomic<uint32_t> patchesSent_{0};
+    std::atomic<uint32_t> snapshotsSent_{0};
+    std::atomic<uint32_t> broadcastBytes_{0};
+
     String bridgeState = "Closed";
     bool lockEngaged = true;
     uint32_t bridgeLastChangeMs = 0;
@@ -55,16 +77,18 @@ private:
                    JsonVariant payload);
 
     void sendOk(AsyncWebSocketClient* client, const String& id, const String& path,
-                std::function<void(JsonObject)> fillPayload = nullptr);
+                std::function<void(JsonObject)> fillPayload = nullptr, size_t docCapacity = 512);
+    void sendOkJson(AsyncWebSocketClient* client, const String& id, const String& path, const String& payloadJson);
     
     void sendError(AsyncWebSocketClient* client, const String& id, const String& path, const String& msg);
 
-    void fillBridgeStatus(JsonObject obj);
-    void fillCarTrafficStatus(JsonObject obj);
-    void fillBoatTrafficStatus(JsonObject obj);
-    void fillSystemStatus(JsonObject obj);
+    void fillSystemMetrics(JsonObject obj);
+    void sendTraceDump(AsyncWebSocketClient* client, const String& id, const String& path);
 
-    void broadcastSnapshot();
+    void broadcastState();
+    void sendSnapshot(AsyncWebSocketClient* client);
+    AsyncWebSocketMessageBuffer* serializeToBuffer(const JsonDocument& doc);
+    void flushSnapshot();
     void setupBroadcastSubscriptions();
     void startServer();
 };
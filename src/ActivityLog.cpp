@@ -0,0 +1,62 @@
+#include "ActivityLog.h"
+
+ActivityLog::ActivityLog(size_t capacity)
+    : capacity_(capacity != 0 ? capacity : 1), entries_(new Entry[capacity != 0 ? capacity : 1]()) {}
+
+uint32_t ActivityLog::push(uint32_t version, uint32_t timestampMs, uint8_t code,
+                           uint8_t arg0, uint8_t arg1, uint8_t arg2) {
+    std::lock_guard<std::mutex> lk(mu_);
+    const uint32_t seq = nextSeq_++;
+    Entry& entry = entries_[seq % capacity_];
+    if (seq >= capacity_) {
+        droppedVersion_ = entry.version;  // The entry about to be overwritten
+    }
+    entry.seq = seq;
+    entry.version = version;
+    entry.timestampMs = timestampMs;
+    entry.code = code;
+    entry.args[0] = arg0;
+    entry.args[1] = arg1;
+    entry.args[2] = arg2;
+    return seq;
+}
+
+uint32_t ActivityLog::nextSeq() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return nextSeq_;
+}
+
+uint32_t ActivityLog::firstSeq() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return firstSeqLocked();
+}
+
+uint32_t ActivityLog::droppedVersion() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return droppedVersion_;
+}
+
+uint32_t ActivityLog::firstSeqAfterVersion(uint32_t version) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    // Versions only grow along the ring; callers mostly want the newest few lines
+    const uint32_t first = firstSeqLocked();
+    uint32_t seq = nextSeq_;
+    while (seq > first && at(seq - 1).version > version) {
+        --seq;
+    }
+    return seq;
+}
+
+size_t ActivityLog::read(uint32_t fromSeq, Entry* out, size_t max) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    const uint32_t first = firstSeqLocked();
+    size_t count = 0;
+    for (uint32_t seq = fromSeq < first ? first : fromSeq; seq < nextSeq_ && count < max; ++seq) {
+        out[count++] = at(seq);
+    }
+    return count;
+}
+
+uint32_t ActivityLog::firstSeqLocked() const {
+    return nextSeq_ > capacity_ ? nextSeq_ - static_cast<uint32_t>(capacity_) : 0;
+}
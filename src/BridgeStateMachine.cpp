@@ -1,5 +1,6 @@
 #include "BridgeStateMachine.h"
 #include <Arduino.h>
+#include "Clock.h"
 #include "Logger.h"
 
 /*
@@ -155,7 +156,7 @@ void BridgeStateMachine::handleEvent(const BridgeEvent& event) {
                 changeState(BridgeState::OPEN);
                 
                 // Record entry time for emergency timeout
-                openingStateEntryTime_ = millis();
+                startPassageTimer();
                 
                 if (activeBoatSide_ == BoatSide::UNKNOWN) {
                     if (hasPendingBoatRequests()) {
@@ -340,7 +341,7 @@ void BridgeStateMachine::handleBoatDetection(BoatSide side) {
     } else if (!canStartNewCycle()) {
         unsigned long remaining = BOAT_CYCLE_COOLDOWN_MS;
         if (cooldownActive_) {
-            unsigned long elapsed = millis() - cooldownStartTime_;
+            unsigned long elapsed = Clock::millis() - cooldownStartTime_;
             if (elapsed < BOAT_CYCLE_COOLDOWN_MS) {
                 remaining = BOAT_CYCLE_COOLDOWN_MS - elapsed;
             } else {
@@ -397,7 +398,7 @@ void BridgeStateMachine::startActiveBoatWindow(BoatSide side) {
 
     String sideStr = boatSideToString(side);
     greenWindowActive_ = true;
-    openingStateEntryTime_ = millis();
+    startPassageTimer();
     boatPassedInWindow_ = false;
     issueCommand(CommandTarget::SIGNAL_CONTROL, CommandAction::START_BOAT_GREEN_PERIOD, sideStr);
 
@@ -416,8 +417,7 @@ void BridgeStateMachine::endActiveBoatWindow(const char* reason) {
     if (!boatPassedInWindow_) {
         LOG_ERROR(Logger::TAG_FSM, "Boat window expired without BOAT_PASSED confirmation (%s) - triggering fault",
                   sideName(finishingSide));
-        auto* timeoutData = new SimpleEventData(BridgeEvent::BOAT_PASSAGE_TIMEOUT);
-        m_eventBus.publish(BridgeEvent::BOAT_PASSAGE_TIMEOUT, timeoutData, EventPriority::EMERGENCY);
+        m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::BOAT_PASSAGE_TIMEOUT);
         return;
     }
 
@@ -425,7 +425,7 @@ void BridgeStateMachine::endActiveBoatWindow(const char* reason) {
 
     issueCommand(CommandTarget::SIGNAL_CONTROL, CommandAction::END_BOAT_GREEN_PERIOD);
     greenWindowActive_ = false;
-    openingStateEntryTime_ = 0;
+    stopPassageTimer();
 
     sidesServedThisOpening_++;
     activeBoatSide_ = BoatSide::UNKNOWN;
@@ -460,13 +460,15 @@ bool BridgeStateMachine::cooldownElapsed() const {
     if (!cooldownActive_) {
         return true;
     }
-    unsigned long elapsed = millis() - cooldownStartTime_;
+    unsigned long elapsed = Clock::millis() - cooldownStartTime_;
     return elapsed >= BOAT_CYCLE_COOLDOWN_MS;
 }
 
 void BridgeStateMachine::startCooldown() {
     cooldownActive_ = true;
-    cooldownStartTime_ = millis();
+    cooldownStartTime_ = Clock::millis();
+    m_eventBus.cancelTimer(cooldownTimer_);
+    cooldownTimer_ = m_eventBus.callAfter(BOAT_CYCLE_COOLDOWN_MS, [this]() { onCooldownElapsed(); });
     LOG_INFO(Logger::TAG_FSM, "Bridge cooldown started (45s buffer before next cycle)");
 }
 
@@ -476,6 +478,42 @@ void BridgeStateMachine::resetCooldown() {
     }
     cooldownActive_ = false;
     cooldownStartTime_ = 0;
+    m_eventBus.cancelTimer(cooldownTimer_);
+    cooldownTimer_ = INVALID_TIMER_ID;
+}
+
+void BridgeStateMachine::onCooldownElapsed() {
+    cooldownTimer_ = INVALID_TIMER_ID;
+    LOG_INFO(Logger::TAG_FSM, "Bridge cooldown elapsed - ready for next cycle");
+    resetCooldown();
+    if (m_currentState == BridgeState::IDLE) {
+        maybeStartPendingCycle();
+    }
+}
+
+void BridgeStateMachine::startPassageTimer() {
+    openingStateEntryTime_ = Clock::millis();
+    m_eventBus.cancelTimer(passageTimer_);
+    passageTimer_ = m_eventBus.callAfter(BOAT_PASSAGE_TIMEOUT_MS, [this]() { onPassageTimeout(); });
+}
+
+void BridgeStateMachine::stopPassageTimer() {
+    openingStateEntryTime_ = 0;
+    m_eventBus.cancelTimer(passageTimer_);
+    passageTimer_ = INVALID_TIMER_ID;
+}
+
+void BridgeStateMachine::onPassageTimeout() {
+    passageTimer_ = INVALID_TIMER_ID;
+
+    // Emergency timeout in OPENING state
+    if (m_currentState == BridgeState::OPENING && openingStateEntryTime_ > 0) {
+        unsigned long elapsed = Clock::millis() - openingStateEntryTime_;
+        LOG_ERROR(Logger::TAG_FSM, "Emergency timeout in OPENING state (%lu ms) - boat didn't pass", elapsed);
+        
+        // Publish timeout event (will trigger FAULT via global handler)
+        m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::BOAT_PASSAGE_TIMEOUT);
+    }
 }
 
 String BridgeStateMachine::boatSideToString(BoatSide side) {
@@ -551,7 +589,7 @@ void BridgeStateMachine::resetBoatCycleState(bool clearQueue) {
     greenWindowActive_ = false;
     boatPassedInWindow_ = false;
     sidesServedThisOpening_ = 0;
-    openingStateEntryTime_ = 0;
+    stopPassageTimer();
     pendingLowerRequest_ = PendingLowerRequest::NONE;
     beamBreakActive_ = false;
     if (clearQueue) {
@@ -559,6 +597,8 @@ void BridgeStateMachine::resetBoatCycleState(bool clearQueue) {
     }
     cooldownActive_ = false;
     cooldownStartTime_ = 0;
+    m_eventBus.cancelTimer(cooldownTimer_);
+    cooldownTimer_ = INVALID_TIMER_ID;
 }
 
 void BridgeStateMachine::performSystemReset() {
@@ -569,8 +609,7 @@ void BridgeStateMachine::performSystemReset() {
     if (m_currentState != BridgeState::IDLE) {
         changeState(BridgeState::IDLE);
     } else {
-        auto* stateChangeData = new StateChangeData(BridgeState::IDLE, m_previousState);
-        m_eventBus.publish(BridgeEvent::STATE_CHANGED, stateChangeData);
+        m_eventBus.emplace<StateChangeData>(BridgeState::IDLE, m_previousState);
     }
 
     issueCommand(CommandTarget::CONTROLLER, CommandAction::RESET_TO_IDLE_STATE);
@@ -579,14 +618,13 @@ void BridgeStateMachine::performSystemReset() {
 void BridgeStateMachine::changeState(BridgeState newState) {
     m_previousState = m_currentState;
     m_currentState = newState;
-    m_stateEntryTime = millis();
+    m_stateEntryTime = Clock::millis();
     
     LOG_INFO(Logger::TAG_FSM, "State changed from %s to %s",
              stateName(m_previousState), stateName(m_currentState));
     
     // Publish state change event for monitoring systems
-    auto* stateChangeData = new StateChangeData(m_currentState, m_previousState);
-    m_eventBus.publish(BridgeEvent::STATE_CHANGED, stateChangeData);
+    m_eventBus.emplace<StateChangeData>(m_currentState, m_previousState);
 
     if (m_currentState == BridgeState::IDLE && !boatCycleActive_) {
         maybeStartPendingCycle();
@@ -659,70 +697,41 @@ const char* BridgeStateMachine::stateName(BridgeState s) {
 
 // Unsure if this implementation is sound but i will delve into it further as the Bus's are developed.
 void BridgeStateMachine::subscribeToEvents() {
+    using E = BridgeEvent;
+
     // Subscribe to all events that the state machine needs to handle
-    auto eventCallback = [this](EventData* eventData) {
+    // One mask subscription per priority; the payload already carries the event type
+    auto eventCallback = [this](BridgeEvent, EventData* eventData) {
         this->onEventReceived(eventData);
     };
 
-    // Subscribe to external events
-    m_eventBus.subscribe(BridgeEvent::BOAT_DETECTED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_DETECTED_RIGHT, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_PASSED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_PASSED_LEFT, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_PASSED_RIGHT, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BEAM_BREAK_ACTIVE, eventCallback, EventPriority::EMERGENCY);
-    m_eventBus.subscribe(BridgeEvent::BEAM_BREAK_CLEAR, eventCallback, EventPriority::EMERGENCY);
-    
-    // Subscribe to boat queue events
-    m_eventBus.subscribe(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BOAT_PASSAGE_TIMEOUT, eventCallback, EventPriority::EMERGENCY);
-    
-    // Subscribe to manual control events (Command Mode)
-    m_eventBus.subscribe(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::MANUAL_TRAFFIC_STOP_REQUESTED, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::MANUAL_TRAFFIC_RESUME_REQUESTED, eventCallback, EventPriority::NORMAL);
-    
-    // Subscribe to success events from subsystems
-    m_eventBus.subscribe(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BRIDGE_OPENED_SUCCESS, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::BRIDGE_CLOSED_SUCCESS, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::TRAFFIC_RESUMED_SUCCESS, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::INDICATOR_UPDATE_SUCCESS, eventCallback, EventPriority::NORMAL);
-    m_eventBus.subscribe(BridgeEvent::SYSTEM_SAFE_SUCCESS, eventCallback, EventPriority::NORMAL);
-    
-    // Subscribe to safety and manual override events (high priority)
-    m_eventBus.subscribe(BridgeEvent::FAULT_DETECTED, eventCallback, EventPriority::EMERGENCY);
-    m_eventBus.subscribe(BridgeEvent::FAULT_CLEARED, eventCallback, EventPriority::EMERGENCY);
-    m_eventBus.subscribe(BridgeEvent::MANUAL_OVERRIDE_ACTIVATED, eventCallback, EventPriority::EMERGENCY);
-    m_eventBus.subscribe(BridgeEvent::MANUAL_OVERRIDE_DEACTIVATED, eventCallback, EventPriority::EMERGENCY);
-    m_eventBus.subscribe(BridgeEvent::SYSTEM_RESET_REQUESTED, eventCallback, EventPriority::EMERGENCY);
-    
-    LOG_INFO(Logger::TAG_FSM, "Subscribed to all relevant events on EventBus");
-}
+    const EventMask normalEvents{
+        // External events
+        E::BOAT_DETECTED, E::BOAT_DETECTED_LEFT, E::BOAT_DETECTED_RIGHT,
+        E::BOAT_PASSED, E::BOAT_PASSED_LEFT, E::BOAT_PASSED_RIGHT,
+        // Boat queue events
+        E::BOAT_GREEN_PERIOD_EXPIRED,
+        // Manual control events (Command Mode)
+        E::MANUAL_BRIDGE_OPEN_REQUESTED, E::MANUAL_BRIDGE_CLOSE_REQUESTED,
+        E::MANUAL_TRAFFIC_STOP_REQUESTED, E::MANUAL_TRAFFIC_RESUME_REQUESTED,
+        // Success events from subsystems
+        E::TRAFFIC_STOPPED_SUCCESS, E::BRIDGE_OPENED_SUCCESS, E::BRIDGE_CLOSED_SUCCESS,
+        E::TRAFFIC_RESUMED_SUCCESS, E::INDICATOR_UPDATE_SUCCESS, E::SYSTEM_SAFE_SUCCESS
+    };
 
-void BridgeStateMachine::checkTimeouts() {
-    // Check for emergency timeout in OPENING state
-    if (m_currentState == BridgeState::OPENING && openingStateEntryTime_ > 0) {
-        unsigned long elapsed = millis() - openingStateEntryTime_;
-        
-        if (elapsed >= BOAT_PASSAGE_TIMEOUT_MS) {
-            LOG_ERROR(Logger::TAG_FSM, "Emergency timeout in OPENING state (%lu ms) - boat didn't pass", elapsed);
-            
-            // Publish timeout event (will trigger FAULT via global handler)
-            auto* timeoutData = new SimpleEventData(BridgeEvent::BOAT_PASSAGE_TIMEOUT);
-            m_eventBus.publish(BridgeEvent::BOAT_PASSAGE_TIMEOUT, timeoutData, EventPriority::EMERGENCY);
-        }
-    }
+    // Safety, beam break and manual override events (high priority)
+    const EventMask emergencyEvents{
+        E::BEAM_BREAK_ACTIVE, E::BEAM_BREAK_CLEAR, E::BOAT_PASSAGE_TIMEOUT,
+        E::FAULT_DETECTED, E::FAULT_CLEARED,
+        E::MANUAL_OVERRIDE_ACTIVATED, E::MANUAL_OVERRIDE_DEACTIVATED,
+        E::SYSTEM_RESET_REQUESTED
+    };
 
-    if (cooldownActive_ && cooldownElapsed()) {
-        LOG_INFO(Logger::TAG_FSM, "Bridge cooldown elapsed - ready for next cycle");
-        resetCooldown();
-        if (m_currentState == BridgeState::IDLE) {
-            maybeStartPendingCycle();
-        }
-    }
+    EventBus::SubscriberLabel label(m_eventBus, "BridgeStateMachine");
+    m_eventBus.subscribe(normalEvents, eventCallback, EventPriority::NORMAL);
+    m_eventBus.subscribe(emergencyEvents, eventCallback, EventPriority::EMERGENCY);
+    
+    LOG_INFO(Logger::TAG_FSM, "Subscribed to all relevant events on EventBus");
 }
 
 void BridgeStateMachine::onEventReceived(EventData* eventData) {
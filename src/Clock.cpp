@@ -0,0 +1,44 @@
+#include "Clock.h"
+
+#ifdef UNIT_TEST
+    #include <chrono>
+extern unsigned long mock_millis;
+#else
+    #include <Arduino.h>
+#endif
+
+namespace {
+// Constant-initialised, so modules may read the clock from global constructors
+SystemClock systemClock;
+}  // namespace
+
+Clock* Clock::active_ = &systemClock;
+
+Clock* Clock::install(Clock* clock) {
+    Clock* previous = active_;
+    active_ = clock ? clock : &systemClock;
+    return previous;
+}
+
+#ifdef UNIT_TEST
+
+uint32_t SystemClock::nowMs() {
+    return static_cast<uint32_t>(mock_millis);
+}
+
+uint32_t SystemClock::nowUs() {
+    const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+#else
+
+uint32_t SystemClock::nowMs() {
+    return static_cast<uint32_t>(::millis());
+}
+
+uint32_t SystemClock::nowUs() {
+    return static_cast<uint32_t>(::micros());
+}
+
+#endif
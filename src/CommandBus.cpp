@@ -1,4 +1,6 @@
 #include "CommandBus.h"
+#include <algorithm>
+#include "Logger.h"
 
 // Global instance
 CommandBus commandBus;
@@ -14,60 +16,127 @@ CommandBus::~CommandBus() {
 
     // There's no specific resource to release, so this is just a safety step.
     // If subscribers need explicit cleanup, you can iterate and call delete for each one.
-    subscribers.clear();  // Clear all subscriptions (if required)
+    for (auto& list : subscribers) {
+        list.clear();  // Clear all subscriptions (if required)
+    }
 }
 
 void CommandBus::publish(const Command& command) {
-    // Lock the subscribers map for thread safety
-    std::lock_guard<std::mutex> lock(bus_mutex);
+    const size_t index = static_cast<size_t>(command.target);
+    if (index >= COMMAND_TARGET_COUNT) {
+        return;
+    }
 
-    // Find subscribers for the command's target
-    auto it = subscribers.find(command.target);
-    if (it != subscribers.end()) {
-        // Only log for motor control commands (most important)
-        if (command.target == CommandTarget::MOTOR_CONTROL) {
-            Serial.printf("COMMAND: Motor.%s\n", 
-                (command.action == CommandAction::RAISE_BRIDGE) ? "raise()" : 
-                (command.action == CommandAction::LOWER_BRIDGE) ? "lower()" : "halt()");
-        }
-        
-        // Make a local copy of callbacks to minimize lock duration
-        auto callbacks = it->second;
-        // Call each subscriber's callback with the command
-        for (const auto& callback : callbacks) {
-            if (callback) {
-                callback(command);
+    // Only log for motor control commands (most important)
+    if (command.target == CommandTarget::MOTOR_CONTROL && !subscribers[index].empty()) {
+        Serial.printf("COMMAND: Motor.%s\n", 
+            (command.action == CommandAction::RAISE_BRIDGE) ? "raise()" : 
+            (command.action == CommandAction::LOWER_BRIDGE) ? "lower()" : "halt()");
+    }
+
+    if (isSealed()) {
+        // Table is frozen - dispatch straight from it, no lock and no copy
+        for (const auto& subscription : subscribers[index]) {
+            if (subscription.callback) {
+                subscription.callback(command);
             }
         }
+        return;
+    }
+
+    // Before seal(): take a local copy under the lock so callbacks run unlocked
+    std::vector<Subscription> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(bus_mutex);
+        callbacks = subscribers[index];
+    }
+    // Call each subscriber's callback with the command
+    for (const auto& subscription : callbacks) {
+        if (subscription.callback) {
+            subscription.callback(command);
+        }
     }
 }
 
-void CommandBus::subscribe(CommandTarget target, std::function<void(const Command&)> callback) {
-    // Lock the subscribers map for thread safety
+SubscriptionId CommandBus::subscribe(CommandTarget target, CommandCallback callback) {
+    // Lock the subscribers table for thread safety
     std::lock_guard<std::mutex> lock(bus_mutex);
 
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_CMD, "subscribe(target=%d) rejected - CommandBus is sealed",
+                  static_cast<int>(target));
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
     // Add the callback to the list of subscribers for the target
-    subscribers[target].push_back(callback);
+    const SubscriptionId id = nextSubscriptionId++;
+    subscribers[static_cast<size_t>(target)].push_back(Subscription{std::move(callback), id});
+    return id;
+}
+
+bool CommandBus::unsubscribe(SubscriptionId id) {
+    std::lock_guard<std::mutex> lock(bus_mutex);
+
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_CMD, "unsubscribe(id=%u) rejected - CommandBus is sealed",
+                  static_cast<unsigned int>(id));
+        return false;
+    }
+
+    for (auto& list : subscribers) {
+        auto it = std::find_if(list.begin(), list.end(), [id](const Subscription& s) {
+            return s.id == id;
+        });
+        if (it != list.end()) {
+            list.erase(it);
+            return true;
+        }
+    }
+    return false;
 }
 
 void CommandBus::unsubscribe(CommandTarget target) {
-    // Lock the subscribers map for thread safety
+    // Lock the subscribers table for thread safety
     std::lock_guard<std::mutex> lock(bus_mutex);
 
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_CMD, "unsubscribe(target=%d) rejected - CommandBus is sealed",
+                  static_cast<int>(target));
+        return;
+    }
+
     // Remove all subscriptions for the target
-    subscribers.erase(target);
+    subscribers[static_cast<size_t>(target)].clear();
 }
 
 bool CommandBus::hasSubscribers(CommandTarget target) const {
-   std::lock_guard<std::mutex> lock(bus_mutex);
+    std::unique_lock<std::mutex> lock(bus_mutex, std::defer_lock);
+    if (!isSealed()) {
+        lock.lock();
+    }
 
-    auto it = subscribers.find(target);
-    return (it != subscribers.end() && !it->second.empty());
+    const size_t index = static_cast<size_t>(target);
+    return index < COMMAND_TARGET_COUNT && !subscribers[index].empty();
 }
 
 void CommandBus::clear() {
-   std::lock_guard<std::mutex> lock(bus_mutex);
+    std::lock_guard<std::mutex> lock(bus_mutex);
 
     // Remove all subscriptions from all targets
-    subscribers.clear();
-}
\ No newline at end of file
+    for (auto& list : subscribers) {
+        list.clear();
+    }
+    sealed.store(false, std::memory_order_release);
+}
+
+void CommandBus::seal() {
+    std::lock_guard<std::mutex> lock(bus_mutex);
+
+    size_t total = 0;
+    for (auto& list : subscribers) {
+        list.shrink_to_fit();  // Table is final - release spare capacity
+        total += list.size();
+    }
+    sealed.store(true, std::memory_order_release);
+    LOG_INFO(Logger::TAG_CMD, "CommandBus sealed with %u subscriptions", static_cast<unsigned int>(total));
+}
@@ -4,7 +4,34 @@
 #include "EventBus.h"
 #include "SignalControl.h"
 #include "BridgeSystemDefs.h"
+#include "Clock.h"
 #include "Logger.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+namespace {
+  // Dump bytes per console line: a multiple of 3 so every line decodes on its own, and
+  // short enough (64 chars + newline) to fit the UART's FIFO in one go
+  constexpr size_t TRACE_LINE_BYTES = 48;
+  constexpr int TRACE_LINE_CHARS = TRACE_LINE_BYTES / 3 * 4 + 1;
+
+  // Serial-safe text form of a trace dump piece (pieces are always a multiple of 3 bytes)
+  void printBase64Line(const uint8_t* data, size_t len)
+  {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char quad[5] = {0, 0, 0, 0, 0};
+    for (size_t i = 0; i + 2 < len; i += 3)
+    {
+      const uint32_t bits = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+      quad[0] = ALPHABET[(bits >> 18) & 0x3F];
+      quad[1] = ALPHABET[(bits >> 12) & 0x3F];
+      quad[2] = ALPHABET[(bits >> 6) & 0x3F];
+      quad[3] = ALPHABET[bits & 0x3F];
+      Serial.print(quad);
+    }
+    Serial.println();
+  }
+}
 
 ConsoleCommands::ConsoleCommands(MotorControl &motor, DetectionSystem &detect, EventBus& eventBus, SignalControl& signalControl)
     : motor_(motor), detect_(detect), eventBus_(eventBus), signalControl_(signalControl) {}
@@ -17,6 +44,7 @@ void ConsoleCommands::begin()
 void ConsoleCommands::poll()
 {
   handleStreaming();
+  pumpTraceDump();
 
   if (!Serial.available())
       return;
@@ -45,6 +73,8 @@ bool ConsoleCommands::executeCommand(const String& raw)
   return handleCommand(lower);
 }
 
+// Commands arrive from the serial console (control core) and from WebSocket
+// clients (network core), so events go through the lock-free cross-core path
 bool ConsoleCommands::handleCommand(const String& cmd) {
   // Global simulation toggles
   if (cmd == "sim on" || cmd == "simulation on")
@@ -53,8 +83,7 @@ bool ConsoleCommands::handleCommand(const String& cmd) {
     detect_.setSimulationMode(true);
     motor_.setSimulationMode(true);
     LOG_INFO(Logger::TAG_CON, "SIMULATION MODE ENABLED (sensors + motor control)");
-    auto* simOn = new SimpleEventData(BridgeEvent::SIMULATION_ENABLED);
-    eventBus_.publish(BridgeEvent::SIMULATION_ENABLED, simOn, EventPriority::NORMAL);
+    eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::SIMULATION_ENABLED);
     return true;
   }
   if (cmd == "sim off" || cmd == "simulation off")
@@ -62,10 +91,8 @@ bool ConsoleCommands::handleCommand(const String& cmd) {
     detect_.setSimulationMode(false);
     motor_.setSimulationMode(false);
     LOG_INFO(Logger::TAG_CON, "SIMULATION MODE DISABLED (sensors + motor control)");
-    auto* simOff = new SimpleEventData(BridgeEvent::SIMULATION_DISABLED);
-    eventBus_.publish(BridgeEvent::SIMULATION_DISABLED, simOff, EventPriority::NORMAL);
-    auto* resetData = new SimpleEventData(BridgeEvent::SYSTEM_RESET_REQUESTED);
-    eventBus_.publish(BridgeEvent::SYSTEM_RESET_REQUESTED, resetData, EventPriority::EMERGENCY);
+    eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::SIMULATION_DISABLED);
+    eventBus_.emplaceRemote<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::SYSTEM_RESET_REQUESTED);
     LOG_INFO(Logger::TAG_CON, "System reset requested after exiting simulation mode");
     return true;
   }
@@ -73,14 +100,12 @@ bool ConsoleCommands::handleCommand(const String& cmd) {
   // Motor commands (mirroring existing strings)
   // These commands trigger manual mode via the state machine
   if (cmd == "raise" || cmd == "r") {
-    auto* eventData = new SimpleEventData(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED);
-    eventBus_.publish(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED, eventData);
+    eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED);
     LOG_INFO(Logger::TAG_CON, "Console: Manual bridge open requested");
     return true;
   }
   if (cmd == "lower" || cmd == "l") {
-    auto* eventData = new SimpleEventData(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED);
-    eventBus_.publish(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED, eventData);
+    eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED);
     LOG_INFO(Logger::TAG_CON, "Console: Manual bridge close requested");
     return true;
   }
@@ -89,22 +114,19 @@ bool ConsoleCommands::handleCommand(const String& cmd) {
 
   // Test boat event commands
   if (cmd == "test boat left" || cmd == "tbl") {
-    auto* eventData = new BoatEventData(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
-    eventBus_.publish(BridgeEvent::BOAT_DETECTED_LEFT, eventData);
+    eventBus_.emplaceRemote<BoatEventData>(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
     LOG_INFO(Logger::TAG_CON, "TEST: Simulated boat detected from LEFT side");
     return true;
   }
   if (cmd == "test boat right" || cmd == "tbr") {
-    auto* eventData = new BoatEventData(BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT);
-    eventBus_.publish(BridgeEvent::BOAT_DETECTED_RIGHT, eventData);
+    eventBus_.emplaceRemote<BoatEventData>(BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT);
     LOG_INFO(Logger::TAG_CON, "TEST: Simulated boat detected from RIGHT side");
     return true;
   }
   if (cmd == "test boat pass" || cmd == "tbp") {
     // Trigger generic boat passed event (direction-agnostic)
     // In real operation, beam break sensor determines direction automatically
-    auto* eventData = new BoatEventData(BridgeEvent::BOAT_PASSED, BoatEventSide::LEFT);
-    eventBus_.publish(BridgeEvent::BOAT_PASSED, eventData);
+    eventBus_.emplaceRemote<BoatEventData>(BridgeEvent::BOAT_PASSED, BoatEventSide::LEFT);
     LOG_INFO(Logger::TAG_CON, "TEST: Simulated boat cleared channel (beam break)");
     return true;
   }
@@ -229,7 +251,15 @@ bool ConsoleCommands::handleCommand(const String& cmd) {
     return matched;
   }
 
+  if (cmd == "trace" || cmd.startsWith("trace ")) { return handleTraceCommand(cmd); }
+
   if (cmd == "status" || cmd == "mode") { printStatus(); return true; }
+  if (cmd == "metrics") { printMetrics(); return true; }
+  if (cmd == "metrics reset") {
+    eventBus_.resetMetrics();
+    LOG_INFO(Logger::TAG_EVT, "Event latency metrics reset");
+    return true;
+  }
   if (cmd == "help" || cmd == "?") { printHelp(); return true; }
 
   LOG_WARN(Logger::TAG_CON, "Unknown command. Type 'help' for available commands.");
@@ -255,6 +285,8 @@ void ConsoleCommands::printHelp()
   Serial.println("  lights status|ls          - Show light control status");
   Serial.println("  log level <lvl>           - Set log level (debug/info/warn/error/none)");
   Serial.println("  status|mode               - Show combined status");
+  Serial.println("  trace [on|off|clear|dump]  - Event trace recorder; dump prints base64 for tools/trace_decode.py");
+  Serial.println("  metrics [reset]           - Show (or clear) event latency and slowest subscribers");
   Serial.println("  help|?                    - Show this help");
 }
 
@@ -276,6 +308,14 @@ void ConsoleCommands::printStatus()
            (rightDist > 0 ? String(rightDist, 1).c_str() : "unknown"),
            detect_.getRightZoneName());
 
+  const EventLoopStats loop = eventBus_.getLoopStats();
+  LOG_INFO(Logger::TAG_EVT, "EVENT LOOP: idle %.1f%%, wakeups %u by publish / %u by deadline, wake-to-dispatch avg %uus max %uus",
+           loop.idlePercent,
+           static_cast<unsigned int>(loop.notifiedWakeups),
+           static_cast<unsigned int>(loop.timeoutWakeups),
+           static_cast<unsigned int>(loop.wakeLatencyAvgUs),
+           static_cast<unsigned int>(loop.wakeLatencyMaxUs));
+
   if (detect_.isSimulationMode())
   {
     auto simConfig = detect_.getSimulationSensorConfig();
@@ -286,9 +326,117 @@ void ConsoleCommands::printStatus()
   }
 }
 
+void ConsoleCommands::printMetrics()
+{
+  // Per event: publish -> dispatch start, and the time all its subscribers took
+  for (size_t i = 0; i < BRIDGE_EVENT_COUNT; ++i)
+  {
+    const BridgeEvent event = static_cast<BridgeEvent>(i);
+    const LatencyHistogram::Summary wait = eventBus_.queueWaitHistogram(event).summary();
+    if (wait.count == 0) continue;
+    const LatencyHistogram::Summary dispatch = eventBus_.dispatchHistogram(event).summary();
+    LOG_INFO(Logger::TAG_EVT, "%-32s n=%-6u wait p50<=%uus p99<=%uus max %uus | dispatch p50<=%uus p99<=%uus max %uus",
+             bridgeEventToString(event), static_cast<unsigned int>(wait.count),
+             static_cast<unsigned int>(wait.p50Us), static_cast<unsigned int>(wait.p99Us),
+             static_cast<unsigned int>(wait.maxUs),
+             static_cast<unsigned int>(dispatch.p50Us), static_cast<unsigned int>(dispatch.p99Us),
+             static_cast<unsigned int>(dispatch.maxUs));
+  }
+
+  // Slowest callbacks first - these are the ones stalling the control core
+  constexpr size_t MAX_SUBSCRIBERS = 32;
+  constexpr size_t SHOWN = 5;
+  SubscriberTiming timings[MAX_SUBSCRIBERS];
+  const size_t count = eventBus_.getSubscriberTimings(timings, MAX_SUBSCRIBERS);
+  std::sort(timings, timings + count, [](const SubscriberTiming& a, const SubscriberTiming& b) {
+    return a.maxUs > b.maxUs;
+  });
+  for (size_t i = 0; i < count && i < SHOWN; ++i)
+  {
+    const SubscriberTiming& t = timings[i];
+    LOG_INFO(Logger::TAG_EVT, "SUBSCRIBER #%u %s (%s): calls=%u avg %uus max %uus",
+             static_cast<unsigned int>(t.id), t.label ? t.label : "unlabelled",
+             t.mask ? "mask" : bridgeEventToString(t.event),
+             static_cast<unsigned int>(t.calls),
+             static_cast<unsigned int>(t.calls ? t.totalUs / t.calls : 0),
+             static_cast<unsigned int>(t.maxUs));
+  }
+}
+
+bool ConsoleCommands::handleTraceCommand(const String& cmd)
+{
+  TraceRecorder* trace = eventBus_.traceRecorder();
+  if (!trace)
+  {
+    LOG_WARN(Logger::TAG_EVT, "No trace recorder attached to the EventBus");
+    return false;
+  }
+
+  if (traceDumping_.load(std::memory_order_acquire))
+  {
+    LOG_WARN(Logger::TAG_CON, "Trace dump in progress");
+    return false;
+  }
+
+  if (cmd == "trace on" || cmd == "trace off")
+  {
+    trace->setEnabled(cmd == "trace on");
+  }
+  else if (cmd == "trace clear")
+  {
+    trace->clear();
+  }
+  else if (cmd == "trace dump")
+  {
+    // ~65 KB of text, several seconds at 115200 baud: poll() sends it a line at a time
+    if (!trace->beginDump(traceDump_))
+    {
+      LOG_WARN(Logger::TAG_EVT, "Trace dump already in progress");
+      return false;
+    }
+    Serial.println("TRACE BEGIN");
+    traceDumping_.store(true, std::memory_order_release);
+    return true;
+  }
+  else if (cmd != "trace")
+  {
+    LOG_WARN(Logger::TAG_CON, "Usage: trace [on|off|clear|dump]");
+    return false;
+  }
+
+  LOG_INFO(Logger::TAG_EVT, "TRACE: %s, %u/%u records held, %u recorded",
+           trace->isEnabled() ? "recording" : "paused",
+           static_cast<unsigned int>(trace->size()),
+           static_cast<unsigned int>(TraceRecorder::CAPACITY),
+           static_cast<unsigned int>(trace->totalRecorded()));
+  return true;
+}
+
+void ConsoleCommands::pumpTraceDump()
+{
+  if (!traceDumping_.load(std::memory_order_acquire))
+    return;
+  if (Serial.availableForWrite() < TRACE_LINE_CHARS)
+    return;
+
+  TraceRecorder* trace = eventBus_.traceRecorder();
+  uint8_t line[TRACE_LINE_BYTES];
+  const size_t len = trace->readDump(traceDump_, line, sizeof(line));
+  if (len > 0)
+  {
+    printBase64Line(line, len);
+    return;
+  }
+
+  trace->endDump(traceDump_);
+  traceDumping_.store(false, std::memory_order_release);
+  Serial.println("TRACE END");
+  LOG_INFO(Logger::TAG_EVT, "Trace dumped: %u records", static_cast<unsigned int>(traceDump_.records));
+}
+
 void ConsoleCommands::handleStreaming()
 {
-  const unsigned long now = millis();
+  const unsigned long now = Clock::millis();
   bool any = (streamMask_ != 0) || limitStreamEnabled_;
   if (!any) return;
   if (now - lastStreamMs_ < streamIntervalMs_) return;
@@ -103,8 +103,7 @@ void Controller::handleCommand(const Command& command) {
                 m_localStateIndicator.halt();
                 
                 LOG_WARN(Logger::TAG_CMD, "All subsystems halted - system in safe state");
-                auto* safeData = new SimpleEventData(BridgeEvent::SYSTEM_SAFE_SUCCESS);
-                m_eventBus.publish(BridgeEvent::SYSTEM_SAFE_SUCCESS, safeData);
+                m_eventBus.emplace<SimpleEventData>(BridgeEvent::SYSTEM_SAFE_SUCCESS);
             } else if (command.action == CommandAction::RESET_TO_IDLE_STATE) {
                 LOG_WARN(Logger::TAG_CMD, "RESET_TO_IDLE_STATE command received - restoring default operation");
                 resetToIdleState();
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 
 #include "DetectionSystem.h"
+#include "Clock.h"
 #include "Logger.h"
 
 // ------------------- Configuration -------------------
@@ -24,12 +25,8 @@ static const int RIGHT_ECHO_PIN = 26;
 // Distance thresholds in centimeters (short-range)
 static const float FAR_CM = 30.0f;   // 30 cm
 static const float NEAR_CM = 20.0f;  // 20 cm
-static const float CLOSE_CM = 10.0f; // 10 cm
-// Event threshold (critical distance) for BOAT_DETECTED/BOAT_PASSED
-static const float DETECT_THRESHOLD_CM = CLOSE_CM;
-// Timing
-static const unsigned long SAMPLE_INTERVAL_MS = 100; // 10 Hz
-static const unsigned long DETECT_HOLD_MS = 800;     // must stay within detect range to trigger
+static const float CLOSE_CM = DetectionSystem::DETECT_THRESHOLD_CM; // 10 cm
+// Event threshold and timing: see DetectionSystem.h
 
 // Filtering
 static const float EMA_ALPHA = 0.5f; // 0..1, higher = less smoothing
@@ -88,7 +85,7 @@ void DetectionSystem::begin()
 // Periodic update method
 void DetectionSystem::update()
 {
-    const unsigned long now = millis();
+    const unsigned long now = Clock::millis();
     if (now - lastSampleMs < SAMPLE_INTERVAL_MS)
         return;
     lastSampleMs = now;
@@ -97,6 +94,12 @@ void DetectionSystem::update()
     const float leftRawDist = readDistanceCm(LEFT_TRIG_PIN, LEFT_ECHO_PIN);
     const float rightRawDist = readDistanceCm(RIGHT_TRIG_PIN, RIGHT_ECHO_PIN);
 
+    processSample(leftRawDist, rightRawDist);
+}
+
+// One sample from raw readings: filter, classify, then detect / track passage
+void DetectionSystem::processSample(float leftRawDist, float rightRawDist)
+{
     // Update filtered values
     updateFilteredDistances(leftRawDist, rightRawDist);
 
@@ -128,6 +131,13 @@ float DetectionSystem::readDistanceCm(int trigPin, int echoPin)
     return (float)duration / 58.0f;
 }
 
+// Time left until update() takes its next sample, so the control loop can sleep until then
+unsigned long DetectionSystem::msUntilNextSample() const
+{
+    const unsigned long elapsed = Clock::millis() - lastSampleMs;
+    return (elapsed >= SAMPLE_INTERVAL_MS) ? 0 : SAMPLE_INTERVAL_MS - elapsed;
+}
+
 // Update the filtered distance values using exponential moving average
 void DetectionSystem::updateFilteredDistances(float leftRawDist, float rightRawDist)
 {
@@ -230,7 +240,7 @@ bool DetectionSystem::inCriticalRange(float cm) const
 // Look for initial boat detection from either sensor
 void DetectionSystem::checkInitialDetection()
 {
-    const unsigned long now = millis();
+    const unsigned long now = Clock::millis();
 
     auto handleDetection = [&](const char* sensorName,
                                BoatDirection direction,
@@ -244,11 +254,9 @@ void DetectionSystem::checkInitialDetection()
                      (direction == BoatDirection::LEFT_TO_RIGHT) ? "LEFT" : "RIGHT",
                      (direction == BoatDirection::LEFT_TO_RIGHT) ? "RIGHT" : "LEFT");
 
-            auto* sideDetectedData = new BoatEventData(sideEvent, eventSide);
-            m_eventBus.publish(sideEvent, sideDetectedData, EventPriority::NORMAL);
+            m_eventBus.emplace<BoatEventData>(sideEvent, eventSide);
 
-            auto* detectedData = new BoatEventData(BridgeEvent::BOAT_DETECTED, eventSide);
-            m_eventBus.publish(BridgeEvent::BOAT_DETECTED, detectedData, EventPriority::NORMAL); // Backward compatibility
+            m_eventBus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED, eventSide); // Backward compatibility
         }
         else
         {
@@ -363,7 +371,7 @@ void DetectionSystem::checkInitialDetection()
 // Check if boat has passed through and exited on the other side
 void DetectionSystem::checkBoatPassed()
 {
-    const unsigned long now = millis();
+    const unsigned long now = Clock::millis();
     const bool allowBeamEvents = allowBeamBreakEvents();
 
     const bool currentBeamBroken = readBeamBreak();
@@ -380,8 +388,7 @@ void DetectionSystem::checkBoatPassed()
             if (allowBeamEvents)
             {
                 LOG_INFO(Logger::TAG_DS, "BEAM BREAK: Boat occupying channel");
-                auto* activeData = new SimpleEventData(BridgeEvent::BEAM_BREAK_ACTIVE);
-                m_eventBus.publish(BridgeEvent::BEAM_BREAK_ACTIVE, activeData, EventPriority::EMERGENCY);
+                m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::BEAM_BREAK_ACTIVE);
             }
             else
             {
@@ -435,24 +442,20 @@ void DetectionSystem::checkBoatPassed()
     {
         LOG_INFO(Logger::TAG_DS, "BEAM BREAK: Boat clear (debounced)");
 
-        auto* clearData = new SimpleEventData(BridgeEvent::BEAM_BREAK_CLEAR);
-        m_eventBus.publish(BridgeEvent::BEAM_BREAK_CLEAR, clearData, EventPriority::EMERGENCY);
+        m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::BEAM_BREAK_CLEAR);
 
         // Publish side-specific event
         if (passedSide == BoatEventSide::RIGHT)
         {
-            auto* rightPassedData = new BoatEventData(BridgeEvent::BOAT_PASSED_RIGHT, BoatEventSide::RIGHT);
-            m_eventBus.publish(BridgeEvent::BOAT_PASSED_RIGHT, rightPassedData, EventPriority::NORMAL);
+            m_eventBus.emplace<BoatEventData>(BridgeEvent::BOAT_PASSED_RIGHT, BoatEventSide::RIGHT);
         }
         else
         {
-            auto* leftPassedData = new BoatEventData(BridgeEvent::BOAT_PASSED_LEFT, BoatEventSide::LEFT);
-            m_eventBus.publish(BridgeEvent::BOAT_PASSED_LEFT, leftPassedData, EventPriority::NORMAL);
+            m_eventBus.emplace<BoatEventData>(BridgeEvent::BOAT_PASSED_LEFT, BoatEventSide::LEFT);
         }
 
         // Publish general event
-        auto* passedData = new BoatEventData(BridgeEvent::BOAT_PASSED, passedSide);
-        m_eventBus.publish(BridgeEvent::BOAT_PASSED, passedData, EventPriority::NORMAL);
+        m_eventBus.emplace<BoatEventData>(BridgeEvent::BOAT_PASSED, passedSide);
     }
     else
     {
@@ -561,11 +564,10 @@ bool DetectionSystem::allowBeamBreakEvents() const
 
 void DetectionSystem::publishSimulationSensorConfig() const
 {
-    auto* payload = new SimulationSensorConfigData(
+    m_eventBus.emplace<SimulationSensorConfigData>(
         allowUltrasonicEvents(true),
         allowUltrasonicEvents(false),
         allowBeamBreakEvents());
-    m_eventBus.publish(BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED, payload, EventPriority::NORMAL);
 }
 
 // Getter methods for UI/monitoring
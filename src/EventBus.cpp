@@ -1,18 +1,19 @@
-// This is mock test area
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-#ifdef UNIT_TEST
-extern unsigned long mock_millis;
-inline unsigned long millis() { return mock_millis; }
-#endif
-
-//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-
 #include "EventBus.h"
+#include <algorithm>
+#include "Clock.h"
 #include "Logger.h"
+#include "TraceRecorder.h"
 
 // Global instance
 EventBus eventBus;
 
+// Every built-in payload must fit a pool block, otherwise it silently falls back to the heap
+static_assert(sizeof(SimpleEventData) <= EventPool::SMALL_BLOCK_SIZE, "SimpleEventData outgrew the small pool block");
+static_assert(sizeof(StateChangeData) <= EventPool::SMALL_BLOCK_SIZE, "StateChangeData outgrew the small pool block");
+static_assert(sizeof(BoatEventData) <= EventPool::SMALL_BLOCK_SIZE, "BoatEventData outgrew the small pool block");
+static_assert(sizeof(SimulationSensorConfigData) <= EventPool::SMALL_BLOCK_SIZE, "SimulationSensorConfigData outgrew the small pool block");
+static_assert(sizeof(LightChangeData) <= EventPool::LARGE_BLOCK_SIZE, "LightChangeData outgrew the large pool block");
+
 // EventData implementation
 EventData::~EventData() {
     // Virtual destructor for proper cleanup of derived classes
@@ -40,11 +41,69 @@ const char* SimpleEventData::getEventType() const {
     return bridgeEventToString(eventType_);
 }
 
+EventData* payloadPointer(EventPayload& payload) {
+    struct Visitor {
+        EventData* operator()(std::monostate&) const { return nullptr; }
+        EventData* operator()(OwnedEventData& owned) const { return owned.get(); }
+        EventData* operator()(EventData& data) const { return &data; }
+    };
+    return std::visit(Visitor{}, payload);
+}
+
+namespace {
+// Boat side carried by the payload, for trace records
+BoatEventSide payloadSide(EventPayload& payload) {
+    const EventData* data = payloadPointer(payload);
+    return data ? data->getBoatEventSide() : BoatEventSide::UNKNOWN;
+}
+}  // namespace
+
+// EventRingQueue implementation
+EventRingQueue::EventRingQueue(size_t capacity)
+    : slots_(capacity > 0 ? capacity : 1) {
+    // All storage is allocated here; push/pop only move indices
+}
+
+bool EventRingQueue::push(QueuedEvent&& event) {
+    if (full()) {
+        return false;
+    }
+    size_t tail = head_ + count_;
+    if (tail >= slots_.size()) {
+        tail -= slots_.size();
+    }
+    slots_[tail] = std::move(event);
+    count_++;
+    return true;
+}
+
+bool EventRingQueue::pop(QueuedEvent& out) {
+    if (empty()) {
+        return false;
+    }
+    out = std::move(slots_[head_]);
+    slots_[head_].payload = std::monostate{};  // Ring no longer owns the payload
+    head_++;
+    if (head_ == slots_.size()) {
+        head_ = 0;
+    }
+    count_--;
+    return true;
+}
+
+void EventRingQueue::swap(EventRingQueue& other) noexcept {
+    slots_.swap(other.slots_);
+    std::swap(head_, other.head_);
+    std::swap(count_, other.count_);
+}
+
 // EventBus implementation
-EventBus::EventBus() {
+EventBus::EventBus(size_t emergencyCapacity, size_t normalCapacity)
+    : emergencyQueue(emergencyCapacity),
+      normalQueue(normalCapacity),
+      emergencyBatch(emergencyCapacity),
+      normalBatch(normalCapacity) {
     // Initialize event bus
-    eventQueue.clear();
-    subscribers.clear();
 }
 
 EventBus::~EventBus() {
@@ -52,101 +111,600 @@ EventBus::~EventBus() {
     std::lock_guard<std::recursive_mutex> queueLock(eventQueue_mutex);
     std::lock_guard<std::recursive_mutex> subscribersLock(subscribers_mutex);
 
-    // Delete all pending events in the queue
-    for (auto& queuedEvent : eventQueue) {
-        // Clean up any heap-allocated EventData
-        delete queuedEvent.eventData;
-        queuedEvent.eventData = nullptr;
-    }
-    eventQueue.clear();
+    // Delete all pending events in the queues
+    discardQueuedEvents();
 
     // Clear all subscribers for each event type
-    subscribers.clear();
+    for (auto& list : subscribers) {
+        list.clear();
+    }
 }
 
-void EventBus::subscribe(BridgeEvent eventType, std::function<void(EventData*)> callback, EventPriority priority) {
-    // Lock the subscribers map for thread safety
+SubscriptionId EventBus::subscribe(BridgeEvent eventType, EventCallback callback, EventPriority priority) {
+    // Lock the subscribers table for thread safety
     std::lock_guard<std::recursive_mutex> lock(subscribers_mutex);
 
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_EVT, "subscribe(%s) rejected - EventBus is sealed",
+                  bridgeEventToString(eventType));
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
     //Create a new subscribtion object
     EventSubscription subscribtion;
-    subscribtion.callback = callback;
+    subscribtion.callback = std::move(callback);
     subscribtion.priority = priority;
 
     // Add the subscription to the list for the given event type
-    subscribers[eventType].push_back(subscribtion);
+    return addSubscription(static_cast<size_t>(eventType), std::move(subscribtion));
+}
+
+SubscriptionId EventBus::subscribePayload(BridgeEvent eventType, EventPayloadCallback callback,
+                                          EventPriority priority) {
+    std::lock_guard<std::recursive_mutex> lock(subscribers_mutex);
+
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_EVT, "subscribe(%s) rejected - EventBus is sealed",
+                  bridgeEventToString(eventType));
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
+    EventSubscription subscription;
+    subscription.payloadCallback = std::move(callback);
+    subscription.priority = priority;
+    return addSubscription(static_cast<size_t>(eventType), std::move(subscription));
+}
+
+SubscriptionId EventBus::subscribe(EventMask events, EventMaskCallback callback, EventPriority priority) {
+    std::lock_guard<std::recursive_mutex> lock(subscribers_mutex);
+
+    if (isSealed()) {
+        LOG_ERROR(Logger::TAG_EVT, "subscribe(mask=0x%llx) rejected - EventBus is sealed",
+                  static_cast<unsigned long long>(events.bits()));
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
+    EventSubscription subscription;
+    subscription.maskCallback = std::move(callback);
+    subscription.mask = events;
+    subscription.priority = priority;
+    return addSubscription(MASK_LIST, std::move(subscription));
+}
+
+SubscriptionId EventBus::addSubscription(size_t eventIndex, EventSubscription&& subscription) {
+    // Reuse a freed slot if there is one; tokens carry the slot's generation
+    uint16_t slotIndex;
+    if (!freeSlots.empty()) {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    } else if (subscriptionSlots.size() < UINT16_MAX) {
+        slotIndex = static_cast<uint16_t>(subscriptionSlots.size());
+        subscriptionSlots.emplace_back();
+    } else {
+        LOG_ERROR(Logger::TAG_EVT, "subscribe rejected - subscription table full");
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
+    subscription.label = subscriberLabel;
+
+    SubscriptionSlot& slot = subscriptionSlots[slotIndex];
+    slot.used = true;
+    slot.eventIndex = static_cast<uint8_t>(eventIndex);
+    subscription.id = (static_cast<SubscriptionId>(slot.generation) << 16) | (slotIndex + 1u);
+    const SubscriptionId id = subscription.id;
+
+    if (dispatching) {
+        // A callback is subscribing - don't move the list it is being called from
+        slot.deferred = true;
+        slot.position = static_cast<uint16_t>(deferredSubscriptions.size());
+        deferredSubscriptions.push_back(std::move(subscription));
+    } else {
+        slot.deferred = false;
+        insertByPriority(eventIndex, std::move(subscription));
+    }
+    return id;
+}
+
+void EventBus::insertByPriority(size_t eventIndex, EventSubscription&& subscription) {
+    auto& list = subscribers[eventIndex];
+
+    // EMERGENCY subscribers go after the existing EMERGENCY ones but before any NORMAL one,
+    // so safety handlers run first and each priority keeps registration order
+    auto it = list.end();
+    if (subscription.priority == EventPriority::EMERGENCY) {
+        it = std::find_if(list.begin(), list.end(), [](const EventSubscription& s) {
+            return s.priority != EventPriority::EMERGENCY;
+        });
+    }
+    it = list.insert(it, std::move(subscription));
+
+    // Entries from the insert point on have moved up by one
+    for (size_t i = static_cast<size_t>(it - list.begin()); i < list.size(); ++i) {
+        subscriptionSlots[(list[i].id & 0xFFFFu) - 1].position = static_cast<uint16_t>(i);
+    }
+}
+
+EventBus::SubscriptionSlot* EventBus::findSlot(SubscriptionId id) {
+    const size_t slotIndex = (id & 0xFFFFu);
+    if (slotIndex == 0 || slotIndex > subscriptionSlots.size()) {
+        return nullptr;
+    }
+    SubscriptionSlot& slot = subscriptionSlots[slotIndex - 1];
+    if (!slot.used || slot.generation != static_cast<uint16_t>(id >> 16)) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+void EventBus::freeSlot(SubscriptionId id) {
+    const uint16_t slotIndex = static_cast<uint16_t>((id & 0xFFFFu) - 1);
+    SubscriptionSlot& slot = subscriptionSlots[slotIndex];
+    slot.used = false;
+    slot.deferred = false;
+    slot.generation++;
+    freeSlots.push_back(slotIndex);
+}
+
+void EventBus::compactSubscribers() {
+    // Subscriptions made during dispatch go into their lists now
+    if (!deferredSubscriptions.empty()) {
+        std::vector<EventSubscription> added;
+        added.swap(deferredSubscriptions);
+        for (auto& subscription : added) {
+            SubscriptionSlot& slot = subscriptionSlots[(subscription.id & 0xFFFFu) - 1];
+            if (!subscription.active.load(std::memory_order_relaxed)) {
+                freeSlot(subscription.id);
+                pendingRemovals--;  // Unsubscribed before it was ever inserted
+                continue;
+            }
+            slot.deferred = false;
+            insertByPriority(slot.eventIndex, std::move(subscription));
+        }
+    }
+
+    if (pendingRemovals == 0) {
+        return;
+    }
+    for (auto& list : subscribers) {
+        auto out = list.begin();
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (!it->active.load(std::memory_order_relaxed)) {
+                freeSlot(it->id);
+                continue;
+            }
+            if (out != it) {
+                *out = std::move(*it);
+            }
+            subscriptionSlots[(out->id & 0xFFFFu) - 1].position = static_cast<uint16_t>(out - list.begin());
+            ++out;
+        }
+        list.erase(out, list.end());
+    }
+    pendingRemovals = 0;
 }
 
 void EventBus::publish(BridgeEvent eventType, EventData* eventData, EventPriority priority) {
-    // Lock the event queue for thread safety (recursive mutex allows nested calls)
-    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+    // Pointer payloads ride in the queue as an owning handle and are deleted after dispatch
+    if (eventData) {
+        publishPayload(eventType, EventPayload(std::in_place_type<OwnedEventData>, eventData), priority);
+    } else {
+        publishPayload(eventType, EventPayload(), priority);
+    }
+}
+
+void EventBus::publishPayload(BridgeEvent eventType, EventPayload&& payload, EventPriority priority) {
+    {
+        // Lock the event queue for thread safety (recursive mutex allows nested calls)
+        std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+
+        // Create a new QueuedEvent with the provided data
+        QueuedEvent newEvent;
+        newEvent.eventType = eventType;
+        newEvent.payload = std::move(payload);
+        newEvent.priority = priority;
+        newEvent.timestamp = Clock::micros(); // Publish time, for the queue-wait histogram
 
-    // Create a new QueuedEvent with the provided data
+        const BoatEventSide side = trace ? payloadSide(newEvent.payload) : BoatEventSide::UNKNOWN;
+        const uint32_t timestampUs = static_cast<uint32_t>(newEvent.timestamp);
+        const bool queued = enqueueLocked(std::move(newEvent));
+        if (trace) {
+            const EventRingQueue& queue = (priority == EventPriority::EMERGENCY) ? emergencyQueue : normalQueue;
+            trace->record(queued ? TraceKind::PUBLISH : TraceKind::DROP, eventType, side, priority,
+                          queue.size(), timestampUs);
+        }
+    }
+    signalWake();
+}
+
+bool EventBus::publishRemote(BridgeEvent eventType, EventPayload&& payload, EventPriority priority) {
     QueuedEvent newEvent;
     newEvent.eventType = eventType;
-    newEvent.eventData = eventData;
+    newEvent.payload = std::move(payload);
     newEvent.priority = priority;
-    newEvent.timestamp = millis(); // Save Event starting time
+    newEvent.timestamp = Clock::micros(); // Publish time, not hand-off time
 
-    // Add it to the event queue based on priority
-    if (priority == EventPriority::EMERGENCY) {
-        // Insert after the last EMERGENCY event, but before NORMAL events
-        auto it = eventQueue.begin();
-        while (it != eventQueue.end() && it->priority == EventPriority::EMERGENCY) {
-            ++it;
+    // The lock-free hand-off queue has no cheap size, so remote records carry depth 0
+    const BoatEventSide side = trace ? payloadSide(newEvent.payload) : BoatEventSide::UNKNOWN;
+    const uint32_t timestampUs = static_cast<uint32_t>(newEvent.timestamp);
+    if (remoteQueue.tryPush(std::move(newEvent))) {
+        if (trace) {
+            trace->record(TraceKind::PUBLISH_REMOTE, eventType, side, priority, 0, timestampUs);
         }
-        eventQueue.insert(it, newEvent);
-    } else {
-        // NORMAL events go to the back of the queue
-        eventQueue.push_back(newEvent);
+        signalWake();
+        return true;
+    }
+    if (trace) {
+        trace->record(TraceKind::DROP, eventType, side, priority, 0, timestampUs);
+    }
+
+    // Hand-off queue full - newEvent still owns its payload and releases it on return
+    const uint32_t dropped = remoteDropped.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!remoteOverflowReported.exchange(true, std::memory_order_relaxed)) {
+        LOG_WARN(Logger::TAG_EVT, "Remote queue full (%u) - dropping %s (total dropped=%u)",
+                 static_cast<unsigned int>(REMOTE_QUEUE_CAPACITY),
+                 bridgeEventToString(eventType),
+                 static_cast<unsigned int>(dropped));
     }
+    return false;
 }
 
-void EventBus::unsubscribe(BridgeEvent eventType, std::function<void(EventData*)> callback) {
-     // Lock the subscribers map for thread safety
+bool EventBus::enqueueLocked(QueuedEvent&& newEvent) {
+    // Each priority has its own ring, so EMERGENCY events are O(1) to enqueue
+    // and still processed before any NORMAL event
+    const BridgeEvent eventType = newEvent.eventType;
+    const bool emergency = (newEvent.priority == EventPriority::EMERGENCY);
+    EventRingQueue& queue = emergency ? emergencyQueue : normalQueue;
+
+    if (!queue.push(std::move(newEvent))) {
+        // Ring full - drop the incoming event (see drop policy in EventBus.h);
+        // the caller's event still owns its payload and releases it
+        bool& reported = emergency ? emergencyOverflowReported : normalOverflowReported;
+        uint32_t& dropped = emergency ? emergencyDropped : normalDropped;
+        dropped++;
+        if (!reported) {
+            reported = true;
+            LOG_WARN(Logger::TAG_EVT, "%s queue full (%u) - dropping %s (total dropped=%u)",
+                     emergency ? "EMERGENCY" : "NORMAL",
+                     static_cast<unsigned int>(queue.capacity()),
+                     bridgeEventToString(eventType),
+                     static_cast<unsigned int>(dropped));
+        }
+        return false;
+    }
+
+    if (emergency) {
+        emergencyPending.store(true, std::memory_order_release);
+    }
+
+    size_t& highWater = emergency ? emergencyHighWater : normalHighWater;
+    if (queue.size() > highWater) {
+        highWater = queue.size();
+    }
+    return true;
+}
+
+bool EventBus::unsubscribe(SubscriptionId id) {
+    if (isSealed()) {
+        // The slot table and lists are frozen, so no lock is needed to find the entry;
+        // clearing its flag is the whole removal (the entry stays until clear())
+        SubscriptionSlot* slot = findSlot(id);
+        if (!slot) {
+            return false;
+        }
+        return subscribers[slot->eventIndex][slot->position].active.exchange(false, std::memory_order_acq_rel);
+    }
+
     std::lock_guard<std::recursive_mutex> lock(subscribers_mutex);
+    SubscriptionSlot* slot = findSlot(id);
+    if (!slot) {
+        return false;
+    }
+    EventSubscription& entry = slot->deferred ? deferredSubscriptions[slot->position]
+                                              : subscribers[slot->eventIndex][slot->position];
+    if (!entry.active.exchange(false, std::memory_order_acq_rel)) {
+        return false;  // Already removed, waiting for compaction
+    }
+    // Compaction waits for the end of processEvents() (or seal()), so this stays O(1)
+    // and never reshuffles a list whose callbacks may be running
+    pendingRemovals++;
+    return true;
+}
 
-    // Since std::function comparison is not supported on ESP32,
-    // We now remove all subscribers for this event type
-    // This works for our use case where we subscribe once and don't unsubscribe.
-    auto it = subscribers.find(eventType);
-    if (it != subscribers.end()) {
-        subscribers.erase(it);
-        LOG_WARN(Logger::TAG_EVT, "Removed all subscribers for event type");
+void EventBus::signalWake() {
+    // Only the first publish since the last dispatch is timed; later ones would understate the wait
+    if (wakeRequestUs.load(std::memory_order_relaxed) == 0) {
+        uint32_t expected = 0;
+        wakeRequestUs.compare_exchange_strong(expected, static_cast<uint32_t>(Clock::micros()) | 1u,
+                                              std::memory_order_relaxed);
     }
+    wakeSignal.notify();
 }
 
-void EventBus::processEvents() {
-    // Lock both event queue and subscribers for thread safety
-    std::lock_guard<std::recursive_mutex> queueLock(eventQueue_mutex);
-    std::lock_guard<std::recursive_mutex> subscribersLock(subscribers_mutex);
+TimerId EventBus::publishAfter(uint32_t delayMs, BridgeEvent eventType, EventPriority priority) {
+    TimerId id = timers.schedule(Clock::millis(), delayMs, [this, eventType, priority]() {
+        publishPayload(eventType, EventPayload(std::in_place_type<SimpleEventData>, eventType), priority);
+    });
+    if (id != INVALID_TIMER_ID) {
+        wakeSignal.notify();  // A sleeping waitForWork() recomputes its timeout
+    } else {
+        LOG_ERROR(Logger::TAG_EVT, "publishAfter(%s) rejected - timer pool full (%u)",
+                  bridgeEventToString(eventType), static_cast<unsigned int>(TimerWheel::MAX_TIMERS));
+    }
+    return id;
+}
 
-    // Process events in the queue
-    while (!eventQueue.empty()) {
-        // 1. Get events from the queue (with appropriate locking)
-        QueuedEvent event = eventQueue.front();
-        eventQueue.erase(eventQueue.begin());
-
-        // 2. For each event, find subscribers and call their callbacks
-        auto subIt = subscribers.find(event.eventType);
-        if (subIt != subscribers.end()) {
-            // Only log events that have actual impact (non-debug events)
-            if ((int)event.eventType < 16) { // Log important events only
-                LOG_DEBUG(Logger::TAG_EVT, "EVENT: %s → %d subscribers",
-                          bridgeEventToString(event.eventType), subIt->second.size());
-            }
-            
-            for (const auto& subscription : subIt->second) {
-                if (subscription.callback) {
-                    subscription.callback(event.eventData);
-                }
-            }
+TimerId EventBus::callAfter(uint32_t delayMs, TimerCallback callback) {
+    TimerId id = timers.schedule(Clock::millis(), delayMs, std::move(callback));
+    if (id != INVALID_TIMER_ID) {
+        wakeSignal.notify();
+    } else {
+        LOG_ERROR(Logger::TAG_EVT, "callAfter(%lums) rejected - timer pool full (%u)",
+                  static_cast<unsigned long>(delayMs), static_cast<unsigned int>(TimerWheel::MAX_TIMERS));
+    }
+    return id;
+}
+
+bool EventBus::cancelTimer(TimerId id) {
+    return timers.cancel(id);
+}
+
+uint32_t EventBus::msUntilNextTimer() const {
+    return timers.nextDueIn(Clock::millis());
+}
+
+void EventBus::drainRemoteEvents() {
+    // Only take an event once its ring has room; anything left waits in the hand-off
+    // queue, so a burst pushes back on the remote producers instead of being dropped here
+    QueuedEvent event;
+    bool drained = false;
+    while (const QueuedEvent* next = remoteQueue.peek()) {
+        const EventRingQueue& queue = (next->priority == EventPriority::EMERGENCY) ? emergencyQueue : normalQueue;
+        if (queue.full()) {
+            break;
+        }
+        remoteQueue.tryPop(event);
+        enqueueLocked(std::move(event));
+        drained = true;
+    }
+    if (drained) {
+        remoteOverflowReported.store(false, std::memory_order_relaxed);
+    }
+}
+
+void EventBus::refillBatches() {
+    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+
+    // Pick up events handed over from the other core since the last refill
+    drainRemoteEvents();
+
+    // A dispatch ring is only refilled once empty, which keeps FIFO order within each priority
+    if (emergencyBatch.empty() && !emergencyQueue.empty()) {
+        emergencyBatch.swap(emergencyQueue);
+        emergencyOverflowReported = false;
+    }
+    if (normalBatch.empty() && !normalQueue.empty()) {
+        normalBatch.swap(normalQueue);
+        normalOverflowReported = false;
+    }
+    emergencyPending.store(!emergencyQueue.empty(), std::memory_order_release);
+}
+
+bool EventBus::takeNextEvent(QueuedEvent& out) {
+    // Only take the lock when the batch runs dry or an EMERGENCY event is waiting behind it
+    const bool batchesEmpty = emergencyBatch.empty() && normalBatch.empty();
+    if (batchesEmpty || (emergencyBatch.empty() && emergencyPending.load(std::memory_order_acquire))) {
+        refillBatches();
+    }
+
+    // Events come out EMERGENCY first, then NORMAL, FIFO within each priority
+    if (emergencyBatch.pop(out)) {
+        return true;
+    }
+    return normalBatch.pop(out);
+}
+
+void EventBus::dispatchEvent(QueuedEvent& event) {
+    // Index straight into the subscriber table and call the callbacks
+    const size_t index = static_cast<size_t>(event.eventType);
+    if (index >= BRIDGE_EVENT_COUNT) {
+        return;
+    }
+    const unsigned long dispatchStartUs = Clock::micros();
+    eventTimings[index].queueWait.record(static_cast<uint32_t>(dispatchStartUs - event.timestamp));
+
+    auto& list = subscribers[index];
+    auto& masks = subscribers[MASK_LIST];
+    if (list.empty() && masks.empty()) {
+        traceDispatch(event, dispatchStartUs, 0);
+        return;
+    }
+
+    // Only log events that have actual impact (non-debug events)
+    if ((int)event.eventType < 16) { // Log important events only
+        LOG_DEBUG(Logger::TAG_EVT, "EVENT: %s → %u subscribers",
+                  bridgeEventToString(event.eventType), static_cast<unsigned int>(list.size()));
+    }
+
+    // Typed subscribers read the payload in place; pointer-API subscribers get an EventData view of it
+    EventData* eventData = payloadPointer(event.payload);
+
+    auto timed = [](EventSubscription& subscription, uint32_t elapsedUs) {
+        // Only this task writes the counters; readers on the other core just load them
+        subscription.calls.store(subscription.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        subscription.totalUs.store(subscription.totalUs.load(std::memory_order_relaxed) + elapsedUs,
+                                   std::memory_order_relaxed);
+        if (elapsedUs > subscription.maxUs.load(std::memory_order_relaxed)) {
+            subscription.maxUs.store(elapsedUs, std::memory_order_relaxed);
+        }
+    };
+    auto call = [&](EventSubscription& subscription) {
+        if (!subscription.active.load(std::memory_order_acquire)) {
+            return;  // Unsubscribed, not yet compacted
+        }
+        const unsigned long callStartUs = Clock::micros();
+        if (subscription.payloadCallback) {
+            subscription.payloadCallback(event.payload);
+        } else if (subscription.callback) {
+            subscription.callback(eventData);
+        }
+        timed(subscription, static_cast<uint32_t>(Clock::micros() - callStartUs));
+    };
+    auto callMask = [&](EventSubscription& subscription) {
+        if (subscription.mask.contains(event.eventType) &&
+            subscription.active.load(std::memory_order_acquire)) {
+            const unsigned long callStartUs = Clock::micros();
+            subscription.maskCallback(event.eventType, eventData);
+            timed(subscription, static_cast<uint32_t>(Clock::micros() - callStartUs));
+        }
+    };
+
+    // Both lists are sorted EMERGENCY first: run each list's EMERGENCY block, then the NORMAL blocks
+    size_t i = 0;
+    size_t m = 0;
+    for (; i < list.size() && list[i].priority == EventPriority::EMERGENCY; ++i) {
+        call(list[i]);
+    }
+    for (; m < masks.size() && masks[m].priority == EventPriority::EMERGENCY; ++m) {
+        callMask(masks[m]);
+    }
+    for (; i < list.size(); ++i) {
+        call(list[i]);
+    }
+    for (; m < masks.size(); ++m) {
+        callMask(masks[m]);
+    }
+    const uint32_t durationUs = static_cast<uint32_t>(Clock::micros() - dispatchStartUs);
+    eventTimings[index].dispatch.record(durationUs);
+    traceDispatch(event, dispatchStartUs, durationUs);
+}
+
+void EventBus::traceDispatch(QueuedEvent& event, unsigned long startUs, uint32_t durationUs) {
+    if (!trace) {
+        return;
+    }
+    // Depth = events still waiting in this pass's dispatch rings
+    trace->record(TraceKind::DISPATCH, event.eventType, payloadSide(event.payload), event.priority,
+                  emergencyBatch.size() + normalBatch.size(), static_cast<uint32_t>(startUs), durationUs);
+}
+
+size_t EventBus::processEvents(size_t maxEvents, uint32_t maxMicros) {
+    // The subscriber table only needs its lock until sealed; the queue lock is
+    // taken briefly inside refillBatches() and never held across a callback
+    std::unique_lock<std::recursive_mutex> subscribersLock(subscribers_mutex, std::defer_lock);
+    if (!isSealed()) {
+        subscribersLock.lock();
+    }
+
+    // Deadlines first, so events they publish are dispatched in this same call
+    timers.advance(Clock::millis());
+
+    const unsigned long startUs = Clock::micros();
+
+    // Always look at the publish rings first so new EMERGENCY and remote events
+    // are not stuck behind NORMAL events carried over from the previous call
+    refillBatches();
+
+    // Wake-to-dispatch latency of the first event published since the last call
+    const uint32_t wakeRequested = wakeRequestUs.exchange(0, std::memory_order_relaxed);
+    if (wakeRequested != 0 && (!emergencyBatch.empty() || !normalBatch.empty())) {
+        const uint32_t latencyUs = static_cast<uint32_t>(startUs) - wakeRequested;
+        std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+        wakeLatencySamples++;
+        wakeLatencyTotalUs += latencyUs;
+        if (latencyUs > wakeLatencyMaxUs) {
+            wakeLatencyMaxUs = latencyUs;
         }
-        
-        // Clean up event data if provided
-        delete event.eventData;
-        event.eventData = nullptr;
     }
+
+    size_t dispatched = 0;
+    bool budgetHit = false;
+    QueuedEvent event;
+    const bool wasDispatching = dispatching;
+    dispatching = true;
+    while (takeNextEvent(event)) {
+        dispatchEvent(event);
+
+        // Release the payload now rather than when the next event is popped into this slot
+        event.payload = std::monostate{};
+        dispatched++;
+
+        if (dispatched >= maxEvents ||
+            (maxMicros != 0 && (Clock::micros() - startUs) >= maxMicros)) {
+            budgetHit = true;
+            break;
+        }
+    }
+    dispatching = wasDispatching;
+
+    // Apply subscribe/unsubscribe calls the callbacks made (the lock is still held before seal)
+    if (!dispatching && !isSealed() && (pendingRemovals != 0 || !deferredSubscriptions.empty())) {
+        compactSubscribers();
+    }
+
+    if (budgetHit) {
+        std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+        if (!emergencyBatch.empty() || !normalBatch.empty() ||
+            !emergencyQueue.empty() || !normalQueue.empty() || remoteQueue.peek()) {
+            budgetStops++;
+        }
+    } else {
+        // Everything, including events the callbacks published, has been dispatched;
+        // don't let their stamp be charged to the next wake-up
+        wakeRequestUs.store(0, std::memory_order_relaxed);
+    }
+    return dispatched;
+}
+
+bool EventBus::hasPendingEvents() const {
+    if (!emergencyBatch.empty() || !normalBatch.empty() || remoteQueue.peek()) {
+        return true;
+    }
+    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+    return !emergencyQueue.empty() || !normalQueue.empty();
+}
+
+bool EventBus::waitForWork(uint32_t maxWaitMs) {
+    // Sleep no longer than the next timer; not at all if events are already waiting
+    uint32_t waitMs = maxWaitMs;
+    if (hasPendingEvents()) {
+        waitMs = 0;
+    } else {
+        const uint32_t timerMs = timers.nextDueIn(Clock::millis());
+        if (timerMs < waitMs) {
+            waitMs = timerMs;
+        }
+    }
+
+    const unsigned long startUs = Clock::micros();
+    const bool notified = wakeSignal.wait(waitMs);
+    const unsigned long endUs = Clock::micros();
+
+    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+    loopWaits++;
+    if (notified) {
+        loopNotifiedWakeups++;
+    } else if (waitMs > 0) {
+        loopTimeoutWakeups++;
+    }
+    if (lastWakeUs != 0) {
+        loopBusyUs += startUs - lastWakeUs;
+    }
+    loopIdleUs += endUs - startUs;
+    lastWakeUs = endUs ? endUs : 1;
+    return notified;
+}
+
+void EventBus::discardQueuedEvents() {
+    QueuedEvent event;
+    while (remoteQueue.tryPop(event)) {
+        event.payload = std::monostate{};
+    }
+    for (EventRingQueue* queue : {&emergencyBatch, &normalBatch, &emergencyQueue, &normalQueue}) {
+        while (queue->pop(event)) {
+            event.payload = std::monostate{};
+        }
+    }
+    emergencyPending.store(false, std::memory_order_release);
 }
 
 void EventBus::clear() {
@@ -154,20 +712,181 @@ void EventBus::clear() {
     std::lock_guard<std::recursive_mutex> queueLock(eventQueue_mutex);
     std::lock_guard<std::recursive_mutex> subscribersLock(subscribers_mutex);
 
-    // Delete all pending events in the queue
-    for (auto& event : eventQueue) {
-        delete event.eventData;
-        event.eventData = nullptr;
+    // Delete all pending events in the queues and drop any armed timers
+    discardQueuedEvents();
+    timers.clear();
+    wakeRequestUs.store(0, std::memory_order_relaxed);
+    loopWaits = 0;
+    loopNotifiedWakeups = 0;
+    loopTimeoutWakeups = 0;
+    loopIdleUs = 0;
+    loopBusyUs = 0;
+    lastWakeUs = 0;
+    wakeLatencySamples = 0;
+    wakeLatencyTotalUs = 0;
+    wakeLatencyMaxUs = 0;
+    for (auto& timings : eventTimings) {
+        timings.queueWait.reset();
+        timings.dispatch.reset();
     }
-    eventQueue.clear();
+    emergencyDropped = 0;
+    budgetStops = 0;
+    remoteDropped.store(0, std::memory_order_relaxed);
+    normalDropped = 0;
+    emergencyHighWater = 0;
+    normalHighWater = 0;
 
-    // Clear all subscribers
-    subscribers.clear();
+    // Clear all subscribers and allow new registrations again
+    // Slots keep their generation so tokens issued before clear() stay invalid
+    for (auto& list : subscribers) {
+        for (const auto& entry : list) {
+            freeSlot(entry.id);
+        }
+        list.clear();
+    }
+    for (const auto& entry : deferredSubscriptions) {
+        freeSlot(entry.id);
+    }
+    deferredSubscriptions.clear();
+    pendingRemovals = 0;
+    sealed.store(false, std::memory_order_release);
 }
 
-bool EventBus::hasSubscriptions(BridgeEvent eventType) const {
+void EventBus::seal() {
     std::lock_guard<std::recursive_mutex> lock(subscribers_mutex);
 
-    auto it = subscribers.find(eventType);
-    return (it != subscribers.end() && !it->second.empty());
+    // Last chance to drop inactive entries - a sealed table is never reshuffled
+    if (!dispatching) {
+        compactSubscribers();
+    }
+
+    size_t total = 0;
+    for (auto& list : subscribers) {
+        list.shrink_to_fit();  // Table is final - release spare capacity
+        total += list.size();
+    }
+    sealed.store(true, std::memory_order_release);
+    LOG_INFO(Logger::TAG_EVT, "EventBus sealed with %u subscriptions", static_cast<unsigned int>(total));
+}
+
+bool EventBus::hasSubscriptions(BridgeEvent eventType) const {
+    std::unique_lock<std::recursive_mutex> lock(subscribers_mutex, std::defer_lock);
+    if (!isSealed()) {
+        lock.lock();
+    }
+
+    const size_t index = static_cast<size_t>(eventType);
+    if (index >= BRIDGE_EVENT_COUNT) {
+        return false;
+    }
+    const auto& list = subscribers[index];
+    const auto& masks = subscribers[MASK_LIST];
+    return std::any_of(list.begin(), list.end(), [](const EventSubscription& s) {
+               return s.active.load(std::memory_order_relaxed);
+           }) ||
+           std::any_of(masks.begin(), masks.end(), [eventType](const EventSubscription& s) {
+               return s.mask.contains(eventType) && s.active.load(std::memory_order_relaxed);
+           });
+}
+
+EventQueueStats EventBus::getQueueStats() const {
+    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+
+    EventQueueStats stats;
+    stats.emergencyDropped = emergencyDropped;
+    stats.normalDropped = normalDropped;
+    stats.emergencyHighWater = emergencyHighWater;
+    stats.normalHighWater = normalHighWater;
+    stats.emergencyCapacity = emergencyQueue.capacity();
+    stats.normalCapacity = normalQueue.capacity();
+    stats.remoteDropped = remoteDropped.load(std::memory_order_relaxed);
+    stats.remoteCapacity = remoteQueue.capacity();
+    stats.budgetStops = budgetStops;
+    return stats;
+}
+
+EventLoopStats EventBus::getLoopStats() const {
+    std::lock_guard<std::recursive_mutex> lock(eventQueue_mutex);
+
+    EventLoopStats stats;
+    stats.waits = loopWaits;
+    stats.notifiedWakeups = loopNotifiedWakeups;
+    stats.timeoutWakeups = loopTimeoutWakeups;
+    const uint64_t totalUs = loopIdleUs + loopBusyUs;
+    stats.idlePercent = totalUs ? static_cast<float>(loopIdleUs * 100.0 / static_cast<double>(totalUs)) : 0.0f;
+    stats.wakeLatencySamples = wakeLatencySamples;
+    stats.wakeLatencyAvgUs = wakeLatencySamples ? static_cast<uint32_t>(wakeLatencyTotalUs / wakeLatencySamples) : 0;
+    stats.wakeLatencyMaxUs = wakeLatencyMaxUs;
+    return stats;
+}
+
+const LatencyHistogram& EventBus::queueWaitHistogram(BridgeEvent eventType) const {
+    return eventTimings[static_cast<size_t>(eventType) % BRIDGE_EVENT_COUNT].queueWait;
+}
+
+const LatencyHistogram& EventBus::dispatchHistogram(BridgeEvent eventType) const {
+    return eventTimings[static_cast<size_t>(eventType) % BRIDGE_EVENT_COUNT].dispatch;
+}
+
+size_t EventBus::getSubscriberTimings(SubscriberTiming* out, size_t capacity) const {
+    std::unique_lock<std::recursive_mutex> lock(subscribers_mutex, std::defer_lock);
+    if (!isSealed()) {
+        lock.lock();
+    }
+
+    size_t written = 0;
+    for (size_t index = 0; index <= MASK_LIST; ++index) {
+        for (const auto& entry : subscribers[index]) {
+            if (written == capacity) {
+                return written;
+            }
+            if (!entry.active.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            SubscriberTiming& timing = out[written++];
+            timing.id = entry.id;
+            timing.label = entry.label;
+            timing.mask = (index == MASK_LIST);
+            timing.event = static_cast<BridgeEvent>(timing.mask ? 0 : index);
+            timing.priority = entry.priority;
+            timing.calls = entry.calls.load(std::memory_order_relaxed);
+            timing.totalUs = entry.totalUs.load(std::memory_order_relaxed);
+            timing.maxUs = entry.maxUs.load(std::memory_order_relaxed);
+        }
+    }
+    return written;
+}
+
+size_t EventBus::subscriptionCount() const {
+    std::unique_lock<std::recursive_mutex> lock(subscribers_mutex, std::defer_lock);
+    if (!isSealed()) {
+        lock.lock();
+    }
+
+    size_t total = 0;
+    for (const auto& list : subscribers) {
+        total += std::count_if(list.begin(), list.end(), [](const EventSubscription& s) {
+            return s.active.load(std::memory_order_relaxed);
+        });
+    }
+    return total;
+}
+
+void EventBus::resetMetrics() {
+    std::unique_lock<std::recursive_mutex> lock(subscribers_mutex, std::defer_lock);
+    if (!isSealed()) {
+        lock.lock();
+    }
+
+    for (auto& timings : eventTimings) {
+        timings.queueWait.reset();
+        timings.dispatch.reset();
+    }
+    for (auto& list : subscribers) {
+        for (auto& entry : list) {
+            entry.calls.store(0, std::memory_order_relaxed);
+            entry.totalUs.store(0, std::memory_order_relaxed);
+            entry.maxUs.store(0, std::memory_order_relaxed);
+        }
+    }
 }
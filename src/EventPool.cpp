@@ -0,0 +1,110 @@
+#include "EventPool.h"
+#include "Logger.h"
+
+#include <mutex>
+#include <new>
+
+namespace EventPool {
+
+namespace {
+
+struct PoolState {
+    FixedBlockPool<SMALL_BLOCK_SIZE, SMALL_BLOCK_COUNT> small;
+    FixedBlockPool<LARGE_BLOCK_SIZE, LARGE_BLOCK_COUNT> large;
+    uint32_t exhausted = 0;
+    uint32_t oversize = 0;
+    bool exhaustionReported = false;  // Log once per exhaustion burst
+    std::mutex mutex;
+};
+
+// Function-local static so the pools exist before any global constructor can publish an event
+PoolState& state() {
+    static PoolState pools;
+    return pools;
+}
+
+} // namespace
+
+void* allocate(size_t size) {
+    PoolState& pools = state();
+    bool reportExhaustion = false;
+    {
+        std::lock_guard<std::mutex> lock(pools.mutex);
+
+        if (size <= SMALL_BLOCK_SIZE) {
+            if (void* block = pools.small.allocate()) {
+                return block;
+            }
+        }
+        if (size <= LARGE_BLOCK_SIZE) {
+            if (void* block = pools.large.allocate()) {
+                return block;
+            }
+            pools.exhausted++;
+            if (!pools.exhaustionReported) {
+                pools.exhaustionReported = true;
+                reportExhaustion = true;
+            }
+        } else {
+            pools.oversize++;
+        }
+    }
+
+    if (reportExhaustion) {
+        LOG_WARN(Logger::TAG_EVT, "Event pool exhausted - payload of %u bytes taken from heap",
+                 static_cast<unsigned int>(size));
+    }
+    return ::operator new(size);
+}
+
+void release(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    PoolState& pools = state();
+    {
+        std::lock_guard<std::mutex> lock(pools.mutex);
+
+        bool pooled = true;
+        if (pools.small.owns(ptr)) {
+            pools.small.release(ptr);
+        } else if (pools.large.owns(ptr)) {
+            pools.large.release(ptr);
+        } else {
+            pooled = false;  // Heap fallback from allocate()
+        }
+
+        // Re-arm the warning once the pools have drained back below half
+        if (pools.exhaustionReported &&
+            pools.small.inUse() < SMALL_BLOCK_COUNT / 2 &&
+            pools.large.inUse() < LARGE_BLOCK_COUNT / 2) {
+            pools.exhaustionReported = false;
+        }
+
+        if (pooled) {
+            return;
+        }
+    }
+    ::operator delete(ptr);
+}
+
+EventPoolStats getStats() {
+    PoolState& pools = state();
+    std::lock_guard<std::mutex> lock(pools.mutex);
+
+    EventPoolStats stats;
+    stats.smallBlockSize = SMALL_BLOCK_SIZE;
+    stats.smallCapacity = SMALL_BLOCK_COUNT;
+    stats.smallInUse = pools.small.inUse();
+    stats.smallHighWater = pools.small.highWater();
+    stats.largeBlockSize = LARGE_BLOCK_SIZE;
+    stats.largeCapacity = LARGE_BLOCK_COUNT;
+    stats.largeInUse = pools.large.inUse();
+    stats.largeHighWater = pools.large.highWater();
+    stats.exhausted = pools.exhausted;
+    stats.oversize = pools.oversize;
+    return stats;
+}
+
+} // namespace EventPool
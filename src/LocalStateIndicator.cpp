@@ -22,7 +22,7 @@
 
 LocalStateIndicator::LocalStateIndicator(EventBus& eventBus) 
     : m_eventBus(eventBus), currentState(BridgeState::IDLE), isBlinking(false), 
-      lastBlinkTime(0), blinkState(false) {
+      blinkTimer(INVALID_TIMER_ID), blinkState(false) {
     LOG_INFO(Logger::TAG_LOC, "Initialised GlowBit Stick 1x8 indicator");
     
     // Initialise FastLED
@@ -30,21 +30,13 @@ LocalStateIndicator::LocalStateIndicator(EventBus& eventBus)
     FastLED.setBrightness(BRIGHTNESS);
     
     // Subscribe to STATE_CHANGED events
-    auto stateCallback = [this](EventData* eventData) {
-        if (!eventData) return;
-        
-        if (eventData->getEventEnum() == BridgeEvent::STATE_CHANGED) {
-            StateChangeData* stateData = static_cast<StateChangeData*>(eventData);
-            if (stateData) {
-                currentState = stateData->getNewState();
-                LOG_INFO(Logger::TAG_LOC, "State changed to: %s", 
-                        BridgeStateMachine::stateName(currentState));
-                setState();
-            }
-        }
-    };
-    
-    m_eventBus.subscribe(BridgeEvent::STATE_CHANGED, stateCallback);
+    EventBus::SubscriberLabel label(m_eventBus, "LocalStateIndicator");
+    m_eventBus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED, [this](const StateChangeData& stateData) {
+        currentState = stateData.getNewState();
+        LOG_INFO(Logger::TAG_LOC, "State changed to: %s", 
+                BridgeStateMachine::stateName(currentState));
+        setState();
+    });
 }
 
 void LocalStateIndicator::begin() {
@@ -70,23 +62,19 @@ void LocalStateIndicator::setState() {
     
     if (isBlinking) {
         setBlinkingColor(color);
+        // Keep the running blink cadence across state changes; start one if idle
+        if (blinkTimer == INVALID_TIMER_ID) {
+            blinkTimer = m_eventBus.callAfter(BLINK_INTERVAL_MS, [this]() { onBlinkTimer(); });
+        }
     } else {
         setSolidColor(color);
     }
     
     // Publish success event
-    auto* indicatorData = new SimpleEventData(BridgeEvent::INDICATOR_UPDATE_SUCCESS);
-    m_eventBus.publish(BridgeEvent::INDICATOR_UPDATE_SUCCESS, indicatorData);
+    m_eventBus.emplace<SimpleEventData>(BridgeEvent::INDICATOR_UPDATE_SUCCESS);
     LOG_DEBUG(Logger::TAG_LOC, "LED display updated successfully");
 }
 
-void LocalStateIndicator::update() {
-    // Handle blinking for states that need it
-    if (isBlinking) {
-        updateBlinking();
-    }
-}
-
 void LocalStateIndicator::halt() {
     LOG_WARN(Logger::TAG_LOC, "EMERGENCY HALT - setting display to FAULT state");
     
@@ -104,7 +92,7 @@ void LocalStateIndicator::setSolidColor(CRGB color) {
 }
 
 void LocalStateIndicator::setBlinkingColor(CRGB color) {
-    // For blinking, we'll handle the on/off in updateBlinking()
+    // For blinking, the on/off toggling is handled in onBlinkTimer()
     // This just sets the colour when it should be on
     if (blinkState) {
         setSolidColor(color);
@@ -114,20 +102,22 @@ void LocalStateIndicator::setBlinkingColor(CRGB color) {
     }
 }
 
-void LocalStateIndicator::updateBlinking() {
-    unsigned long now = millis();
-    if (now - lastBlinkTime >= 500) {  // 1 Hz blink (500ms on, 500ms off)
-        blinkState = !blinkState;
-        lastBlinkTime = now;
-        
-        CRGB color = getStateColor(currentState);
-        if (blinkState) {
-            setSolidColor(color);
-        } else {
-            FastLED.clear();
-            FastLED.show();
-        }
+void LocalStateIndicator::onBlinkTimer() {
+    blinkTimer = INVALID_TIMER_ID;
+    if (!isBlinking) {
+        return;  // Switched to a solid state - let the blink lapse
     }
+    
+    blinkState = !blinkState;
+    CRGB color = getStateColor(currentState);
+    if (blinkState) {
+        setSolidColor(color);
+    } else {
+        FastLED.clear();
+        FastLED.show();
+    }
+    
+    blinkTimer = m_eventBus.callAfter(BLINK_INTERVAL_MS, [this]() { onBlinkTimer(); });
 }
 
 void LocalStateIndicator::rainbowStartup() {
@@ -1,6 +1,7 @@
 #include "MotorControl.h"
 #include <Arduino.h>
 #include "EventBus.h"
+#include "Clock.h"
 #include "Logger.h"
 
 MotorControl::MotorControl(EventBus& eventBus)
@@ -90,7 +91,7 @@ void MotorControl::checkProgress() {
     }
 
     const bool limitActive = isLimitSwitchActive();
-    const unsigned long now = millis();
+    const unsigned long now = Clock::millis();
 
     if (!limitActive) {
         if (!m_limitCleared) {
@@ -125,8 +126,7 @@ void MotorControl::checkProgress() {
 
     BridgeEvent eventType = m_raisingBridge ? BridgeEvent::BRIDGE_OPENED_SUCCESS
                                             : BridgeEvent::BRIDGE_CLOSED_SUCCESS;
-    auto* eventData = new SimpleEventData(eventType);
-    m_eventBus.publish(eventType, eventData);
+    m_eventBus.emplace<SimpleEventData>(eventType);
     LOG_DEBUG(Logger::TAG_MC, "Success event published due to limit switch");
 }
 
@@ -11,7 +11,7 @@ SafetyManager::SafetyManager(EventBus &eventBus, CommandBus &commandBus)
       ,
       m_lastStateEvent(BridgeEvent::FAULT_CLEARED) // Safe initial value
       ,
-      m_stateEventTime(0), m_lastFaultReason("")
+      m_transitionTimer(INVALID_TIMER_ID), m_lastFaultReason("")
 {
 }
 
@@ -20,6 +20,7 @@ void SafetyManager::begin()
     LOG_INFO(Logger::TAG_SYS, "Initializing Safety Manager...");
 
     // Subscribe to all relevant events - must specify event type
+    EventBus::SubscriberLabel label(m_eventBus, "SafetyManager");
     m_eventBus.subscribe(BridgeEvent::BOAT_DETECTED, [this](EventData *data)
                          { this->onEvent(data); });
     m_eventBus.subscribe(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, [this](EventData *data)
@@ -33,7 +34,7 @@ void SafetyManager::begin()
     m_eventBus.subscribe(BridgeEvent::TRAFFIC_RESUMED_SUCCESS, [this](EventData *data)
                          { this->onEvent(data); });
     m_eventBus.subscribe(BridgeEvent::FAULT_DETECTED, [this](EventData *data)
-                         { this->onEvent(data); });
+                         { this->onEvent(data); }, EventPriority::EMERGENCY);
 
     // Subscribe to commands targeted for safety manager
     m_commandBus.subscribe(CommandTarget::SAFETY_MANAGER, [this](const Command &command)
@@ -42,18 +43,6 @@ void SafetyManager::begin()
     LOG_INFO(Logger::TAG_SYS, "Safety Manager initialized successfully");
 }
 
-void SafetyManager::update()
-{
-    // Skip safety checks in simulation mode
-    if (m_simulationMode)
-    {
-        return;
-    }
-
-    // Check state transition timeouts
-    checkStateTransitionTimeouts();
-}
-
 void SafetyManager::triggerEmergency(const char *reason)
 {
     // std::lock_guard<std::mutex> lock(m_mutex);
@@ -88,8 +77,7 @@ void SafetyManager::clearEmergency()
         m_emergencyActive = false;
 
         LOG_INFO(Logger::TAG_SYS, "Requesting system reset following emergency clear");
-        auto *resetData = new SimpleEventData(BridgeEvent::SYSTEM_RESET_REQUESTED);
-        m_eventBus.publish(BridgeEvent::SYSTEM_RESET_REQUESTED, resetData, EventPriority::EMERGENCY);
+        m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::SYSTEM_RESET_REQUESTED);
     }
 }
 
@@ -154,37 +142,48 @@ void SafetyManager::enterSafeState(const char *reason)
     }
 
     // Publish fault event with high priority
-    EventData *faultData = new SimpleEventData(BridgeEvent::FAULT_DETECTED);
-    m_eventBus.publish(BridgeEvent::FAULT_DETECTED, faultData, EventPriority::EMERGENCY);
+    m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
 }
 
-void SafetyManager::checkStateTransitionTimeouts()
+void SafetyManager::startTransitionTimer(BridgeEvent stateEvent)
 {
-    // Skip if no valid state event recorded or in emergency already
-    if (m_stateEventTime == 0 || m_emergencyActive)
+    m_lastStateEvent = stateEvent;
+    m_eventBus.cancelTimer(m_transitionTimer);
+    // Timeout is exceeded once more than getStateTimeout() ms have passed
+    m_transitionTimer = m_eventBus.callAfter(getStateTimeout(stateEvent) + 1, [this]()
+                                             { this->onStateTransitionTimeout(); });
+    LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
+             bridgeEventToString(stateEvent), getStateTimeout(stateEvent));
+}
+
+void SafetyManager::stopTransitionTimer()
+{
+    m_eventBus.cancelTimer(m_transitionTimer);
+    m_transitionTimer = INVALID_TIMER_ID;
+}
+
+void SafetyManager::onStateTransitionTimeout()
+{
+    m_transitionTimer = INVALID_TIMER_ID;
+
+    // Skip safety checks in simulation mode or in emergency already
+    if (m_simulationMode || m_emergencyActive)
     {
         return;
     }
 
-    unsigned long elapsed = millis() - m_stateEventTime;
     unsigned long timeout = getStateTimeout(m_lastStateEvent);
+    BridgeEvent expectedNext = getExpectedNextEvent(m_lastStateEvent);
 
-    // If timeout occurred
-    if (elapsed > timeout)
-    {
-        BridgeEvent expectedNext = getExpectedNextEvent(m_lastStateEvent);
-
-        // Build error message without String concatenation issues
-        char reason[200];
-        snprintf(reason, sizeof(reason), "State transition timeout: Event %s did not transition to %s within %lums",
-                 bridgeEventToString(m_lastStateEvent),
-                 bridgeEventToString(expectedNext),
-                 timeout);
-
-        LOG_ERROR(Logger::TAG_SYS, "%s", reason);
-        triggerEmergency(reason);
-        m_stateEventTime = 0; // Reset timer
-    }
+    // Build error message without String concatenation issues
+    char reason[200];
+    snprintf(reason, sizeof(reason), "State transition timeout: Event %s did not transition to %s within %lums",
+             bridgeEventToString(m_lastStateEvent),
+             bridgeEventToString(expectedNext),
+             timeout);
+
+    LOG_ERROR(Logger::TAG_SYS, "%s", reason);
+    triggerEmergency(reason);
 }
 
 void SafetyManager::onEvent(EventData *data)
@@ -196,25 +195,19 @@ void SafetyManager::onEvent(EventData *data)
     {
     case BridgeEvent::BOAT_DETECTED:
         // Start monitoring for expected next state
-        m_lastStateEvent = event;
-        m_stateEventTime = millis();
-        LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
-                 bridgeEventToString(event), getStateTimeout(event));
+        startTransitionTimer(event);
         break;
 
     case BridgeEvent::TRAFFIC_STOPPED_SUCCESS:
         // If monitoring from BOAT_DETECTED, clear timer
         if (m_lastStateEvent == BridgeEvent::BOAT_DETECTED)
         {
-            m_stateEventTime = 0; // Clear timer
+            stopTransitionTimer();
         }
         else
         {
             // Otherwise, start monitoring for next state
-            m_lastStateEvent = event;
-            m_stateEventTime = millis();
-            LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
-                     bridgeEventToString(event), getStateTimeout(event));
+            startTransitionTimer(event);
         }
         break;
 
@@ -222,15 +215,12 @@ void SafetyManager::onEvent(EventData *data)
         // If monitoring from TRAFFIC_STOPPED_SUCCESS, clear timer
         if (m_lastStateEvent == BridgeEvent::TRAFFIC_STOPPED_SUCCESS)
         {
-            m_stateEventTime = 0; // Clear timer
+            stopTransitionTimer();
         }
         else
         {
             // Otherwise, start monitoring for next state
-            m_lastStateEvent = event;
-            m_stateEventTime = millis();
-            LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
-                     bridgeEventToString(event), getStateTimeout(event));
+            startTransitionTimer(event);
         }
         break;
 
@@ -238,15 +228,12 @@ void SafetyManager::onEvent(EventData *data)
         // If monitoring from BRIDGE_OPENED_SUCCESS, clear timer
         if (m_lastStateEvent == BridgeEvent::BRIDGE_OPENED_SUCCESS)
         {
-            m_stateEventTime = 0; // Clear timer
+            stopTransitionTimer();
         }
         else
         {
             // Otherwise, start monitoring for next state
-            m_lastStateEvent = event;
-            m_stateEventTime = millis();
-            LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
-                     bridgeEventToString(event), getStateTimeout(event));
+            startTransitionTimer(event);
         }
         break;
 
@@ -254,15 +241,12 @@ void SafetyManager::onEvent(EventData *data)
         // If monitoring from BOAT_PASSED, clear timer
         if (m_lastStateEvent == BridgeEvent::BOAT_PASSED)
         {
-            m_stateEventTime = 0; // Clear timer
+            stopTransitionTimer();
         }
         else
         {
             // Otherwise, start monitoring for next state
-            m_lastStateEvent = event;
-            m_stateEventTime = millis();
-            LOG_INFO(Logger::TAG_SYS, "Monitoring state transition from %s (timeout: %lums)",
-                     bridgeEventToString(event), getStateTimeout(event));
+            startTransitionTimer(event);
         }
         break;
 
@@ -270,7 +254,7 @@ void SafetyManager::onEvent(EventData *data)
         // If monitoring from BRIDGE_CLOSED_SUCCESS, clear timer
         if (m_lastStateEvent == BridgeEvent::BRIDGE_CLOSED_SUCCESS)
         {
-            m_stateEventTime = 0; // Clear timer
+            stopTransitionTimer();
         }
         break;
 
@@ -391,12 +375,10 @@ void SafetyManager::clearTestFault()
         LOG_WARN(Logger::TAG_SAFE, "SignalControl reference null during fault clear - traffic lights unchanged.");
     }
 
-    auto *faultCleared = new SimpleEventData(BridgeEvent::FAULT_CLEARED);
-    m_eventBus.publish(BridgeEvent::FAULT_CLEARED, faultCleared, EventPriority::EMERGENCY);
+    m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_CLEARED);
 
     LOG_INFO(Logger::TAG_SAFE, "Publishing system reset request after test fault clear");
-    auto *resetRequest = new SimpleEventData(BridgeEvent::SYSTEM_RESET_REQUESTED);
-    m_eventBus.publish(BridgeEvent::SYSTEM_RESET_REQUESTED, resetRequest, EventPriority::EMERGENCY);
+    m_eventBus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::SYSTEM_RESET_REQUESTED);
 }
 
 bool SafetyManager::isTestFaultActive() const
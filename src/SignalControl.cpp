@@ -1,6 +1,7 @@
 #include "SignalControl.h"
 #include "BridgeSystemDefs.h"
 #include <Arduino.h>
+#include "Clock.h"
 #include "Logger.h"
 
 /*
@@ -93,9 +94,9 @@ SignalControl::SignalControl(EventBus& eventBus)
       m_currentOperation(Operation::NONE),
       m_stopPhase(StopPhase::COMPLETE),
       m_resumePhase(ResumePhase::COMPLETE),
-      m_operationStartTime(0),
+      m_operationTimer(INVALID_TIMER_ID),
       m_boatQueueActive(false),
-      m_boatQueueStartTime(0),
+      m_boatQueueTimer(INVALID_TIMER_ID),
       m_boatQueueSide(""),
       m_pedestrianTimerStartTime(0) {
     LOG_INFO(Logger::TAG_SC, "Initialised");
@@ -113,13 +114,14 @@ void SignalControl::begin() {
 void SignalControl::stopTraffic() {
     ensurePins();
     
-    // Start phased stopping operation
+    // Start phased stopping operation (replaces any stop/resume still in progress)
+    cancelOperationTimer();
     m_currentOperation = Operation::STOPPING_TRAFFIC;
     m_stopPhase = StopPhase::YELLOW_WARNING;
-    m_operationStartTime = millis();
+    m_operationTimer = m_eventBus.callAfter(YELLOW_WARNING_MS, [this]() { onOperationPhaseElapsed(); });
     
     // Start pedestrian crossing timer for frontend countdown
-    m_pedestrianTimerStartTime = millis();
+    m_pedestrianTimerStartTime = Clock::millis();
     
     // Green→Yellow (warning begins)
     LOG_INFO(Logger::TAG_SC, "Stopping traffic - Phase 1: car=YELLOW (warning) - pedestrian crossing timer started");
@@ -128,19 +130,19 @@ void SignalControl::stopTraffic() {
     driveBoat(BOAT_RIGHT, "Red");
     
     // Publish car light change event for frontend updates
-    auto* yellowData = new LightChangeData("both", "Yellow", true);
-    m_eventBus.publish(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, yellowData);
+    m_eventBus.emplace<LightChangeData>("both", "Yellow", true);
     
-    // SUCCESS event will be published by update() after 12 seconds
+    // SUCCESS event will be published by the phase timer after 12 seconds
 }
 
 void SignalControl::resumeTraffic() {
     ensurePins();
     
     // Start delayed resume operation
+    cancelOperationTimer();
     m_currentOperation = Operation::RESUMING_TRAFFIC;
     m_resumePhase = ResumePhase::RED_WAITING;
-    m_operationStartTime = millis();
+    m_operationTimer = m_eventBus.callAfter(RESUME_RED_HOLD_MS, [this]() { onOperationPhaseElapsed(); });
     
     // T+0s: Keep Red (preparing to resume)
     LOG_INFO(Logger::TAG_SC, "Resuming traffic - Phase 1: car=RED (preparing)");
@@ -148,13 +150,28 @@ void SignalControl::resumeTraffic() {
     driveBoat(BOAT_LEFT, "Red");
     driveBoat(BOAT_RIGHT, "Red");
     
-    // GREEN and SUCCESS event will be published by update() after 2 seconds
+    // GREEN and SUCCESS event will be published by the phase timer after 2 seconds
 }
 
 void SignalControl::halt() {
     // Emergency: force all signals into a safe state (RED for car and boat).
     ensurePins();
     LOG_WARN(Logger::TAG_SC, "EMERGENCY HALT - all signals RED");
+
+    // Abandon any stop/resume or boat green period still in progress, so no pending phase
+    // drives a light or reports SUCCESS while the bridge is in FAULT
+    cancelOperationTimer();
+    m_currentOperation = Operation::NONE;
+    m_stopPhase = StopPhase::COMPLETE;
+    m_resumePhase = ResumePhase::COMPLETE;
+
+    m_eventBus.cancelTimer(m_boatQueueTimer);
+    m_boatQueueTimer = INVALID_TIMER_ID;
+    m_boatQueueActive = false;
+    m_boatQueueSide = "";
+
+    m_pedestrianTimerStartTime = 0;
+
     allSafeRed();
     LOG_WARN(Logger::TAG_SC, "All signals set to safe state");
 }
@@ -164,13 +181,14 @@ void SignalControl::resetToIdleState() {
 
     LOG_INFO(Logger::TAG_SC, "Resetting signals to idle defaults (car=GREEN, boats=RED)");
 
+    cancelOperationTimer();
     m_currentOperation = Operation::NONE;
     m_stopPhase = StopPhase::COMPLETE;
     m_resumePhase = ResumePhase::COMPLETE;
-    m_operationStartTime = 0;
 
+    m_eventBus.cancelTimer(m_boatQueueTimer);
+    m_boatQueueTimer = INVALID_TIMER_ID;
     m_boatQueueActive = false;
-    m_boatQueueStartTime = 0;
     m_boatQueueSide = "";
     
     m_pedestrianTimerStartTime = 0;
@@ -182,51 +200,38 @@ void SignalControl::resetToIdleState() {
     LOG_INFO(Logger::TAG_SC, "Signals reset complete");
 }
 
-void SignalControl::update() {
-    // Check boat queue timer first
-    if (m_boatQueueActive) {
-        unsigned long queueElapsed = millis() - m_boatQueueStartTime;
-        if (queueElapsed >= BOAT_GREEN_PERIOD_MS) {
-            LOG_INFO(Logger::TAG_SC, "Boat green period expired (45s) - turning lights RED");
-            endBoatGreenPeriod();
-            
-            // Publish event to notify state machine
-            auto* expiredData = new SimpleEventData(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED);
-            m_eventBus.publish(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED, expiredData);
-        }
-    }
-    
-    if (m_currentOperation == Operation::NONE) {
-        return;  // No operation in progress
-    }
+void SignalControl::onBoatGreenPeriodElapsed() {
+    m_boatQueueTimer = INVALID_TIMER_ID;
+    LOG_INFO(Logger::TAG_SC, "Boat green period expired (45s) - turning lights RED");
+    endBoatGreenPeriod();
     
-    unsigned long elapsed = millis() - m_operationStartTime;
+    // Publish event to notify state machine
+    m_eventBus.emplace<SimpleEventData>(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED);
+}
+
+void SignalControl::onOperationPhaseElapsed() {
+    m_operationTimer = INVALID_TIMER_ID;
     
     if (m_currentOperation == Operation::STOPPING_TRAFFIC) {
         switch (m_stopPhase) {
-            case StopPhase::YELLOW_WARNING:
-                if (elapsed >= 6000) {  // 6 seconds yellow warning
-                    LOG_INFO(Logger::TAG_SC, "Stopping traffic - Phase 2: car=RED (clearance)");
-                    driveCar(CAR, "Red");
-                    // Publish car light change event for frontend updates
-                    auto* redData = new LightChangeData("both", "Red", true);
-                    m_eventBus.publish(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, redData);
-                    m_stopPhase = StopPhase::RED_CLEARANCE;
-                }
+            case StopPhase::YELLOW_WARNING:  // 6 seconds yellow warning
+                LOG_INFO(Logger::TAG_SC, "Stopping traffic - Phase 2: car=RED (clearance)");
+                driveCar(CAR, "Red");
+                // Publish car light change event for frontend updates
+                m_eventBus.emplace<LightChangeData>("both", "Red", true);
+                m_stopPhase = StopPhase::RED_CLEARANCE;
+                m_operationTimer = m_eventBus.callAfter(RED_CLEARANCE_MS, [this]() { onOperationPhaseElapsed(); });
                 break;
                 
-            case StopPhase::RED_CLEARANCE:
-                if (elapsed >= 12000) {  // 12 seconds total (6s yellow + 6s red)
-                    LOG_INFO(Logger::TAG_SC, "Traffic stopped successfully (12s pedestrian crossing time)");
-                    
-                    // Reset pedestrian timer (crossing period complete)
-                    m_pedestrianTimerStartTime = 0;
-                    
-                    auto* stoppedData = new SimpleEventData(BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
-                    m_eventBus.publish(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, stoppedData);
-                    m_stopPhase = StopPhase::COMPLETE;
-                    m_currentOperation = Operation::NONE;
-                }
+            case StopPhase::RED_CLEARANCE:  // 12 seconds total (6s yellow + 6s red)
+                LOG_INFO(Logger::TAG_SC, "Traffic stopped successfully (12s pedestrian crossing time)");
+                
+                // Reset pedestrian timer (crossing period complete)
+                m_pedestrianTimerStartTime = 0;
+                
+                m_eventBus.emplace<SimpleEventData>(BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
+                m_stopPhase = StopPhase::COMPLETE;
+                m_currentOperation = Operation::NONE;
                 break;
                 
             case StopPhase::COMPLETE:
@@ -237,21 +242,17 @@ void SignalControl::update() {
     else if (m_currentOperation == Operation::RESUMING_TRAFFIC) {
         switch (m_resumePhase) {
             case ResumePhase::RED_WAITING:
-                if (elapsed >= 2000) {  
-                    LOG_INFO(Logger::TAG_SC, "Resuming traffic - Phase 2: car=GREEN");
-                    driveCar(CAR, "Green");
-                    
-                    // Publish car light change event for frontend updates
-                    auto* greenData = new LightChangeData("both", "Green", true);
-                    m_eventBus.publish(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, greenData);
-                    
-                    LOG_INFO(Logger::TAG_SC, "Traffic resumed successfully");
-                    auto* resumedData = new SimpleEventData(BridgeEvent::TRAFFIC_RESUMED_SUCCESS);
-                    m_eventBus.publish(BridgeEvent::TRAFFIC_RESUMED_SUCCESS, resumedData);
-                    
-                    m_resumePhase = ResumePhase::GREEN_GO;
-                    m_currentOperation = Operation::NONE;
-                }
+                LOG_INFO(Logger::TAG_SC, "Resuming traffic - Phase 2: car=GREEN");
+                driveCar(CAR, "Green");
+                
+                // Publish car light change event for frontend updates
+                m_eventBus.emplace<LightChangeData>("both", "Green", true);
+                
+                LOG_INFO(Logger::TAG_SC, "Traffic resumed successfully");
+                m_eventBus.emplace<SimpleEventData>(BridgeEvent::TRAFFIC_RESUMED_SUCCESS);
+                
+                m_resumePhase = ResumePhase::GREEN_GO;
+                m_currentOperation = Operation::NONE;
                 break;
                 
             case ResumePhase::GREEN_GO:
@@ -262,6 +263,11 @@ void SignalControl::update() {
     }
 }
 
+void SignalControl::cancelOperationTimer() {
+    m_eventBus.cancelTimer(m_operationTimer);
+    m_operationTimer = INVALID_TIMER_ID;
+}
+
 void SignalControl::setCarTraffic(const String& color) {
     // Set both car lights to the same colour
     ensurePins();
@@ -273,8 +279,7 @@ void SignalControl::setCarTraffic(const String& color) {
     LOG_INFO(Logger::TAG_SC, "Car traffic updated successfully");
     
     // Publish single success event for car traffic (not separate left/right)
-    auto* carTrafficData = new LightChangeData("both", color, true);
-    m_eventBus.publish(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, carTrafficData);
+    m_eventBus.emplace<LightChangeData>("both", color, true);
 }
 
 void SignalControl::setBoatLight(const String& side, const String& color) {
@@ -290,8 +295,7 @@ void SignalControl::setBoatLight(const String& side, const String& color) {
     LOG_INFO(Logger::TAG_SC, "Boat light updated successfully");
     
     // Publish success event with light change data
-    auto* lightData = new LightChangeData(side, color, false);  // false = boat light
-    m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, lightData);
+    m_eventBus.emplace<LightChangeData>(side, color, false);  // false = boat light
 }
 
 void SignalControl::startBoatGreenPeriod(const String& side) {
@@ -309,23 +313,19 @@ void SignalControl::startBoatGreenPeriod(const String& side) {
         driveBoat(BOAT_LEFT, "Green");
         driveBoat(BOAT_RIGHT, "Red");
         // Publish light change events so StateWriter tracks them correctly
-        auto* leftData = new LightChangeData("left", "Green", false);
-        m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, leftData);
-        auto* rightData = new LightChangeData("right", "Red", false);
-        m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, rightData);
+        m_eventBus.emplace<LightChangeData>("left", "Green", false);
+        m_eventBus.emplace<LightChangeData>("right", "Red", false);
     } else if (lower(side) == "right") {
         driveBoat(BOAT_RIGHT, "Green");
         driveBoat(BOAT_LEFT, "Red");
         // Publish light change events so StateWriter tracks them correctly
-        auto* rightData = new LightChangeData("right", "Green", false);
-        m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, rightData);
-        auto* leftData = new LightChangeData("left", "Red", false);
-        m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, leftData);
+        m_eventBus.emplace<LightChangeData>("right", "Green", false);
+        m_eventBus.emplace<LightChangeData>("left", "Red", false);
     }
     
     // Start queue timer
     m_boatQueueActive = true;
-    m_boatQueueStartTime = millis();
+    m_boatQueueTimer = m_eventBus.callAfter(BOAT_GREEN_PERIOD_MS, [this]() { onBoatGreenPeriodElapsed(); });
     m_boatQueueSide = side;
     
     LOG_INFO(Logger::TAG_SC, "Boat queue timer started - boats can pass for 45 seconds");
@@ -345,14 +345,13 @@ void SignalControl::endBoatGreenPeriod() {
     driveBoat(BOAT_RIGHT, "Red");
     
     // Publish light change events so StateWriter tracks them correctly
-    auto* leftData = new LightChangeData("left", "Red", false);
-    m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, leftData);
-    auto* rightData = new LightChangeData("right", "Red", false);
-    m_eventBus.publish(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, rightData);
+    m_eventBus.emplace<LightChangeData>("left", "Red", false);
+    m_eventBus.emplace<LightChangeData>("right", "Red", false);
     
-    // Clear queue state
+    // Clear queue state (no-op on the timer if it is the one that just fired)
+    m_eventBus.cancelTimer(m_boatQueueTimer);
+    m_boatQueueTimer = INVALID_TIMER_ID;
     m_boatQueueActive = false;
-    m_boatQueueStartTime = 0;
     m_boatQueueSide = "";
     
     LOG_INFO(Logger::TAG_SC, "Boat queue timer ended - waiting for boat passage confirmation");
@@ -370,7 +369,7 @@ unsigned long SignalControl::getPedestrianTimerRemainingMs() const {
     if (m_pedestrianTimerStartTime == 0) {
         return 0;
     }
-    unsigned long elapsed = millis() - m_pedestrianTimerStartTime;
+    unsigned long elapsed = Clock::millis() - m_pedestrianTimerStartTime;
     if (elapsed >= PEDESTRIAN_CROSSING_TIME_MS) {
         return 0;
     }
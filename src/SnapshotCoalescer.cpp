@@ -0,0 +1,47 @@
+#include "SnapshotCoalescer.h"
+
+void SnapshotCoalescer::markDirty() {
+    version_.fetch_add(1, std::memory_order_release);
+    marked_.fetch_add(1, std::memory_order_relaxed);
+    wake_.notify();
+}
+
+bool SnapshotCoalescer::takeDue(uint32_t nowMs) {
+    if (msUntilDue(nowMs) != 0) {
+        return false;
+    }
+
+    // Everything up to this version is in the snapshot the caller is about to build
+    const uint32_t version = version_.load(std::memory_order_acquire);
+    const uint32_t pending = version - sentVersion_;
+    sentVersion_ = version;
+    lastSentMs_ = nowMs;
+    everSent_ = true;
+
+    sent_.fetch_add(1, std::memory_order_relaxed);
+    suppressed_.fetch_add(pending - 1, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t SnapshotCoalescer::msUntilDue(uint32_t nowMs) const {
+    if (version_.load(std::memory_order_acquire) == sentVersion_) {
+        return NOT_DIRTY;
+    }
+    if (!everSent_) {
+        return 0;
+    }
+    const uint32_t elapsed = nowMs - lastSentMs_;
+    const uint32_t interval = intervalMs();
+    return elapsed >= interval ? 0 : interval - elapsed;
+}
+
+SnapshotCoalescer::Stats SnapshotCoalescer::stats() const {
+    return Stats{marked_.load(std::memory_order_relaxed), sent_.load(std::memory_order_relaxed),
+                 suppressed_.load(std::memory_order_relaxed)};
+}
+
+void SnapshotCoalescer::resetStats() {
+    marked_.store(0, std::memory_order_relaxed);
+    sent_.store(0, std::memory_order_relaxed);
+    suppressed_.store(0, std::memory_order_relaxed);
+}
@@ -1,9 +1,77 @@
 #include "StateWriter.h"
+#include "Clock.h"
 #include "Logger.h"
 #include "ConsoleCommands.h"
 #include "SignalControl.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 
-StateWriter::StateWriter(EventBus& bus) : bus_(bus) {}
+namespace {
+
+// Light changes name colours and sides as text, in either case: SignalControl and the UI
+// send "Red", the console "red"
+bool equalsIgnoreCase(const String& text, const char* name) {
+    const char* c = text.c_str();
+    for (; *c != '\0' && *name != '\0'; ++c, ++name) {
+        if (tolower(static_cast<unsigned char>(*c)) != tolower(static_cast<unsigned char>(*name))) return false;
+    }
+    return *c == *name;
+}
+
+bool parseColour(const String& text, LightColour& colour) {
+    for (uint8_t i = 0; i < sizeof(LIGHT_COLOUR_NAMES) / sizeof(LIGHT_COLOUR_NAMES[0]); ++i) {
+        if (equalsIgnoreCase(text, LIGHT_COLOUR_NAMES[i])) {
+            colour = static_cast<LightColour>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+LightSide parseSide(const String& text) {
+    if (equalsIgnoreCase(text, "left")) return LightSide::LEFT;
+    if (equalsIgnoreCase(text, "right")) return LightSide::RIGHT;
+    if (equalsIgnoreCase(text, "both")) return LightSide::BOTH;
+    return LightSide::NONE;
+}
+
+uint8_t logArg(LightColour colour) { return static_cast<uint8_t>(colour); }
+uint8_t logArg(LightSide side) { return static_cast<uint8_t>(side); }
+uint8_t logArg(BridgeState state) { return static_cast<uint8_t>(state); }
+uint8_t logArg(BridgeEvent event) { return static_cast<uint8_t>(event); }
+
+// Activity log arguments back to text; NO_ARG where a light event's text did not parse
+const char* colourArg(uint8_t arg) {
+    return arg < sizeof(LIGHT_COLOUR_NAMES) / sizeof(LIGHT_COLOUR_NAMES[0]) ? LIGHT_COLOUR_NAMES[arg] : "unknown";
+}
+const char* sideArg(uint8_t arg) {
+    return arg != 0 && arg < sizeof(LIGHT_SIDE_NAMES) / sizeof(LIGHT_SIDE_NAMES[0]) ? LIGHT_SIDE_NAMES[arg] : "unknown";
+}
+const char* onOffArg(uint8_t arg) { return arg ? "ON" : "OFF"; }
+
+// By StateWriter::ActivityText
+const char* const ACTIVITY_TEXTS[] = {
+    "Simulation mode ENABLED",
+    "Simulation mode DISABLED",
+    "Bridge opened",
+    "EMERGENCY: FAULT_DETECTED",
+    "System reports safe status",
+    "Command: SYSTEM_RESET_REQUESTED -> reset to idle defaults",
+    "Traffic stopped; car",
+    "Bridge closed; boat",
+    "Traffic resumed; car",
+};
+const char* textArg(uint8_t arg) {
+    return arg < sizeof(ACTIVITY_TEXTS) / sizeof(ACTIVITY_TEXTS[0]) ? ACTIVITY_TEXTS[arg] : "";
+}
+
+// Lines copied out of the log per read; keeps the copy on the network task's stack small
+constexpr size_t LOG_READ_CHUNK = 8;
+
+}  // namespace
+
+StateWriter::StateWriter(EventBus& bus, size_t logCapacity) : bus_(bus), log_(logCapacity) {}
 
 void StateWriter::attachConsole(ConsoleCommands* console) {
     console_ = console;
@@ -16,48 +84,60 @@ void StateWriter::attachSignalControl(SignalControl* signalControl) {
 // Below subscribes all events that the FSM / subsystems publish.
 void StateWriter::beginSubscriptions() {
     using E = BridgeEvent;
+    EventBus::SubscriberLabel label(bus_, "StateWriter");
+
+    // Payload-free events only need their type - one mask subscription covers them all
+    const EventMask payloadFreeEvents{
+        E::BOAT_DETECTED, E::BOAT_DETECTED_LEFT, E::BOAT_DETECTED_RIGHT,
+        E::BOAT_PASSED, E::BOAT_PASSED_LEFT, E::BOAT_PASSED_RIGHT,
+        E::FAULT_DETECTED, E::FAULT_CLEARED,
+        E::MANUAL_OVERRIDE_ACTIVATED, E::MANUAL_OVERRIDE_DEACTIVATED,
 
-    auto sub = [this](EventData* d){ this->onEvent(d); };
-
-    bus_.subscribe(E::BOAT_DETECTED, sub);
-    bus_.subscribe(E::BOAT_DETECTED_LEFT, sub);
-    bus_.subscribe(E::BOAT_DETECTED_RIGHT, sub);
-    bus_.subscribe(E::BOAT_PASSED, sub);
-    bus_.subscribe(E::BOAT_PASSED_LEFT, sub);
-    bus_.subscribe(E::BOAT_PASSED_RIGHT, sub);
-    bus_.subscribe(E::FAULT_DETECTED, sub);
-    bus_.subscribe(E::FAULT_CLEARED, sub);
-    bus_.subscribe(E::MANUAL_OVERRIDE_ACTIVATED, sub);
-    bus_.subscribe(E::MANUAL_OVERRIDE_DEACTIVATED, sub);
-
-    bus_.subscribe(E::TRAFFIC_STOPPED_SUCCESS, sub);
-    bus_.subscribe(E::BRIDGE_OPENED_SUCCESS, sub);
-    bus_.subscribe(E::BRIDGE_CLOSED_SUCCESS, sub);
-    bus_.subscribe(E::TRAFFIC_RESUMED_SUCCESS, sub);
-    bus_.subscribe(E::INDICATOR_UPDATE_SUCCESS, sub);
-    bus_.subscribe(E::SYSTEM_SAFE_SUCCESS, sub);
-    bus_.subscribe(E::CAR_LIGHT_CHANGED_SUCCESS, sub);
-    bus_.subscribe(E::BOAT_LIGHT_CHANGED_SUCCESS, sub);
-    bus_.subscribe(E::BOAT_GREEN_PERIOD_EXPIRED, sub);
-    bus_.subscribe(E::SYSTEM_RESET_REQUESTED, sub);
-    bus_.subscribe(E::SIMULATION_ENABLED, sub);
-    bus_.subscribe(E::SIMULATION_DISABLED, sub);
-    bus_.subscribe(E::SIMULATION_SENSOR_CONFIG_CHANGED, sub);
+        E::TRAFFIC_STOPPED_SUCCESS, E::BRIDGE_OPENED_SUCCESS, E::BRIDGE_CLOSED_SUCCESS,
+        E::TRAFFIC_RESUMED_SUCCESS, E::INDICATOR_UPDATE_SUCCESS, E::SYSTEM_SAFE_SUCCESS,
+        E::BOAT_GREEN_PERIOD_EXPIRED, E::SYSTEM_RESET_REQUESTED,
+        E::SIMULATION_ENABLED, E::SIMULATION_DISABLED
+    };
+    bus_.subscribe(payloadFreeEvents, [this](BridgeEvent ev, EventData*) { this->applyEvent(ev); });
+
+    // Events with a payload get it as a typed reference
+    bus_.subscribe<LightChangeData>(E::CAR_LIGHT_CHANGED_SUCCESS,
+        [this](const LightChangeData& d) { this->applyCarLight(d); });
+    bus_.subscribe<LightChangeData>(E::BOAT_LIGHT_CHANGED_SUCCESS,
+        [this](const LightChangeData& d) { this->applyBoatLight(d); });
+    bus_.subscribe<SimulationSensorConfigData>(E::SIMULATION_SENSOR_CONFIG_CHANGED,
+        [this](const SimulationSensorConfigData& d) { this->applySensorConfig(d); });
     
     // Subscribe to actual state changes from the state machine
-    bus_.subscribe(E::STATE_CHANGED, sub);
+    bus_.subscribe<StateChangeData>(E::STATE_CHANGED,
+        [this](const StateChangeData& d) { this->applyStateChange(d); });
 }
 
 void StateWriter::fillBridgeStatus(JsonObject obj) const {
-    std::lock_guard<std::mutex> lk(mu_);
-    obj["state"] = bridgeState_;
-    obj["lastChangeMs"] = bridgeLastChangeMs_;
-    obj["manualMode"]   = manualMode_;
+    fillBridgeStatus(obj, published_.load());
+}
+
+void StateWriter::fillCarTrafficStatus(JsonObject obj) const {
+    fillCarTrafficStatus(obj, published_.load());
+}
+
+void StateWriter::fillBoatTrafficStatus(JsonObject obj) const {
+    fillBoatTrafficStatus(obj, published_.load());
+}
+
+void StateWriter::fillSystemStatus(JsonObject obj) const {
+    fillSystemStatus(obj, published_.load());
+}
+
+void StateWriter::fillBridgeStatus(JsonObject obj, const UiState& s) const {
+    obj["state"] = toString(s.bridgeState);
+    obj["lastChangeMs"] = s.bridgeLastChangeMs;
+    obj["manualMode"]   = s.manualMode;
     
     // Include boat timer info if active
-    if (boatTimerStartMs_ > 0) {
-        obj["boatTimerStartMs"] = boatTimerStartMs_;
-        obj["boatTimerSide"] = boatTimerSide_;
+    if (s.boatTimerStartMs > 0) {
+        obj["boatTimerStartMs"] = s.boatTimerStartMs;
+        obj["boatTimerSide"] = toString(s.boatTimerSide);
     } else {
         obj["boatTimerStartMs"] = 0;
         obj["boatTimerSide"] = "";
@@ -73,31 +153,28 @@ void StateWriter::fillBridgeStatus(JsonObject obj) const {
     }
 }
 
-void StateWriter::fillCarTrafficStatus(JsonObject obj) const {
-    std::lock_guard<std::mutex> lk(mu_);
-    auto left = obj.createNestedObject("left");
-    left["value"] = carLeft_;
-    auto right = obj.createNestedObject("right");
-    right["value"] = carRight_;
+void StateWriter::fillCarTrafficStatus(JsonObject obj, const UiState& s) {
+    JsonObject left = obj["left"].to<JsonObject>();
+    left["value"] = toString(s.carLeft);
+    JsonObject right = obj["right"].to<JsonObject>();
+    right["value"] = toString(s.carRight);
 }
 
-void StateWriter::fillBoatTrafficStatus(JsonObject obj) const {
-    std::lock_guard<std::mutex> lk(mu_);
-    auto left = obj.createNestedObject("left");
-    left["value"] = boatLeft_;
-    auto right = obj.createNestedObject("right");
-    right["value"] = boatRight_;
+void StateWriter::fillBoatTrafficStatus(JsonObject obj, const UiState& s) {
+    JsonObject left = obj["left"].to<JsonObject>();
+    left["value"] = toString(s.boatLeft);
+    JsonObject right = obj["right"].to<JsonObject>();
+    right["value"] = toString(s.boatRight);
 }
 
-void StateWriter::fillSystemStatus(JsonObject obj) const {
-    std::lock_guard<std::mutex> lk(mu_);
+void StateWriter::fillSystemStatus(JsonObject obj, const UiState& s) const {
     obj["connection"] = "Connected";
-    obj["simulation"] = simulationMode_;
+    obj["simulation"] = s.simulationMode;
     obj["logLevel"] = Logger::levelToString(Logger::getLevel());
     JsonObject sensors = obj["simulationSensors"].to<JsonObject>();
-    sensors["ultrasonicLeft"] = simUltrasonicLeftEnabled_;
-    sensors["ultrasonicRight"] = simUltrasonicRightEnabled_;
-    sensors["beamBreak"] = simBeamBreakEnabled_;
+    sensors["ultrasonicLeft"] = s.simUltrasonicLeftEnabled;
+    sensors["ultrasonicRight"] = s.simUltrasonicRightEnabled;
+    sensors["beamBreak"] = s.simBeamBreakEnabled;
     
     // Ultrasonic streaming state
     if (console_) {
@@ -112,233 +189,480 @@ void StateWriter::buildSnapshot(JsonDocument& out) const {
     out["v"] = 1;
     out["type"] = "event";
     out["path"] = "/system/snapshot";
-    JsonObject p = out["payload"].to<JsonObject>();
+    fillSnapshot(out["payload"].to<JsonObject>());
+}
+
+void StateWriter::fillSnapshot(JsonObject p) const {
+    fillSnapshot(p, published_.load());
+}
+
+void StateWriter::fillSnapshot(JsonObject p, const UiState& s) const {
+    p["seq"] = s.version;
 
     // sections
     JsonObject bridge = p["bridge"].to<JsonObject>();
-    fillBridgeStatus(bridge);
+    fillBridgeStatus(bridge, s);
 
     JsonObject traffic = p["traffic"].to<JsonObject>();
-    fillCarTrafficStatus(traffic["car"].to<JsonObject>());
-    fillBoatTrafficStatus(traffic["boat"].to<JsonObject>());
+    fillCarTrafficStatus(traffic["car"].to<JsonObject>(), s);
+    fillBoatTrafficStatus(traffic["boat"].to<JsonObject>(), s);
 
     JsonObject system = p["system"].to<JsonObject>();
-    fillSystemStatus(system);
+    fillSystemStatus(system, s);
+
+    // Not the log itself: clients fetch the lines they lack with fillLog(); later lines
+    // come with the patches after this version
+    p["logNext"] = log_.firstSeqAfterVersion(s.version);
+}
 
-    JsonArray logArr = p["log"].to<JsonArray>();
-    {
-        std::lock_guard<std::mutex> lk(mu_);
-        for (const auto& s : log_) logArr.add(s);
+bool StateWriter::buildPatch(JsonDocument& out, uint32_t sinceVersion) const {
+    const UiState s = published_.load();
+    if (log_.droppedVersion() > sinceVersion) {
+        return false;
+    }
+    auto changed = [&s, sinceVersion](Section section) { return sectionVersion(s, section) > sinceVersion; };
+
+    out["v"] = 1;
+    out["type"] = "event";
+    out["path"] = "/system/patch";
+    JsonObject p = out["payload"].to<JsonObject>();
+    p["from"] = sinceVersion;
+    p["seq"] = s.version;
+
+    // Whole sections - a section is a handful of fields, not worth diffing further
+    if (changed(SECTION_BRIDGE)) {
+        fillBridgeStatus(p["bridge"].to<JsonObject>(), s);
+    }
+    if (changed(SECTION_CAR) || changed(SECTION_BOAT)) {
+        JsonObject traffic = p["traffic"].to<JsonObject>();
+        if (changed(SECTION_CAR)) fillCarTrafficStatus(traffic["car"].to<JsonObject>(), s);
+        if (changed(SECTION_BOAT)) fillBoatTrafficStatus(traffic["boat"].to<JsonObject>(), s);
+    }
+    if (changed(SECTION_SYSTEM)) {
+        fillSystemStatus(p["system"].to<JsonObject>(), s);
     }
+
+    JsonArray logArr;
+    ActivityLog::Entry entries[LOG_READ_CHUNK];
+    uint32_t seq = log_.firstSeqAfterVersion(sinceVersion);
+    for (;;) {
+        const size_t count = log_.read(seq, entries, LOG_READ_CHUNK);
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].version > s.version) return true;  // Next patch's
+            if (logArr.isNull()) logArr = p["log"].to<JsonArray>();
+            addLogLine(logArr, entries[i]);
+        }
+        if (count < LOG_READ_CHUNK) return true;
+        seq = entries[count - 1].seq + 1;
+    }
+}
+
+uint32_t StateWriter::version() const {
+    return published_.load().version;
 }
 
-std::vector<String> StateWriter::getActivityLog() const {
-    std::lock_guard<std::mutex> lk(mu_);
-    return log_;
+String StateWriter::bridgeStatusJson() const {
+    const UiState s = published_.load();
+    return cachedJson(CACHE_BRIDGE, sectionVersion(s, SECTION_BRIDGE), liveKey(SECTION_BRIDGE),
+                      [this, &s](JsonObject obj) { fillBridgeStatus(obj, s); });
 }
 
-void StateWriter::onEvent(EventData* data) {
-    if (!data) return;
-    applyEvent(data->getEventEnum(), data);
+String StateWriter::carTrafficStatusJson() const {
+    const UiState s = published_.load();
+    return cachedJson(CACHE_CAR, sectionVersion(s, SECTION_CAR), 0,
+                      [&s](JsonObject obj) { fillCarTrafficStatus(obj, s); });
 }
 
-void StateWriter::applyEvent(BridgeEvent ev, EventData* data) {
-    const uint32_t now = millis();
-    std::lock_guard<std::mutex> lk(mu_);
+String StateWriter::boatTrafficStatusJson() const {
+    const UiState s = published_.load();
+    return cachedJson(CACHE_BOAT, sectionVersion(s, SECTION_BOAT), 0,
+                      [&s](JsonObject obj) { fillBoatTrafficStatus(obj, s); });
+}
+
+String StateWriter::systemStatusJson() const {
+    const UiState s = published_.load();
+    return cachedJson(CACHE_SYSTEM, sectionVersion(s, SECTION_SYSTEM), liveKey(SECTION_SYSTEM),
+                      [this, &s](JsonObject obj) { fillSystemStatus(obj, s); });
+}
+
+String StateWriter::snapshotPayloadJson() const {
+    const UiState s = published_.load();
+    return cachedJson(CACHE_SNAPSHOT, s.version, liveKey(SECTION_BRIDGE | SECTION_SYSTEM),
+                      [this, &s](JsonObject obj) { fillSnapshot(obj, s); });
+}
+
+String StateWriter::snapshotJson() const {
+    // Same bytes as buildSnapshot(), around the cached payload
+    return String("{\"v\":1,\"type\":\"event\",\"path\":\"/system/snapshot\",\"payload\":") +
+           snapshotPayloadJson() + "}";
+}
+
+StateWriter::CacheStats StateWriter::cacheStats() const {
+    return CacheStats{cacheHits_.load(std::memory_order_relaxed), cacheMisses_.load(std::memory_order_relaxed)};
+}
+
+uint32_t StateWriter::sectionVersion(const UiState& s, Section section) {
+    for (size_t i = 0; i < UiState::SECTION_COUNT; ++i) {
+        if (section == (1u << i)) return s.sectionVersion[i];
+    }
+    return s.version;
+}
+
+// Values the sections show that no event versions. The pedestrian countdown (at most
+// PEDESTRIAN_CROSSING_TIME_MS, so 14 bits) only moves during the crossing window.
+uint64_t StateWriter::liveKey(uint8_t sections) const {
+    uint64_t key = 0;
+    if ((sections & SECTION_BRIDGE) && signalControl_ != nullptr) {
+        key |= static_cast<uint64_t>(static_cast<uint32_t>(signalControl_->getPedestrianTimerStartMs())) << 32;
+        key |= static_cast<uint64_t>(signalControl_->getPedestrianTimerRemainingMs() & 0x3FFF) << 10;
+    }
+    if (sections & SECTION_SYSTEM) {
+        key |= static_cast<uint64_t>(Logger::getLevel()) & 0xFF;
+        if (console_) {
+            key |= static_cast<uint64_t>(console_->isStreamingLeft()) << 8;
+            key |= static_cast<uint64_t>(console_->isStreamingRight()) << 9;
+        }
+    }
+    return key;
+}
+
+String StateWriter::cachedJson(CacheSlot slot, uint32_t version, uint64_t live,
+                               const std::function<void(JsonObject)>& fill) const {
+    std::lock_guard<std::mutex> lk(cacheMu_);
+    CachedJson& entry = cache_[slot];
+    if (entry.valid && entry.version == version && entry.live == live) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return entry.json;
+    }
+
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
+    DynamicJsonDocument doc(slot == CACHE_SNAPSHOT ? 4096 : 512);
+    fill(doc.to<JsonObject>());
+    entry.json = String();
+    serializeJson(doc, entry.json);
+    entry.version = version;
+    entry.live = live;
+    entry.valid = true;
+    return entry.json;
+}
+
+void StateWriter::fillLog(JsonObject p, uint32_t sinceSeq) const {
+    uint32_t from;
+    if (sinceSeq == LOG_LATEST) {
+        const uint32_t next = log_.nextSeq();
+        from = next > LOG_PAGE_LINES ? next - static_cast<uint32_t>(LOG_PAGE_LINES) : 0;
+    } else {
+        from = sinceSeq + 1;
+    }
+
+    JsonArray lines = p["lines"].to<JsonArray>();
+    ActivityLog::Entry entries[LOG_READ_CHUNK];
+    uint32_t seq = from;
+    uint32_t firstCopied = 0;
+    size_t copied = 0;
+    while (copied < LOG_PAGE_LINES) {
+        const size_t want = std::min(LOG_READ_CHUNK, LOG_PAGE_LINES - copied);
+        const size_t count = log_.read(seq, entries, want);
+        if (count == 0) break;
+        if (copied == 0) firstCopied = entries[0].seq;
+        for (size_t i = 0; i < count; ++i) addLogLine(lines, entries[i]);
+        copied += count;
+        seq = entries[count - 1].seq + 1;
+    }
+
+    // Read after the lines: anything pushed meanwhile shows up as "more"
+    const uint32_t next = log_.nextSeq();
+    const uint32_t firstHeld = copied ? firstCopied : std::max(from, log_.firstSeq());
+    const bool latest = sinceSeq == LOG_LATEST;
+    p["since"] = latest ? -1 : static_cast<int64_t>(sinceSeq);
+    p["next"] = next;
+    p["dropped"] = (!latest && firstHeld > from) ? firstHeld - from : 0;  // Overwritten before this read
+    p["more"] = seq < next;
+}
+
+void StateWriter::applyStateChange(const StateChangeData& stateData) {
+    const uint32_t now = Clock::millis();
+
+    const BridgeState previousState = stateData.getPreviousState();
+    const BridgeState newState = stateData.getNewState();
+    state_.bridgeState = newState;
+    state_.bridgeLastChangeMs = now;
+    touch(SECTION_BRIDGE);
+    
+    // Pedestrian timer is now read directly from SignalControl in fillBridgeStatus()
+    // No need to track it here
+    
+    if (newState != previousState) {
+        pushLog(ACT_STATE_CHANGED, logArg(previousState), logArg(newState));
+    }
+    publish();
+}
+
+void StateWriter::applySensorConfig(const SimulationSensorConfigData& cfgData) {
+    state_.simUltrasonicLeftEnabled = cfgData.isUltrasonicLeftEnabled();
+    state_.simUltrasonicRightEnabled = cfgData.isUltrasonicRightEnabled();
+    state_.simBeamBreakEnabled = cfgData.isBeamBreakEnabled();
+    touch(SECTION_SYSTEM);
+    pushLog(ACT_SENSORS, state_.simUltrasonicLeftEnabled, state_.simUltrasonicRightEnabled,
+            state_.simBeamBreakEnabled);
+    publish();
+}
+
+void StateWriter::applyCarLight(const LightChangeData& lightData) {
+    // Handle car light changes; support combined updates via side="both"
+    const LightSide side = parseSide(lightData.getSide());
+    LightColour colour;
+    uint8_t colourLog = ActivityLog::NO_ARG;
+    if (parseColour(lightData.getColor(), colour)) {
+        if (side == LightSide::LEFT || side == LightSide::BOTH) state_.carLeft = colour;
+        if (side == LightSide::RIGHT || side == LightSide::BOTH) state_.carRight = colour;
+        touch(SECTION_CAR);
+        colourLog = logArg(colour);
+    }
+    if (side == LightSide::BOTH) {
+        pushLog(ACT_CAR_LIGHTS, colourLog);
+    } else {
+        pushLog(ACT_CAR_LIGHT, logArg(side), colourLog);
+    }
+    publish();
+}
+
+void StateWriter::applyBoatLight(const LightChangeData& lightData) {
+    const uint32_t now = Clock::millis();
+
+    // Handle individual boat light changes
+    const LightSide side = parseSide(lightData.getSide());
+    LightColour colour;
+    uint8_t colourLog = ActivityLog::NO_ARG;
+    if (parseColour(lightData.getColor(), colour)) {
+        if (side == LightSide::LEFT) {
+            state_.boatLeft = colour;
+        } else if (side == LightSide::RIGHT) {
+            state_.boatRight = colour;
+        }
+
+        // Track boat timer: if a side turns green, start timer. If both turn red, stop timer.
+        if (colour == LightColour::GREEN) {
+            state_.boatTimerStartMs = now;
+            state_.boatTimerSide = side;
+        } else if (colour == LightColour::RED &&
+                   (state_.boatLeft == LightColour::RED && state_.boatRight == LightColour::RED)) {
+            // Both lights red = timer inactive
+            state_.boatTimerStartMs = 0;
+            state_.boatTimerSide = LightSide::NONE;
+        }
+        touch(SECTION_BOAT | SECTION_BRIDGE);  // The boat timer is part of the bridge section
+        colourLog = logArg(colour);
+    }
+
+    pushLog(ACT_BOAT_LIGHT, logArg(side), colourLog);
+    publish();
+}
+
+void StateWriter::applyEvent(BridgeEvent ev) {
+    const uint32_t now = Clock::millis();
 
     switch (ev) {
-        case BridgeEvent::STATE_CHANGED:
-            // Handle actual state changes from the state machine
-            if (data && data->getEventEnum() == BridgeEvent::STATE_CHANGED) {
-                // Safe cast
-                auto* stateData = static_cast<StateChangeData*>(data);
-                const BridgeState previousState = stateData->getPreviousState();
-                const BridgeState newState = stateData->getNewState();
-                bridgeState_ = stateToString(newState);
-                bridgeLastChangeMs_ = now;
-                
-                // Pedestrian timer is now read directly from SignalControl in fillBridgeStatus()
-                // No need to track it here
-                
-                if (newState != previousState) {
-                    pushLog(String("Bridge state changed: ") + stateToString(previousState) +
-                            " -> " + stateToString(newState));
-                }
-            }
-            break;
         case BridgeEvent::SIMULATION_ENABLED:
-            simulationMode_ = true;
-            pushLog("Simulation mode ENABLED");
+            state_.simulationMode = true;
+            touch(SECTION_SYSTEM);
+            pushLog(ACT_TEXT, TEXT_SIMULATION_ENABLED);
             break;
         case BridgeEvent::SIMULATION_DISABLED:
-            simulationMode_ = false;
-            pushLog("Simulation mode DISABLED");
-            break;
-        case BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED:
-            if (data && data->getEventEnum() == BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED) {
-                auto* cfgData = static_cast<SimulationSensorConfigData*>(data);
-                simUltrasonicLeftEnabled_ = cfgData->isUltrasonicLeftEnabled();
-                simUltrasonicRightEnabled_ = cfgData->isUltrasonicRightEnabled();
-                simBeamBreakEnabled_ = cfgData->isBeamBreakEnabled();
-                pushLog(String("Simulation sensors updated: UL=") + (simUltrasonicLeftEnabled_ ? "ON" : "OFF") +
-                        ", UR=" + (simUltrasonicRightEnabled_ ? "ON" : "OFF") +
-                        ", Beam=" + (simBeamBreakEnabled_ ? "ON" : "OFF"));
-            }
-            break;
-            
+            state_.simulationMode = false;
+            touch(SECTION_SYSTEM);
+            pushLog(ACT_TEXT, TEXT_SIMULATION_DISABLED);
+            break;
         case BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED:
             // Log the request but don't change state - wait for STATE_CHANGED
-            pushLog("Request: MANUAL_BRIDGE_OPEN_REQUESTED");
+            pushLog(ACT_REQUEST, logArg(ev));
             break;
         case BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED:
             // Log the request but don't change state - wait for STATE_CHANGED
-            pushLog("Request: MANUAL_BRIDGE_CLOSE_REQUESTED");
+            pushLog(ACT_REQUEST, logArg(ev));
             break;
         case BridgeEvent::MANUAL_TRAFFIC_STOP_REQUESTED:
-            carLeft_ = carRight_ = "Red";
-            pushLog("Request: MANUAL_TRAFFIC_STOP_REQUESTED (car=Red,Red)");
+            state_.carLeft = state_.carRight = LightColour::RED;
+            touch(SECTION_CAR);
+            pushLog(ACT_REQUEST, logArg(ev), logArg(state_.carLeft), logArg(state_.carRight));
             break;
         case BridgeEvent::MANUAL_TRAFFIC_RESUME_REQUESTED:
-            carLeft_ = carRight_ = "Green";
-            pushLog("Request: MANUAL_TRAFFIC_RESUME_REQUESTED (car=Green,Green)");
+            state_.carLeft = state_.carRight = LightColour::GREEN;
+            touch(SECTION_CAR);
+            pushLog(ACT_REQUEST, logArg(ev), logArg(state_.carLeft), logArg(state_.carRight));
             break;
         case BridgeEvent::BOAT_DETECTED:
-            pushLog("Event: BOAT_DETECTED");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BOAT_DETECTED_LEFT:
-            pushLog("Event: BOAT_DETECTED_LEFT");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BOAT_DETECTED_RIGHT:
-            pushLog("Event: BOAT_DETECTED_RIGHT");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::TRAFFIC_STOPPED_SUCCESS:
-            carLeft_ = carRight_ = "Red";
+            state_.carLeft = state_.carRight = LightColour::RED;
+            touch(SECTION_CAR);
             // Don't reset pedestrian timer here - let STATE_CHANGED handle it
-            pushLog(String("Traffic stopped; car lights now ") + carLeft_ + "/" + carRight_);
+            pushLog(ACT_LIGHTS_NOW, TEXT_TRAFFIC_STOPPED, logArg(state_.carLeft), logArg(state_.carRight));
             break;
         case BridgeEvent::BRIDGE_OPENED_SUCCESS:
-            bridgeLockEngaged_ = false;
-            bridgeLastChangeMs_ = now;
+            state_.bridgeLockEngaged = false;
+            state_.bridgeLastChangeMs = now;
+            touch(SECTION_BRIDGE);
             // Boat lights are set by startBoatGreenPeriod() which publishes BOAT_LIGHT_CHANGED_SUCCESS events
             // Don't override them here - let the individual light change events handle it
-            pushLog("Bridge opened");
+            pushLog(ACT_TEXT, TEXT_BRIDGE_OPENED);
             break;
         case BridgeEvent::BOAT_PASSED:
-            pushLog("Event: BOAT_PASSED");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BOAT_PASSED_LEFT:
-            pushLog("Event: BOAT_PASSED_LEFT");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BOAT_PASSED_RIGHT:
-            pushLog("Event: BOAT_PASSED_RIGHT");
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BRIDGE_CLOSED_SUCCESS:
-            bridgeLockEngaged_ = true;
-            bridgeLastChangeMs_ = now;
-            boatLeft_ = boatRight_ = "Red";
-            pushLog(String("Bridge closed; boat lights now ") + boatLeft_ + "/" + boatRight_);
+            state_.bridgeLockEngaged = true;
+            state_.bridgeLastChangeMs = now;
+            state_.boatLeft = state_.boatRight = LightColour::RED;
+            touch(SECTION_BRIDGE | SECTION_BOAT);
+            pushLog(ACT_LIGHTS_NOW, TEXT_BRIDGE_CLOSED, logArg(state_.boatLeft), logArg(state_.boatRight));
             break;
         case BridgeEvent::TRAFFIC_RESUMED_SUCCESS:
-            carLeft_ = carRight_ = "Green";
-            pushLog(String("Traffic resumed; car lights now ") + carLeft_ + "/" + carRight_);
+            state_.carLeft = state_.carRight = LightColour::GREEN;
+            touch(SECTION_CAR);
+            pushLog(ACT_LIGHTS_NOW, TEXT_TRAFFIC_RESUMED, logArg(state_.carLeft), logArg(state_.carRight));
             break;
         case BridgeEvent::INDICATOR_UPDATE_SUCCESS:
             // Indicator LED updated - no need to log every state change
             // (State changes are already logged via STATE_CHANGED events)
             break;
         case BridgeEvent::FAULT_DETECTED:
-            inFault_ = true;
-            carLeft_ = carRight_ = "Red";
-            boatLeft_ = boatRight_ = "Red";
-            pushLog("EMERGENCY: FAULT_DETECTED");
+            state_.inFault = true;
+            state_.carLeft = state_.carRight = LightColour::RED;
+            state_.boatLeft = state_.boatRight = LightColour::RED;
+            touch(SECTION_CAR | SECTION_BOAT);
+            pushLog(ACT_TEXT, TEXT_FAULT_DETECTED);
             break;
         case BridgeEvent::SYSTEM_SAFE_SUCCESS:
-            pushLog("System reports safe status");
+            pushLog(ACT_TEXT, TEXT_SYSTEM_SAFE);
             break;
         case BridgeEvent::FAULT_CLEARED:
-            inFault_ = false;
-            bridgeLockEngaged_ = true;
-            carLeft_ = carRight_ = "Green";
-            boatLeft_ = boatRight_ = "Red";
-            pushLog("Event: FAULT_CLEARED");
+            state_.inFault = false;
+            state_.bridgeLockEngaged = true;
+            state_.carLeft = state_.carRight = LightColour::GREEN;
+            state_.boatLeft = state_.boatRight = LightColour::RED;
+            touch(SECTION_CAR | SECTION_BOAT);
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::SYSTEM_RESET_REQUESTED:
-            inFault_ = false;
-            manualMode_ = false;
-            bridgeLockEngaged_ = true;
-            carLeft_ = carRight_ = "Green";
-            boatLeft_ = boatRight_ = "Red";
-            pushLog("Command: SYSTEM_RESET_REQUESTED -> reset to idle defaults");
+            state_.inFault = false;
+            state_.manualMode = false;
+            state_.bridgeLockEngaged = true;
+            state_.carLeft = state_.carRight = LightColour::GREEN;
+            state_.boatLeft = state_.boatRight = LightColour::RED;
+            touch(SECTION_BRIDGE | SECTION_CAR | SECTION_BOAT);
+            pushLog(ACT_TEXT, TEXT_SYSTEM_RESET);
             break;
         case BridgeEvent::MANUAL_OVERRIDE_ACTIVATED:
-            manualMode_ = true;
-            pushLog("Event: MANUAL_OVERRIDE_ACTIVATED");
+            state_.manualMode = true;
+            touch(SECTION_BRIDGE);
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::MANUAL_OVERRIDE_DEACTIVATED:
-            manualMode_ = false;
-            pushLog("Event: MANUAL_OVERRIDE_DEACTIVATED");
-            break;
-        case BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS:
-            // Handle car light changes; support combined updates via side="both"
-            if (data && data->getEventEnum() == BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS) {
-                auto* lightData = static_cast<LightChangeData*>(data);
-                if (lightData->getSide() == "left") {
-                    carLeft_ = lightData->getColor();
-                } else if (lightData->getSide() == "right") {
-                    carRight_ = lightData->getColor();
-                } else if (lightData->getSide() == "both") {
-                    carLeft_ = carRight_ = lightData->getColor();
-                }
-                const String& side = lightData->getSide();
-                const String& color = lightData->getColor();
-                if (side == "both") {
-                    pushLog(String("Car lights set to ") + color);
-                } else {
-                    pushLog(String("Car light (") + side + ") set to " + color);
-                }
-            }
-            break;
-        case BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS:
-            // Handle individual boat light changes
-            if (data && data->getEventEnum() == BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS) {
-                auto* lightData = static_cast<LightChangeData*>(data);
-                const String& side = lightData->getSide();
-                const String& color = lightData->getColor();
-                
-                if (side == "left") {
-                    boatLeft_ = color;
-                } else if (side == "right") {
-                    boatRight_ = color;
-                }
-                
-                // Track boat timer: if a side turns green, start timer. If both turn red, stop timer.
-                if (color == "Green") {
-                    boatTimerStartMs_ = now;
-                    boatTimerSide_ = side;
-                } else if (color == "Red" && (boatLeft_ == "Red" && boatRight_ == "Red")) {
-                    // Both lights red = timer inactive
-                    boatTimerStartMs_ = 0;
-                    boatTimerSide_ = "";
-                }
-                
-                pushLog(String("Boat light (") + side + ") set to " + color);
-            }
+            state_.manualMode = false;
+            touch(SECTION_BRIDGE);
+            pushLog(ACT_EVENT, logArg(ev));
             break;
         case BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED:
             // Timer expired - reset timer state
-            boatTimerStartMs_ = 0;
-            boatTimerSide_ = "";
+            state_.boatTimerStartMs = 0;
+            state_.boatTimerSide = LightSide::NONE;
+            touch(SECTION_BRIDGE);
             break;
         default:
-            pushLog(String("Event: ") + eventName(ev));
+            pushLog(ACT_EVENT, logArg(ev));
             break;
     }
+    publish();
+}
+
+// Dispatch task only, like the rest of the apply* path
+void StateWriter::touch(uint8_t sections) {
+    ++state_.version;
+    for (size_t i = 0; i < UiState::SECTION_COUNT; ++i) {
+        if (sections & (1u << i)) state_.sectionVersion[i] = state_.version;
+    }
+}
+
+// Readers pick up the change with their next load. Log lines pushed by the same handler
+// are already in the log, so a reader holding this version finds all of its lines.
+void StateWriter::publish() {
+    published_.store(state_);
 }
 
-void StateWriter::pushLog(const String& line) {
-    if (log_.size() >= LOG_CAP_) log_.erase(log_.begin());
-    // Assign a monotonically increasing sequence so clients can deduplicate without dropping repeats
-    log_.push_back(String(logSeq_++) + "|" + line);
+// Dispatch task only; the line is not shown until publish() releases its version
+void StateWriter::pushLog(ActivityCode code, uint8_t arg0, uint8_t arg1, uint8_t arg2) {
+    log_.push(++state_.version, Clock::millis(), code, arg0, arg1, arg2);
+}
+
+// {"seq", "ms", "text"}; seq increases by one per line, so clients can deduplicate
+// without dropping repeats and can tell when they missed some
+void StateWriter::addLogLine(JsonArray lines, const ActivityLog::Entry& entry) {
+    char text[96];
+    formatLogMessage(entry, text, sizeof(text));
+    JsonObject line = lines.add<JsonObject>();
+    line["seq"] = entry.seq;
+    line["ms"] = entry.timestampMs;
+    line["text"] = text;
+}
+
+size_t StateWriter::formatLogMessage(const ActivityLog::Entry& entry, char* out, size_t size) {
+    static_assert(sizeof(ACTIVITY_TEXTS) / sizeof(ACTIVITY_TEXTS[0]) == TEXT_TRAFFIC_RESUMED + 1,
+                  "ACTIVITY_TEXTS must follow ActivityText");
+    const uint8_t* a = entry.args;
+    int n;
+    switch (entry.code) {
+        case ACT_EVENT:
+            n = snprintf(out, size, "Event: %s", eventName(static_cast<BridgeEvent>(a[0])));
+            break;
+        case ACT_REQUEST:
+            n = a[1] == ActivityLog::NO_ARG
+                    ? snprintf(out, size, "Request: %s", eventName(static_cast<BridgeEvent>(a[0])))
+                    : snprintf(out, size, "Request: %s (car=%s,%s)", eventName(static_cast<BridgeEvent>(a[0])),
+                               colourArg(a[1]), colourArg(a[2]));
+            break;
+        case ACT_TEXT:
+            n = snprintf(out, size, "%s", textArg(a[0]));
+            break;
+        case ACT_STATE_CHANGED:
+            n = snprintf(out, size, "Bridge state changed: %s -> %s", toString(static_cast<BridgeState>(a[0])),
+                         toString(static_cast<BridgeState>(a[1])));
+            break;
+        case ACT_SENSORS:
+            n = snprintf(out, size, "Simulation sensors updated: UL=%s, UR=%s, Beam=%s", onOffArg(a[0]),
+                         onOffArg(a[1]), onOffArg(a[2]));
+            break;
+        case ACT_CAR_LIGHTS:
+            n = snprintf(out, size, "Car lights set to %s", colourArg(a[0]));
+            break;
+        case ACT_CAR_LIGHT:
+            n = snprintf(out, size, "Car light (%s) set to %s", sideArg(a[0]), colourArg(a[1]));
+            break;
+        case ACT_BOAT_LIGHT:
+            n = snprintf(out, size, "Boat light (%s) set to %s", sideArg(a[0]), colourArg(a[1]));
+            break;
+        case ACT_LIGHTS_NOW:
+            n = snprintf(out, size, "%s lights now %s/%s", textArg(a[0]), colourArg(a[1]), colourArg(a[2]));
+            break;
+        default:
+            n = snprintf(out, size, "Unknown activity %u", static_cast<unsigned int>(entry.code));
+            break;
+    }
+    if (n < 0) return 0;
+    return static_cast<size_t>(n) < size ? static_cast<size_t>(n) : size - 1;
 }
 
 const char* StateWriter::eventName(BridgeEvent ev) {
@@ -368,21 +692,3 @@ const char* StateWriter::eventName(BridgeEvent ev) {
     default: return "UNKNOWN_EVENT";
   }
 }
-
-const char* StateWriter::stateToString(BridgeState state) {
-  switch (state) {
-    case BridgeState::IDLE: return "IDLE";
-    case BridgeState::STOPPING_TRAFFIC: return "STOPPING_TRAFFIC";
-    case BridgeState::OPENING: return "OPENING";
-    case BridgeState::OPEN: return "OPEN";
-    case BridgeState::CLOSING: return "CLOSING";
-    case BridgeState::RESUMING_TRAFFIC: return "RESUMING_TRAFFIC";
-    case BridgeState::FAULT: return "FAULT";
-    case BridgeState::MANUAL_MODE: return "MANUAL_MODE";
-    case BridgeState::MANUAL_OPENING: return "MANUAL_OPENING";
-    case BridgeState::MANUAL_OPEN: return "MANUAL_OPEN";
-    case BridgeState::MANUAL_CLOSING: return "MANUAL_CLOSING";
-    case BridgeState::MANUAL_CLOSED: return "MANUAL_CLOSED";
-    default: return "UNKNOWN_STATE";
-  }
-}
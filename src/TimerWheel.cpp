@@ -0,0 +1,214 @@
+#include "TimerWheel.h"
+#include <utility>
+
+TimerWheel::TimerWheel(uint32_t nowMs) : current_(nowMs) {
+    buckets_.fill(NIL);
+    // Every node starts on the free list
+    for (size_t i = 0; i < MAX_TIMERS; ++i) {
+        nodes_[i].next = (i + 1 < MAX_TIMERS) ? static_cast<uint16_t>(i + 1) : NIL;
+    }
+    freeList_ = 0;
+}
+
+TimerId TimerWheel::schedule(uint32_t nowMs, uint32_t delayMs, Callback callback) {
+    if (!callback) {
+        return INVALID_TIMER_ID;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeList_ == NIL) {
+        return INVALID_TIMER_ID;
+    }
+
+    // An idle wheel has nothing to catch up on - start counting from now
+    if (pending_ == 0 && static_cast<int32_t>(nowMs - current_) > 0) {
+        current_ = nowMs;
+    }
+
+    // Deadlines in the past (caller's clock behind the wheel) fire on the next tick
+    uint32_t expires = nowMs + delayMs;
+    if (static_cast<int32_t>(expires - current_) < 0) {
+        expires = current_;
+    }
+    if (expires - current_ > MAX_DELAY_MS) {
+        expires = current_ + MAX_DELAY_MS;
+    }
+
+    const uint16_t index = freeList_;
+    Node& node = nodes_[index];
+    freeList_ = node.next;
+    node.callback = std::move(callback);
+    node.expires = expires;
+    node.used = true;
+    link(index);
+    pending_++;
+    return (node.generation << INDEX_BITS) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    const uint16_t index = static_cast<uint16_t>(node - nodes_.data());
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::advance(uint32_t nowMs) {
+    size_t fired = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (static_cast<int32_t>(nowMs - current_) >= 0) {
+        if (pending_ == 0) {
+            current_ = nowMs + 1;  // Nothing to cascade or fire - skip the idle stretch
+            break;
+        }
+
+        const uint32_t tick = current_;
+        const unsigned slot = tick & SLOT_MASK;
+
+        // The level-0 wheel wrapped: pull the next block of timers down from the levels above
+        if (slot == 0) {
+            for (unsigned level = 1; level < LEVELS; ++level) {
+                const unsigned upper = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+                cascade(level, upper);
+                if (upper != 0) {
+                    break;
+                }
+            }
+        }
+        current_ = tick + 1;
+
+        // A callback that re-arms 64 ms out lands back in this bucket, so only take
+        // timers due on this tick, one at a time, and release the lock around each call
+        bool found = true;
+        while (found) {
+            found = false;
+            for (uint16_t index = buckets_[slot]; index != NIL; index = nodes_[index].next) {
+                if (nodes_[index].expires != tick) {
+                    continue;
+                }
+                unlink(index);
+                Callback callback = std::move(nodes_[index].callback);
+                release(index);
+
+                lock.unlock();
+                callback();
+                lock.lock();
+
+                fired++;
+                found = true;
+                break;
+            }
+        }
+    }
+    return fired;
+}
+
+uint32_t TimerWheel::nextDueIn(uint32_t nowMs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_ == 0) {
+        return NO_TIMER;
+    }
+    // The pool is small, so a scan is cheaper than keeping the wheel ordered
+    uint32_t earliest = NO_TIMER;
+    for (const Node& node : nodes_) {
+        if (!node.used) {
+            continue;
+        }
+        const int32_t remaining = static_cast<int32_t>(node.expires - nowMs);
+        const uint32_t due = remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+        if (due < earliest) {
+            earliest = due;
+        }
+    }
+    return earliest;
+}
+
+size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+void TimerWheel::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < MAX_TIMERS; ++i) {
+        if (nodes_[i].used) {
+            unlink(static_cast<uint16_t>(i));
+            release(static_cast<uint16_t>(i));
+        }
+    }
+}
+
+void TimerWheel::link(uint16_t index) {
+    Node& node = nodes_[index];
+    const uint32_t delta = node.expires - current_;
+
+    // Lowest level whose span covers the delay; the slot comes from the deadline's own
+    // bits at that level, so timers cascade into the right place as the wheel turns
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (1u << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    const unsigned slot = (node.expires >> (SLOT_BITS * level)) & SLOT_MASK;
+    node.bucket = static_cast<uint16_t>(level * SLOTS + slot);
+
+    uint16_t& head = buckets_[node.bucket];
+    node.prev = NIL;
+    node.next = head;
+    if (head != NIL) {
+        nodes_[head].prev = index;
+    }
+    head = index;
+}
+
+void TimerWheel::unlink(uint16_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        buckets_[node.bucket] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.next = NIL;
+    node.prev = NIL;
+}
+
+void TimerWheel::release(uint16_t index) {
+    Node& node = nodes_[index];
+    node.callback = nullptr;
+    node.used = false;
+    node.generation = (node.generation + 1) & GENERATION_MASK;  // Outstanding ids for this node go stale
+    if (node.generation == 0) {
+        node.generation = 1;
+    }
+    node.next = freeList_;
+    freeList_ = index;
+    pending_--;
+}
+
+void TimerWheel::cascade(unsigned level, unsigned slot) {
+    uint16_t index = buckets_[level * SLOTS + slot];
+    buckets_[level * SLOTS + slot] = NIL;
+    while (index != NIL) {
+        const uint16_t next = nodes_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+TimerWheel::Node* TimerWheel::find(TimerId id) {
+    const size_t index = id & INDEX_MASK;
+    if (index >= MAX_TIMERS) {
+        return nullptr;
+    }
+    Node& node = nodes_[index];
+    if (!node.used || node.generation != (id >> INDEX_BITS)) {
+        return nullptr;
+    }
+    return &node;
+}
@@ -0,0 +1,182 @@
+#include "TraceRecorder.h"
+#include "Clock.h"
+#include <cstring>
+
+#ifdef UNIT_TEST
+    #include <thread>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+#endif
+
+namespace {
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putU32(uint8_t* out, uint32_t value) {
+    putU16(out, static_cast<uint16_t>(value));
+    putU16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+}  // namespace
+
+void TraceRecorder::record(TraceKind kind, BridgeEvent event, BoatEventSide side, EventPriority priority,
+                           size_t queueDepth, uint32_t timestampUs, uint32_t durationUs) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // Announce the write before re-checking the flag, so pause() either sees this
+    // writer or this writer sees the pause
+    writers_.fetch_add(1);
+    if (!enabled_.load()) {
+        writers_.fetch_sub(1);
+        return;
+    }
+
+    const uint32_t sequence = head_.fetch_add(1, std::memory_order_relaxed);
+    const size_t slot = sequence % CAPACITY;
+    if (busy_[slot].exchange(true, std::memory_order_acquire)) {
+        // A writer a full lap behind was preempted mid-record in this slot
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        writers_.fetch_sub(1);
+        return;
+    }
+    TraceRecord& entry = records_[slot];
+    entry.timestampUs = timestampUs;
+    entry.kind = static_cast<uint8_t>(kind);
+    entry.event = static_cast<uint8_t>(event);
+    entry.side = static_cast<uint8_t>(side);
+    entry.priority = static_cast<uint8_t>(priority);
+    entry.queueDepth = static_cast<uint16_t>(queueDepth < UINT16_MAX ? queueDepth : UINT16_MAX);
+    entry.durationUs = static_cast<uint16_t>(durationUs < UINT16_MAX ? durationUs : UINT16_MAX);
+    busy_[slot].store(false, std::memory_order_release);
+
+    writers_.fetch_sub(1);
+}
+
+size_t TraceRecorder::size() const {
+    const uint32_t total = head_.load(std::memory_order_relaxed);
+    return total < CAPACITY ? total : CAPACITY;
+}
+
+bool TraceRecorder::pause() {
+    const bool wasEnabled = enabled_.exchange(false);
+    while (writers_.load() != 0) {
+        // A writer may be a lower-priority task preempted on this core - let it finish
+#ifdef UNIT_TEST
+        std::this_thread::yield();
+#else
+        vTaskDelay(1);
+#endif
+    }
+    return wasEnabled;
+}
+
+size_t TraceRecorder::snapshot(TraceRecord* out, size_t capacity) {
+    const bool wasEnabled = pause();
+    const uint32_t total = head_.load(std::memory_order_relaxed);
+    const size_t held = size();
+    const size_t count = held < capacity ? held : capacity;
+    const uint32_t first = total - static_cast<uint32_t>(held);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = records_[(first + i) % CAPACITY];
+    }
+    enabled_.store(wasEnabled);
+    return count;
+}
+
+size_t TraceRecorder::dump(const DumpSink& sink) {
+    if (dumping_.exchange(true)) {
+        return 0;
+    }
+    const bool wasEnabled = pause();
+    const uint32_t total = head_.load(std::memory_order_relaxed);
+    const size_t held = size();
+
+    uint8_t header[HEADER_SIZE];
+    fillHeader(header, held, total);
+    sink(header, sizeof(header));
+
+    // Records are already in their wire layout (the ESP32 is little-endian), so they go out
+    // as-is; a wrapped ring is split so each chunk stays contiguous
+    const uint32_t first = total - static_cast<uint32_t>(held);
+    size_t sent = 0;
+    while (sent < held) {
+        const size_t index = (first + sent) % CAPACITY;
+        size_t count = held - sent;
+        if (count > CHUNK_RECORDS) {
+            count = CHUNK_RECORDS;
+        }
+        if (count > CAPACITY - index) {
+            count = CAPACITY - index;
+        }
+        sink(reinterpret_cast<const uint8_t*>(&records_[index]), count * sizeof(TraceRecord));
+        sent += count;
+    }
+
+    enabled_.store(wasEnabled);
+    dumping_.store(false);
+    return held;
+}
+
+bool TraceRecorder::beginDump(DumpCursor& cursor) {
+    if (dumping_.exchange(true)) {
+        return false;
+    }
+    cursor.wasEnabled = pause();
+    const uint32_t total = head_.load(std::memory_order_relaxed);
+    cursor.records = size();
+    cursor.first = total - static_cast<uint32_t>(cursor.records);
+    cursor.offset = 0;
+    fillHeader(cursor.header, cursor.records, total);
+    return true;
+}
+
+size_t TraceRecorder::readDump(DumpCursor& cursor, uint8_t* out, size_t max) const {
+    const size_t end = HEADER_SIZE + cursor.records * sizeof(TraceRecord);
+    size_t copied = 0;
+    while (copied < max && cursor.offset < end) {
+        size_t len;
+        if (cursor.offset < HEADER_SIZE) {
+            len = HEADER_SIZE - cursor.offset;
+            if (len > max - copied) len = max - copied;
+            std::memcpy(out + copied, cursor.header + cursor.offset, len);
+        } else {
+            // Up to the end of one record at a time; records sit in their wire layout
+            const size_t recordOffset = cursor.offset - HEADER_SIZE;
+            const size_t index = (cursor.first + recordOffset / sizeof(TraceRecord)) % CAPACITY;
+            const size_t within = recordOffset % sizeof(TraceRecord);
+            len = sizeof(TraceRecord) - within;
+            if (len > max - copied) len = max - copied;
+            std::memcpy(out + copied, reinterpret_cast<const uint8_t*>(&records_[index]) + within, len);
+        }
+        copied += len;
+        cursor.offset += len;
+    }
+    return copied;
+}
+
+void TraceRecorder::endDump(const DumpCursor& cursor) {
+    enabled_.store(cursor.wasEnabled);
+    dumping_.store(false);
+}
+
+// Magic, format version, record size, records in the dump, records since clear(),
+// capacity, micros() at the dump
+void TraceRecorder::fillHeader(uint8_t* header, size_t held, uint32_t total) const {
+    putU32(header, MAGIC);
+    putU16(header + 4, FORMAT_VERSION);
+    putU16(header + 6, static_cast<uint16_t>(sizeof(TraceRecord)));
+    putU32(header + 8, static_cast<uint32_t>(held));
+    putU32(header + 12, total);
+    putU32(header + 16, static_cast<uint32_t>(CAPACITY));
+    putU32(header + 20, static_cast<uint32_t>(Clock::micros()));
+}
+
+void TraceRecorder::clear() {
+    const bool wasEnabled = pause();
+    head_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    enabled_.store(wasEnabled);
+}
@@ -0,0 +1,73 @@
+#include "VirtualClock.h"
+#include "EventBus.h"
+
+VirtualClock::VirtualClock(uint32_t startMs) : nowUs_(static_cast<uint64_t>(startMs) * 1000) {}
+
+uint32_t VirtualClock::nowMs() {
+    return static_cast<uint32_t>(nowUs_ / 1000);
+}
+
+uint32_t VirtualClock::nowUs() {
+    return static_cast<uint32_t>(nowUs_);
+}
+
+void VirtualClock::set(uint32_t ms) {
+    nowUs_ = static_cast<uint64_t>(ms) * 1000;
+}
+
+void VirtualClock::advance(uint32_t ms) {
+    nowUs_ = (nowUs_ / 1000 + ms) * 1000;
+}
+
+void VirtualClock::drain(EventBus& bus) {
+    do {
+        bus.processEvents();
+    } while (bus.hasPendingEvents());
+}
+
+size_t VirtualClock::runUntil(EventBus& bus, uint32_t targetMs) {
+    drain(bus);
+    int32_t remaining = static_cast<int32_t>(targetMs - nowMs());
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    size_t deadlines = 0;
+    for (;;) {
+        const uint32_t due = bus.msUntilNextTimer();
+        if (due == TimerWheel::NO_TIMER || due > static_cast<uint32_t>(remaining)) {
+            break;
+        }
+        advance(due);
+        remaining -= static_cast<int32_t>(due);
+        drain(bus);
+        deadlines++;
+        if (due == 0 && bus.msUntilNextTimer() == 0) {
+            break;  // Overdue timer did not fire - never spin on it
+        }
+    }
+    advance(static_cast<uint32_t>(remaining));
+    drain(bus);
+    return deadlines;
+}
+
+bool VirtualClock::runUntilIdle(EventBus& bus, uint32_t limitMs) {
+    const uint32_t startMs = nowMs();
+    drain(bus);
+    for (;;) {
+        const uint32_t due = bus.msUntilNextTimer();
+        if (due == TimerWheel::NO_TIMER) {
+            return true;
+        }
+        const uint32_t elapsed = nowMs() - startMs;
+        if (due > limitMs - elapsed) {
+            runUntil(bus, startMs + limitMs);
+            return false;
+        }
+        advance(due);
+        drain(bus);
+        if (due == 0 && bus.msUntilNextTimer() == 0) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#include "WakeSignal.h"
+
+#ifdef UNIT_TEST
+
+#include <chrono>
+
+// Host stand-in: condition variable over a latched flag
+
+WakeSignal::WakeSignal() {}
+
+WakeSignal::~WakeSignal() {}
+
+void WakeSignal::notify() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        signalled_ = true;
+    }
+    cv_.notify_one();
+}
+
+bool WakeSignal::wait(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const bool notified = cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return signalled_; });
+    signalled_ = false;
+    return notified;
+}
+
+#else
+
+// Static storage, so constructing the global EventBus before setup() never touches the heap
+WakeSignal::WakeSignal() : semaphore_(xSemaphoreCreateBinaryStatic(&storage_)) {}
+
+WakeSignal::~WakeSignal() {
+    vSemaphoreDelete(semaphore_);
+}
+
+void WakeSignal::notify() {
+    // Giving an already-given binary semaphore fails harmlessly - the wake is latched once
+    xSemaphoreGive(semaphore_);
+}
+
+bool WakeSignal::wait(uint32_t timeoutMs) {
+    return xSemaphoreTake(semaphore_, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+#endif
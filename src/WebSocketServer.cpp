@@ -1,10 +1,48 @@
 #include "WebSocketServer.h"
+#include "Clock.h"
 #include "Logger.h"
 #include "ConsoleCommands.h"
+#include "TraceRecorder.h"
+#include <cstdlib>
+#include <vector>
 
 namespace {
   constexpr unsigned long CONNECT_TIMEOUT_MS = 15000;
   constexpr unsigned long RETRY_DELAY_MS = 10000;
+  constexpr size_t METRICS_DOC_CAPACITY = 8192;   // Every event and subscriber, on request only
+  constexpr size_t METRICS_MAX_SUBSCRIBERS = 32;
+  // Trace dumps go out in a handful of binary frames so the client's send queue never overflows
+  constexpr size_t TRACE_FRAME_BYTES = 6144;
+  constexpr size_t LOG_DOC_CAPACITY = 6144;       // One page of activity log lines
+
+  // "/system/log" or "/system/log?since=<seq>"; false if the query is malformed
+  bool parseLogQuery(const String& path, uint32_t& since) {
+    since = StateWriter::LOG_LATEST;
+    const int query = path.indexOf('?');
+    if (query < 0) {
+      return true;
+    }
+    const String params = path.substring(query + 1);
+    if (!params.startsWith("since=")) {
+      return false;
+    }
+    const char* digits = params.c_str() + 6;
+    char* end = nullptr;
+    const unsigned long value = strtoul(digits, &end, 10);
+    if (end == digits || *end != '\0' || value >= StateWriter::LOG_LATEST) {
+      return false;
+    }
+    since = static_cast<uint32_t>(value);
+    return true;
+  }
+
+  void fillLatencySummary(JsonObject obj, const LatencyHistogram::Summary& s) {
+    obj["count"] = s.count;
+    obj["p50Us"] = s.p50Us;
+    obj["p90Us"] = s.p90Us;
+    obj["p99Us"] = s.p99Us;
+    obj["maxUs"] = s.maxUs;
+  }
 }
 
 WebSocketServer::WebSocketServer(uint16_t port, StateWriter& stateWriter, CommandBus& commandBus, EventBus& eventBus, DetectionSystem& detectionSystem) 
@@ -52,8 +90,11 @@ void WebSocketServer::startServer() {
 
     LOG_INFO(Logger::TAG_WS, "WebSocket server started successfully!");
     LOG_INFO(Logger::TAG_WS, "Connect to: ws://%s/ws", WiFi.localIP().toString().c_str());
+}
 
+void WebSocketServer::beginSubscriptions() {
     // Subscribe to state-related events and broadcast snapshot on change
+    // Done at setup time (not when WiFi comes up) because the EventBus is sealed after setup()
     if (!broadcastSubscribed_) {
         setupBroadcastSubscriptions();
         broadcastSubscribed_ = true;
@@ -65,7 +106,7 @@ void WebSocketServer::networkLoop() {
         return; // networking disabled
     }
 
-    const unsigned long now = millis();
+    const unsigned long now = Clock::millis();
     wl_status_t status = WiFi.status();
 
     if (status == WL_CONNECTED) {
@@ -74,6 +115,7 @@ void WebSocketServer::networkLoop() {
             connectionInProgress_ = false;
             startServer();
         }
+        flushSnapshot();
         return;
     }
 
@@ -111,69 +153,197 @@ void WebSocketServer::networkLoop() {
     }
 }
 
-void WebSocketServer::fillBridgeStatus(JsonObject obj) {
-    state_.fillBridgeStatus(obj);
+void WebSocketServer::waitForWork(uint32_t maxMs) {
+    uint32_t waitMs = maxMs;
+    if (serverStarted_) {
+        const uint32_t dueMs = snapshots_.msUntilDue(Clock::millis());
+        if (dueMs < waitMs) {
+            waitMs = dueMs;
+        }
+    }
+    if (waitMs > 0) {
+        snapshots_.wait(waitMs);
+    }
 }
 
-void WebSocketServer::fillCarTrafficStatus(JsonObject obj) {
-    state_.fillCarTrafficStatus(obj);
-}
+// Latency of the control core's event loop; percentiles are log2-bucket upper edges
+void WebSocketServer::fillSystemMetrics(JsonObject obj) {
+    JsonArray events = obj["events"].to<JsonArray>();
+    for (size_t i = 0; i < BRIDGE_EVENT_COUNT; ++i) {
+        const BridgeEvent event = static_cast<BridgeEvent>(i);
+        const LatencyHistogram& queueWait = eventBus_.queueWaitHistogram(event);
+        if (queueWait.count() == 0) {
+            continue;  // Never published since boot / last reset
+        }
+        JsonObject entry = events.add<JsonObject>();
+        entry["event"] = bridgeEventToString(event);
+        fillLatencySummary(entry["queueWait"].to<JsonObject>(), queueWait.summary());
+        fillLatencySummary(entry["dispatch"].to<JsonObject>(), eventBus_.dispatchHistogram(event).summary());
+    }
 
-void WebSocketServer::fillBoatTrafficStatus(JsonObject obj) {
-    state_.fillBoatTrafficStatus(obj);
+    SubscriberTiming timings[METRICS_MAX_SUBSCRIBERS];
+    const size_t count = eventBus_.getSubscriberTimings(timings, METRICS_MAX_SUBSCRIBERS);
+    JsonArray subscribers = obj["subscribers"].to<JsonArray>();
+    for (size_t i = 0; i < count; ++i) {
+        const SubscriberTiming& t = timings[i];
+        JsonObject entry = subscribers.add<JsonObject>();
+        entry["id"] = t.id;
+        entry["label"] = t.label ? t.label : "unlabelled";
+        entry["event"] = t.mask ? "mask" : bridgeEventToString(t.event);
+        entry["priority"] = (t.priority == EventPriority::EMERGENCY) ? "EMERGENCY" : "NORMAL";
+        entry["calls"] = t.calls;
+        entry["avgUs"] = t.calls ? t.totalUs / t.calls : 0;
+        entry["maxUs"] = t.maxUs;
+    }
+
+    const EventLoopStats loop = eventBus_.getLoopStats();
+    JsonObject loopObj = obj["loop"].to<JsonObject>();
+    loopObj["idlePercent"] = loop.idlePercent;
+    loopObj["wakeLatencyAvgUs"] = loop.wakeLatencyAvgUs;
+    loopObj["wakeLatencyMaxUs"] = loop.wakeLatencyMaxUs;
+
+    const SnapshotCoalescer::Stats broadcast = snapshots_.stats();
+    JsonObject broadcastObj = obj["broadcast"].to<JsonObject>();
+    broadcastObj["intervalMs"] = snapshots_.intervalMs();
+    broadcastObj["marked"] = broadcast.marked;
+    broadcastObj["sent"] = broadcast.sent;
+    broadcastObj["suppressed"] = broadcast.suppressed;
+    broadcastObj["patches"] = patchesSent_.load(std::memory_order_relaxed);
+    broadcastObj["snapshots"] = snapshotsSent_.load(std::memory_order_relaxed);
+    broadcastObj["bytes"] = broadcastBytes_.load(std::memory_order_relaxed);
+
+    const StateWriter::CacheStats cache = state_.cacheStats();
+    JsonObject cacheObj = obj["jsonCache"].to<JsonObject>();
+    cacheObj["hits"] = cache.hits;
+    cacheObj["misses"] = cache.misses;
 }
 
-void WebSocketServer::fillSystemStatus(JsonObject obj) {
-    state_.fillSystemStatus(obj);
+// Streams the trace ring as binary frames (decode with tools/trace_decode.py), then
+// acknowledges with the record count so the client knows the dump is complete
+void WebSocketServer::sendTraceDump(AsyncWebSocketClient* client, const String& id, const String& path) {
+    TraceRecorder* trace = eventBus_.traceRecorder();
+    if (!trace) {
+        sendError(client, id, path, "Tracing not enabled");
+        return;
+    }
+
+    struct FrameWriter {
+        AsyncWebSocketClient* client;
+        std::vector<uint8_t> frame;
+        size_t frames = 0;
+
+        void flush() {
+            if (frame.empty()) {
+                return;
+            }
+            client->binary(frame.data(), frame.size());
+            frame.clear();
+            frames++;
+        }
+    } writer{client, {}, 0};
+    writer.frame.reserve(TRACE_FRAME_BYTES);
+
+    const size_t records = trace->dump([w = &writer](const uint8_t* data, size_t len) {
+        if (w->frame.size() + len > TRACE_FRAME_BYTES) {
+            w->flush();
+        }
+        w->frame.insert(w->frame.end(), data, data + len);
+    });
+    writer.flush();
+    if (writer.frames == 0) {
+        sendError(client, id, path, "Trace dump already in progress");  // Not even a header went out
+        return;
+    }
+
+    LOG_INFO(Logger::TAG_WS, "Trace dump to client %u: %u records in %u frames", client->id(),
+             static_cast<unsigned int>(records), static_cast<unsigned int>(writer.frames));
+    const size_t frames = writer.frames;
+    sendOk(client, id, path, [records, frames](JsonObject p){
+        p["records"] = records;
+        p["frames"] = frames;
+        p["recordSize"] = sizeof(TraceRecord);
+    });
 }
 
-void WebSocketServer::broadcastSnapshot() {
+// Brings every client from broadcastVersion_ to the current state: a /system/patch with
+// only what changed, or a full snapshot if the activity log has already dropped lines the
+// patch would need. Clients that see a gap in "from"/"seq" GET /system/snapshot.
+void WebSocketServer::broadcastState() {
+    if (state_.version() == broadcastVersion_) {
+        return;  // Nothing the UI shows changed (e.g. INDICATOR_UPDATE_SUCCESS)
+    }
+
+    // Serialized once, straight into the buffer every client's frame shares
     DynamicJsonDocument doc(1024);
-    state_.buildSnapshot(doc);
-    String out; serializeJson(doc, out);
-    ws.textAll(out);
+    if (state_.buildPatch(doc, broadcastVersion_)) {
+        broadcastVersion_ = doc["payload"]["seq"] | broadcastVersion_;
+        AsyncWebSocketMessageBuffer* buffer = serializeToBuffer(doc);
+        if (!buffer) {
+            return;
+        }
+        broadcastBytes_.fetch_add(buffer->length() * ws.count(), std::memory_order_relaxed);
+        ws.textAll(buffer);
+        patchesSent_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LOG_DEBUG(Logger::TAG_WS, "Log overran since version %u - broadcasting a full snapshot",
+              static_cast<unsigned int>(broadcastVersion_));
+    broadcastVersion_ = state_.version();  // The snapshot is at least this new
+    const String snapshot = state_.snapshotJson();
+    ws.textAll(snapshot);
+    snapshotsSent_.fetch_add(1, std::memory_order_relaxed);
+    broadcastBytes_.fetch_add(snapshot.length() * ws.count(), std::memory_order_relaxed);
+}
+
+// Full state for one client: on connect, so later patches have a base to apply to
+void WebSocketServer::sendSnapshot(AsyncWebSocketClient* client) {
+    const String snapshot = state_.snapshotJson();
+    client->text(snapshot);
+    snapshotsSent_.fetch_add(1, std::memory_order_relaxed);
+    broadcastBytes_.fetch_add(snapshot.length(), std::memory_order_relaxed);
+}
+
+// measureJson + serializeJson into a socket-owned buffer: no intermediate String, and
+// textAll() hands the one buffer to every client. Broadcasts only - the socket frees its
+// buffers on the next textAll(), so one made for a single client's reply would be held
+// until then. nullptr when out of memory.
+AsyncWebSocketMessageBuffer* WebSocketServer::serializeToBuffer(const JsonDocument& doc) {
+    const size_t len = measureJson(doc);
+    AsyncWebSocketMessageBuffer* buffer = ws.makeBuffer(len);
+    if (!buffer) {
+        LOG_WARN(Logger::TAG_WS, "No memory for a %u byte frame", static_cast<unsigned int>(len));
+        return nullptr;
+    }
+    serializeJson(doc, reinterpret_cast<char*>(buffer->get()), len + 1);
+    return buffer;
+}
+
+// Network task: one broadcast for however many changes were marked since the last
+void WebSocketServer::flushSnapshot() {
+    if (snapshots_.takeDue(Clock::millis())) {
+        broadcastState();
+    }
 }
 
 void WebSocketServer::setupBroadcastSubscriptions() {
     using E = BridgeEvent;
-    auto sub = [this](EventData*){
-        broadcastSnapshot();
-    };
-
-    // Subscribe to the same set StateWriter uses
-    eventBus_.subscribe(E::BOAT_DETECTED, sub);
-    eventBus_.subscribe(E::BOAT_DETECTED_LEFT, sub);
-    eventBus_.subscribe(E::BOAT_DETECTED_RIGHT, sub);
-    eventBus_.subscribe(E::BOAT_PASSED, sub);
-    eventBus_.subscribe(E::BOAT_PASSED_LEFT, sub);
-    eventBus_.subscribe(E::BOAT_PASSED_RIGHT, sub);
-    eventBus_.subscribe(E::FAULT_DETECTED, sub);
-    eventBus_.subscribe(E::FAULT_CLEARED, sub);
-    eventBus_.subscribe(E::MANUAL_OVERRIDE_ACTIVATED, sub);
-    eventBus_.subscribe(E::MANUAL_OVERRIDE_DEACTIVATED, sub);
-
-    eventBus_.subscribe(E::TRAFFIC_STOPPED_SUCCESS, sub);
-    eventBus_.subscribe(E::BRIDGE_OPENED_SUCCESS, sub);
-    eventBus_.subscribe(E::BRIDGE_CLOSED_SUCCESS, sub);
-    eventBus_.subscribe(E::TRAFFIC_RESUMED_SUCCESS, sub);
-    eventBus_.subscribe(E::INDICATOR_UPDATE_SUCCESS, sub);
-    eventBus_.subscribe(E::SYSTEM_SAFE_SUCCESS, sub);
-    eventBus_.subscribe(E::CAR_LIGHT_CHANGED_SUCCESS, sub);
-    eventBus_.subscribe(E::BOAT_LIGHT_CHANGED_SUCCESS, sub);
-
-    // Also include manual requests so frontend reflects transitional states immediately
-    eventBus_.subscribe(E::MANUAL_BRIDGE_OPEN_REQUESTED, sub);
-    eventBus_.subscribe(E::MANUAL_BRIDGE_CLOSE_REQUESTED, sub);
-    eventBus_.subscribe(E::MANUAL_TRAFFIC_STOP_REQUESTED, sub);
-    eventBus_.subscribe(E::MANUAL_TRAFFIC_RESUME_REQUESTED, sub);
-    
-    // Subscribe to state changes for immediate updates
-    eventBus_.subscribe(E::STATE_CHANGED, sub);
-    
-    // Simulation mode changes
-    eventBus_.subscribe(E::SIMULATION_ENABLED, sub);
-    eventBus_.subscribe(E::SIMULATION_DISABLED, sub);
-    eventBus_.subscribe(E::SIMULATION_SENSOR_CONFIG_CHANGED, sub);
+
+    // Every event refreshes the UI snapshot, including event types added later.
+    // Beam-break edges are high-rate sensor chatter; the state they cause arrives
+    // as STATE_CHANGED anyway.
+    const EventMask broadcastEvents = EventMask::all()
+        .without(E::BEAM_BREAK_ACTIVE)
+        .without(E::BEAM_BREAK_CLEAR);
+
+    // Registered after StateWriter, so the state is already updated when the network task
+    // sees the mark. The control core only marks; building and sending is the network
+    // task's job, coalesced (a green period's STATE_CHANGED + two BOAT_LIGHT_CHANGED
+    // become one snapshot).
+    EventBus::SubscriberLabel label(eventBus_, "WebSocketServer");
+    eventBus_.subscribe(broadcastEvents, [this](BridgeEvent, EventData*) {
+        snapshots_.markDirty();
+    });
 }
 
 /**
@@ -182,8 +352,8 @@ void WebSocketServer::setupBroadcastSubscriptions() {
  * data and this function will only be called if the operation was successful.
  */
 void WebSocketServer::sendOk(AsyncWebSocketClient* client, const String& id, const String& path,
-                             std::function<void(JsonObject)> fillPayload) {
-    DynamicJsonDocument doc(512);
+                             std::function<void(JsonObject)> fillPayload, size_t docCapacity) {
+    DynamicJsonDocument doc(docCapacity);
     doc["v"] = 1;
     doc["id"] = id;
     doc["type"] = "response";
@@ -202,6 +372,20 @@ void WebSocketServer::sendOk(AsyncWebSocketClient* client, const String& id, con
     }
 }
 
+// sendOk() with a payload that is already serialized (StateWriter's cached sections)
+void WebSocketServer::sendOkJson(AsyncWebSocketClient* client, const String& id, const String& path,
+                                 const String& payloadJson) {
+    DynamicJsonDocument doc(256);
+    doc["v"] = 1;
+    doc["id"] = id;
+    doc["type"] = "response";
+    doc["ok"] = true;
+    doc["path"] = path;
+    doc["payload"] = serialized(payloadJson);
+    String out; serializeJson(doc, out);
+    client->text(out);
+}
+
 void WebSocketServer::sendError(AsyncWebSocketClient* client, const String& id, const String& path, const String& msg) {
     DynamicJsonDocument doc(384);
     doc["v"] = 1;
@@ -227,21 +411,38 @@ void WebSocketServer::sendError(AsyncWebSocketClient* client, const String& id,
  *      /traffic/car/status
  *      /traffic/boat/status
  *      /system/status
+ *      /system/snapshot   (full state with its "seq"; clients resync with it after a patch gap)
+ *      /system/log        (activity log lines; "?since=<seq>" for only the lines after seq)
  *      /system/ping
+ *      /system/metrics    (event queue-wait / dispatch latency and per-subscriber callback timing)
+ *      /system/trace      (binary trace dump frames, then a response with the record count)
  *
  * The information received by these endpoints will then attempt to apply this to the BridgeStateMachine.
  */
 void WebSocketServer::handleGet(AsyncWebSocketClient* client, const String& id, const String& path) {
     if (path == "/bridge/status") {
-        sendOk(client, id, path, [this](JsonObject p){ fillBridgeStatus(p); });
+        sendOkJson(client, id, path, state_.bridgeStatusJson());
     } else if (path == "/traffic/car/status") {
-        sendOk(client, id, path, [this](JsonObject p){ fillCarTrafficStatus(p); });
+        sendOkJson(client, id, path, state_.carTrafficStatusJson());
     } else if (path == "/traffic/boat/status") {
-        sendOk(client, id, path, [this](JsonObject p){ fillBoatTrafficStatus(p); });
+        sendOkJson(client, id, path, state_.boatTrafficStatusJson());
     } else if (path == "/system/status") {
-        sendOk(client, id, path, [this](JsonObject p){ fillSystemStatus(p); });
+        sendOkJson(client, id, path, state_.systemStatusJson());
+    } else if (path == "/system/snapshot") {
+        sendOkJson(client, id, path, state_.snapshotPayloadJson());
+    } else if (path == "/system/log" || path.startsWith("/system/log?")) {
+        uint32_t since;
+        if (!parseLogQuery(path, since)) {
+            sendError(client, id, path, "Invalid log query");
+            return;
+        }
+        sendOk(client, id, path, [this, since](JsonObject p){ state_.fillLog(p, since); }, LOG_DOC_CAPACITY);
     } else if (path == "/system/ping") {
-        sendOk(client, id, path, [](JsonObject p){ p["nowMs"] = millis(); });
+        sendOk(client, id, path, [](JsonObject p){ p["nowMs"] = Clock::millis(); });
+    } else if (path == "/system/metrics") {
+        sendOk(client, id, path, [this](JsonObject p){ fillSystemMetrics(p); }, METRICS_DOC_CAPACITY);
+    } else if (path == "/system/trace") {
+        sendTraceDump(client, id, path);
     } else {
         sendError(client, id, path, "Unknown GET path");
     }
@@ -267,22 +468,21 @@ void WebSocketServer::handleSet(AsyncWebSocketClient* client, const String& id,
         if (s != "Open" && s != "Closed") { sendError(client, id, path, "Invalid state"); return; }
 
         // Send manual control event via EventBus to StateMachine (Command Mode)
+        // This runs on the network core, so hand the event to the control core lock-free
+        bool queued;
         if (s == "Open") {
             LOG_INFO(Logger::TAG_WS, "Bridge open requested via WebSocket");
-            // Allocate on heap as EventBus processes asynchronously
-            auto* eventData = new SimpleEventData(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED);
-            eventBus_.publish(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED, eventData);
+            queued = eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED);
         } else {
             LOG_INFO(Logger::TAG_WS, "Bridge close requested via WebSocket");
-            auto* eventData = new SimpleEventData(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED);
-            eventBus_.publish(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED, eventData);
+            queued = eventBus_.emplaceRemote<SimpleEventData>(BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED);
         }
+        if (!queued) { sendError(client, id, path, "Event queue full"); return; }
 
         // Acknowledge request and provide current vs requested state distinctly
         sendOk(client, id, path, [this, s](JsonObject p){
             p["requestedState"] = s;
-            JsonObject current = p["current"].to<JsonObject>();
-            fillBridgeStatus(current);
+            p["current"] = serialized(state_.bridgeStatusJson());
         });
 
     } else if (path == "/traffic/car") {
@@ -306,8 +506,7 @@ void WebSocketServer::handleSet(AsyncWebSocketClient* client, const String& id,
         // Acknowledge request and include current snapshot
         sendOk(client, id, path, [this, v](JsonObject p){
             p["requestedValue"] = v;
-            JsonObject current = p["current"].to<JsonObject>();
-            fillCarTrafficStatus(current);
+            p["current"] = serialized(state_.carTrafficStatusJson());
         });
 
     } else if (path == "/traffic/boat/light") { 
@@ -342,8 +541,7 @@ void WebSocketServer::handleSet(AsyncWebSocketClient* client, const String& id,
         sendOk(client, id, path, [this, sd, v](JsonObject p){
             p["requestedSide"] = sd;
             p["requestedValue"] = v;
-            JsonObject current = p["current"].to<JsonObject>();
-            fillBoatTrafficStatus(current);
+            p["current"] = serialized(state_.boatTrafficStatusJson());
         });
     } else if (path == "/simulation/sensors") {
         if (!detectionSystem_.isSimulationMode()) {
@@ -404,16 +602,15 @@ void WebSocketServer::handleSet(AsyncWebSocketClient* client, const String& id,
     } else if (path == "/system/reset") {
         LOG_WARN(Logger::TAG_WS, "System reset requested via WebSocket client %u", client ? client->id() : 0);
 
-        auto* resetData = new SimpleEventData(BridgeEvent::SYSTEM_RESET_REQUESTED);
-        eventBus_.publish(BridgeEvent::SYSTEM_RESET_REQUESTED, resetData, EventPriority::EMERGENCY);
+        if (!eventBus_.emplaceRemote<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::SYSTEM_RESET_REQUESTED)) {
+            sendError(client, id, path, "Event queue full");
+            return;
+        }
 
         sendOk(client, id, path, [this](JsonObject p){
-            JsonObject bridge = p["bridge"].to<JsonObject>();
-            fillBridgeStatus(bridge);
-            JsonObject car = p["carTraffic"].to<JsonObject>();
-            fillCarTrafficStatus(car);
-            JsonObject boat = p["boatTraffic"].to<JsonObject>();
-            fillBoatTrafficStatus(boat);
+            p["bridge"] = serialized(state_.bridgeStatusJson());
+            p["carTraffic"] = serialized(state_.carTrafficStatusJson());
+            p["boatTraffic"] = serialized(state_.boatTrafficStatusJson());
         });
     } else if (path == "/console/command") {
         if (!console_) { sendError(client, id, path, "Console unavailable"); return; }
@@ -444,6 +641,7 @@ void WebSocketServer::handleWsEvent(AsyncWebSocket* server, AsyncWebSocketClient
     
     if (type == WS_EVT_CONNECT) {
         LOG_INFO(Logger::TAG_WS, "Client %u connected", client->id());
+        sendSnapshot(client);
         return;
     }
     if (type == WS_EVT_DISCONNECT) {
@@ -486,7 +684,8 @@ void WebSocketServer::handleWsEvent(AsyncWebSocket* server, AsyncWebSocketClient
     if (method == "GET") {
         // Only log non routine GET requests
         if (path != "/bridge/status" && path != "/traffic/car/status" && 
-            path != "/traffic/boat/status" && path != "/system/status" && path != "/system/ping") {
+            path != "/traffic/boat/status" && path != "/system/status" && path != "/system/ping" &&
+            path != "/system/snapshot" && !path.startsWith("/system/log")) {
             LOG_DEBUG(Logger::TAG_WS, "[RX] Client %u -> GET %s", client->id(), path.c_str());
         }
         handleGet(client, id, path);
@@ -16,6 +16,7 @@
 #include "credentials.h"
 #include "Logger.h"
 #include "SafetyManager.h"
+#include "TraceRecorder.h"
 
 #define LED_BUILTIN 2
 
@@ -23,6 +24,9 @@
 EventBus systemEventBus;
 CommandBus systemCommandBus;
 
+// Binary event trace ring ('trace dump' on the console, /system/trace over WebSocket)
+TraceRecorder traceRecorder;
+
 // Subsystems
 MotorControl motorControl(systemEventBus);
 SignalControl signalControl(systemEventBus);
@@ -37,7 +41,11 @@ BridgeStateMachine stateMachine(systemEventBus, systemCommandBus);
 DetectionSystem detectionSystem(systemEventBus);
 
 // WebSocket and state monitoring components
-StateWriter stateWriter(systemEventBus);
+// Activity log lines kept for the UI (16 bytes each, allocated once at boot)
+#ifndef ACTIVITY_LOG_CAPACITY
+#define ACTIVITY_LOG_CAPACITY 256
+#endif
+StateWriter stateWriter(systemEventBus, ACTIVITY_LOG_CAPACITY);
 WebSocketServer wss(80, stateWriter, systemCommandBus, systemEventBus, detectionSystem);
 
 // SafetyManager monitorint components
@@ -54,6 +62,21 @@ TaskHandle_t networkTaskHandle = NULL;
 #define CONTROL_LOGIC_CORE 1  // High priority core for bridge control
 #define NETWORK_CORE 0        // Lower priority core for networking
 
+// Per-pass event dispatch budget; leftovers are picked up on the next pass without sleeping
+#define EVENT_BUDGET_MAX_EVENTS 32
+#define EVENT_BUDGET_US 2000
+
+// Longest the control loop sleeps with nothing due - bounds serial console latency
+#define CONSOLE_POLL_INTERVAL_MS 20
+// Limit switch polling while the motor is running
+#define MOTOR_POLL_INTERVAL_MS 5
+// Console trace dump pacing: one 65-char line drains from the UART in ~5.6 ms at 115200 baud
+#define TRACE_DUMP_POLL_INTERVAL_MS 6
+// WiFi supervision period of the network task (state changes wake it sooner)
+#define NETWORK_POLL_INTERVAL_MS 200
+// At most one UI snapshot broadcast per interval; changes in between are coalesced
+#define WS_SNAPSHOT_INTERVAL_MS 50
+
 // CONTROL LOGIC CORE TASK (High Priority - Core 1)
 void controlLogicTask(void* parameters) {
     LOG_INFO(Logger::TAG_SYS, "CONTROL_LOGIC_CORE: Task started on Core 1");
@@ -63,7 +86,7 @@ void controlLogicTask(void* parameters) {
     bool ledState = false;
     
     while (true) {
-        systemEventBus.processEvents();
+        systemEventBus.processEvents(EVENT_BUDGET_MAX_EVENTS, EVENT_BUDGET_US);
         
         // Check console commands
         console.poll();
@@ -71,18 +94,11 @@ void controlLogicTask(void* parameters) {
         // Check motor operation progress (non-blocking)
         motorControl.checkProgress();
         
-        // Process signal control timing (non-blocking traffic light transitions)
-        signalControl.update();
-        
         // Monitor sensors (ultrasonic distance → events)
+        // Signal phases, LED blinking, FSM and SafetyManager timeouts run on
+        // EventBus timers, fired from processEvents() above
         detectionSystem.update();
         
-        // Update LED indicator (handles blinking)
-        localStateIndicator.update();
-        
-        // Check state machine timeouts (boat passage timeout)
-        stateMachine.checkTimeouts();
-        
         // TODO: Monitor system health  
         // safetyManager.checkSystemHealth();
         
@@ -93,7 +109,20 @@ void controlLogicTask(void* parameters) {
         //     lastHeartbeat = millis();
         // }
         
-        vTaskDelay(pdMS_TO_TICKS(5));
+        // Sleep until the nearest polling deadline; a publish from either core or
+        // an EventBus timer falling due wakes the loop early
+        uint32_t waitMs = CONSOLE_POLL_INTERVAL_MS;
+        const unsigned long sampleMs = detectionSystem.msUntilNextSample();
+        if (sampleMs < waitMs) {
+            waitMs = sampleMs;
+        }
+        if (motorControl.isMotorRunning() && MOTOR_POLL_INTERVAL_MS < waitMs) {
+            waitMs = MOTOR_POLL_INTERVAL_MS;
+        }
+        if (console.isDumpingTrace() && TRACE_DUMP_POLL_INTERVAL_MS < waitMs) {
+            waitMs = TRACE_DUMP_POLL_INTERVAL_MS;
+        }
+        systemEventBus.waitForWork(waitMs);
     }
 }
 
@@ -102,9 +131,10 @@ void networkTask(void* parameters) {
     LOG_INFO(Logger::TAG_SYS, "NETWORK_CORE: Task started on Core 0");
     
     while (true) {
-        // Periodically attempt WiFi connection
+        // Periodically attempt WiFi connection; sends the UI snapshot when one is due
         wss.networkLoop();
-        vTaskDelay(pdMS_TO_TICKS(200));
+        // A state change wakes the task early; a held snapshot shortens the sleep
+        wss.waitForWork(NETWORK_POLL_INTERVAL_MS);
     }
 }
 
@@ -121,6 +151,7 @@ void setup() {
     pinMode(LED_BUILTIN, OUTPUT);
     
     LOG_INFO(Logger::TAG_SYS, "Initialising EventBus and CommandBus...");
+    systemEventBus.setTraceRecorder(&traceRecorder);
     LOG_INFO(Logger::TAG_SYS, "Initialising subsystems...");
 
     LOG_INFO(Logger::TAG_SYS, "Initializing Safety Manager...");
@@ -142,9 +173,12 @@ void setup() {
     
     LOG_INFO(Logger::TAG_WS, "Configuring network services...");
     wss.configureWiFi(WIFI_SSID, WIFI_PASSWORD);
+    wss.setBroadcastIntervalMs(WS_SNAPSHOT_INTERVAL_MS);
 
     LOG_INFO(Logger::TAG_EVT, "Beginning state writer subscriptions...");
     stateWriter.beginSubscriptions();
+    // Broadcasts must subscribe after StateWriter so each snapshot already includes the event
+    wss.beginSubscriptions();
 
     LOG_INFO(Logger::TAG_DS, "Initialising Detection System (ultrasonic)...");
     detectionSystem.begin();
@@ -153,8 +187,7 @@ void setup() {
     // Default to simulation mode on boot (both sensors and motor control)
     detectionSystem.setSimulationMode(true);
     motorControl.setSimulationMode(true);
-    auto* simOnBoot = new SimpleEventData(BridgeEvent::SIMULATION_ENABLED);
-    systemEventBus.publish(BridgeEvent::SIMULATION_ENABLED, simOnBoot, EventPriority::NORMAL);
+    systemEventBus.emplace<SimpleEventData>(BridgeEvent::SIMULATION_ENABLED);
 
     LOG_INFO(Logger::TAG_LOC, "Initialising Local State Indicator...");
     localStateIndicator.begin();
@@ -168,6 +201,10 @@ void setup() {
     stateWriter.attachConsole(&console);
     stateWriter.attachSignalControl(&signalControl);
     
+    // All subscribers are registered - freeze the dispatch tables before the tasks start
+    systemEventBus.seal();
+    systemCommandBus.seal();
+
     LOG_INFO(Logger::TAG_SYS, "=== Bridge Control System Ready ===");
     LOG_INFO(Logger::TAG_SYS, "State Machine: %s", stateMachine.getStateString().c_str());
     
@@ -206,7 +243,6 @@ void setup() {
 
 void loop() {
     // Monitor task health
-    safetyManager.update(); // SafetyManager watching
     if (controlLogicTaskHandle != NULL) {
     } else {
         LOG_WARN(Logger::TAG_SYS, "Control Logic task has stopped!");
@@ -0,0 +1,103 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "ActivityLog.h"
+
+// Test: entries come back in order with their fields
+TEST(ActivityLogTest, PushAndRead) {
+    ActivityLog log(8);
+    EXPECT_EQ(log.push(10, 1000, 3, 1, 2), 0u);
+    EXPECT_EQ(log.push(11, 1005, 4), 1u);
+
+    ActivityLog::Entry entries[4];
+    ASSERT_EQ(log.read(0, entries, 4), 2u);
+    EXPECT_EQ(entries[0].seq, 0u);
+    EXPECT_EQ(entries[0].version, 10u);
+    EXPECT_EQ(entries[0].timestampMs, 1000u);
+    EXPECT_EQ(entries[0].code, 3);
+    EXPECT_EQ(entries[0].args[0], 1);
+    EXPECT_EQ(entries[0].args[1], 2);
+    EXPECT_EQ(entries[0].args[2], ActivityLog::NO_ARG);
+    EXPECT_EQ(entries[1].seq, 1u);
+    EXPECT_EQ(log.nextSeq(), 2u);
+    EXPECT_EQ(log.firstSeq(), 0u);
+    EXPECT_EQ(log.droppedVersion(), 0u);
+}
+
+// Test: a read from a cursor returns only the newer entries, and at most max of them
+TEST(ActivityLogTest, ReadFromCursor) {
+    ActivityLog log(8);
+    for (uint32_t i = 0; i < 6; ++i) log.push(i + 1, 0, 0);
+
+    ActivityLog::Entry entries[8];
+    ASSERT_EQ(log.read(4, entries, 8), 2u);
+    EXPECT_EQ(entries[0].seq, 4u);
+    EXPECT_EQ(entries[1].seq, 5u);
+
+    ASSERT_EQ(log.read(1, entries, 2), 2u);
+    EXPECT_EQ(entries[1].seq, 2u);
+    EXPECT_EQ(log.read(6, entries, 8), 0u);
+}
+
+// Test: a full ring overwrites its oldest entries and remembers what it dropped
+TEST(ActivityLogTest, WrapsWithoutGrowing) {
+    ActivityLog log(4);
+    for (uint32_t i = 0; i < 10; ++i) log.push(100 + i, 0, 0);
+
+    EXPECT_EQ(log.capacity(), 4u);
+    EXPECT_EQ(log.nextSeq(), 10u);
+    EXPECT_EQ(log.firstSeq(), 6u);
+    EXPECT_EQ(log.droppedVersion(), 105u);
+
+    // A cursor behind the ring starts at the oldest entry still held
+    ActivityLog::Entry entries[8];
+    ASSERT_EQ(log.read(2, entries, 8), 4u);
+    EXPECT_EQ(entries[0].seq, 6u);
+    EXPECT_EQ(entries[0].version, 106u);
+    EXPECT_EQ(entries[3].seq, 9u);
+}
+
+// Test: the first line after a state version, as a patch needs it
+TEST(ActivityLogTest, FirstSeqAfterVersion) {
+    ActivityLog log(4);
+    log.push(2, 0, 0);  // seq 0
+    log.push(5, 0, 0);  // seq 1
+    log.push(6, 0, 0);  // seq 2
+
+    EXPECT_EQ(log.firstSeqAfterVersion(0), 0u);
+    EXPECT_EQ(log.firstSeqAfterVersion(2), 1u);
+    EXPECT_EQ(log.firstSeqAfterVersion(4), 1u);
+    EXPECT_EQ(log.firstSeqAfterVersion(6), 3u);  // Nothing newer
+
+    log.push(9, 0, 0);
+    log.push(12, 0, 0);  // Overwrites seq 0
+    EXPECT_EQ(log.firstSeqAfterVersion(0), 1u);  // Clamped to the oldest held
+}
+
+// Test: readers on another task only ever see whole entries
+TEST(ActivityLogTest, ConcurrentReadsSeeWholeEntries) {
+    ActivityLog log(64);
+    constexpr uint32_t PUSHES = 50000;
+    std::thread writer([&log]() {
+        for (uint32_t i = 0; i < PUSHES; ++i) {
+            log.push(i + 1, i, static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8));
+        }
+    });
+
+    uint32_t bad = 0;
+    ActivityLog::Entry entries[16];
+    while (log.nextSeq() < PUSHES) {
+        const uint32_t next = log.nextSeq();
+        const size_t count = log.read(next > 16 ? next - 16 : 0, entries, 16);
+        for (size_t i = 0; i < count; ++i) {
+            const ActivityLog::Entry& e = entries[i];
+            if (e.version != e.seq + 1 || e.timestampMs != e.seq || e.code != static_cast<uint8_t>(e.seq)) ++bad;
+            if (i > 0 && e.seq != entries[i - 1].seq + 1) ++bad;
+        }
+    }
+    writer.join();
+    EXPECT_EQ(bad, 0u);
+}
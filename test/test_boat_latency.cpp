@@ -0,0 +1,49 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include "BoatLatency.h"
+#include "DetectionSystem.h"
+
+// Test: every simulated boat gets from threshold crossing to the motor, and the fixed
+// waits are exactly the designed ones (software latency is reported, not asserted)
+TEST(BoatLatencyTest, EveryBoatReachesTheMotor) {
+    BoatLatency::Options options;
+    options.boats = 200;
+    BoatLatency harness;
+    const std::vector<BoatLatencySample> samples = harness.run(options);
+
+    EXPECT_EQ(harness.lastStats().failed, 0u);
+    ASSERT_EQ(samples.size(), options.boats);
+    for (const BoatLatencySample& s : samples) {
+        EXPECT_GE(s.debounceMs, DetectionSystem::DETECT_HOLD_MS);
+        EXPECT_LT(s.debounceMs, DetectionSystem::DETECT_HOLD_MS + DetectionSystem::SAMPLE_INTERVAL_MS);
+        EXPECT_EQ(s.signalSequenceMs, 12000u);  // Yellow warning + red clearance
+        EXPECT_GE(s.detectUs, 0.0);
+        EXPECT_GE(s.dispatchUs, 0.0);
+        EXPECT_GE(s.stateMachineUs, 0.0);
+        EXPECT_GE(s.controllerUs, 0.0);
+        EXPECT_GE(s.raiseDispatchUs, 0.0);
+        EXPECT_GE(s.raiseStateMachineUs, 0.0);
+        EXPECT_GE(s.raiseControllerUs, 0.0);
+    }
+}
+
+// Test: the same seed gives the same simulated timeline
+TEST(BoatLatencyTest, SeedIsDeterministic) {
+    BoatLatency::Options options;
+    options.boats = 50;
+    options.seed = 7;
+    BoatLatency first;
+    BoatLatency second;
+    const std::vector<BoatLatencySample> a = first.run(options);
+    const std::vector<BoatLatencySample> b = second.run(options);
+
+    ASSERT_EQ(a.size(), b.size());
+    EXPECT_EQ(first.lastStats().virtualMs, second.lastStats().virtualMs);
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].debounceMs, b[i].debounceMs);
+        EXPECT_EQ(a[i].signalSequenceMs, b[i].signalSequenceMs);
+    }
+}
@@ -0,0 +1,151 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+#include "BridgeStateMachine.h"
+#include "Clock.h"
+#include "CommandBus.h"
+#include "EventBus.h"
+#include "Logger.h"
+#include "SignalControl.h"
+#include "VirtualClock.h"
+
+namespace {
+
+// Installs a VirtualClock for the lifetime of a test
+class VirtualClockTest : public ::testing::Test {
+protected:
+    void SetUp() override { previous_ = Clock::install(&clock); }
+    void TearDown() override { Clock::install(previous_); }
+
+    VirtualClock clock;
+
+private:
+    Clock* previous_ = nullptr;
+};
+
+}  // namespace
+
+// Test: the default clock is the host stand-in for Arduino millis(); install(nullptr) restores it
+TEST(ClockTest, SystemClockIsDefault) {
+    mock_millis = 1234;
+    EXPECT_EQ(Clock::millis(), 1234u);
+
+    VirtualClock virtualClock(50);
+    Clock* previous = Clock::install(&virtualClock);
+    EXPECT_EQ(Clock::millis(), 50u);
+    EXPECT_EQ(Clock::micros(), 50000u);
+    EXPECT_EQ(Clock::install(nullptr), &virtualClock);
+    EXPECT_EQ(Clock::millis(), 1234u);
+    Clock::install(previous);
+    mock_millis = 0;
+}
+
+// Test: EventBus timers follow the installed clock and fire on their exact deadline
+TEST_F(VirtualClockTest, RunUntilStopsOnEveryDeadline) {
+    EventBus bus;
+    std::vector<uint32_t> firedAt;
+    bus.callAfter(250, [f = &firedAt]() { f->push_back(Clock::millis()); });
+    bus.callAfter(100, [f = &firedAt]() { f->push_back(Clock::millis()); });
+    bus.subscribe(BridgeEvent::BOAT_PASSED, [f = &firedAt](EventData*) { f->push_back(Clock::millis() + 1000000); });
+    bus.publishAfter(175, BridgeEvent::BOAT_PASSED);
+
+    clock.advance(50);
+    EXPECT_EQ(bus.processEvents(), 0u);  // advance() alone dispatches nothing
+    EXPECT_TRUE(firedAt.empty());
+
+    EXPECT_EQ(clock.runUntil(bus, 1000), 3u);
+    EXPECT_EQ(clock.nowMs(), 1000u);
+    EXPECT_EQ(firedAt, (std::vector<uint32_t>{100, 1000175, 250}));
+    EXPECT_EQ(clock.runUntil(bus, 500), 0u);  // In the past - nothing to do
+    EXPECT_EQ(clock.nowMs(), 1000u);
+}
+
+// Test: runUntilIdle stops when nothing is armed, and gives up on a timer that re-arms forever
+TEST_F(VirtualClockTest, RunUntilIdle) {
+    EventBus bus;
+    bus.callAfter(30000, []() {});
+    EXPECT_TRUE(clock.runUntilIdle(bus, 60000));
+    EXPECT_EQ(clock.nowMs(), 30000u);
+
+    struct Blink {
+        EventBus* bus;
+        int ticks = 0;
+        void arm() { bus->callAfter(500, [this]() { ticks++; arm(); }); }
+    } blink{&bus};
+    blink.arm();
+    EXPECT_FALSE(clock.runUntilIdle(bus, 10000));
+    EXPECT_EQ(clock.nowMs(), 40000u);
+    EXPECT_EQ(blink.ticks, 20);
+    bus.clear();
+}
+
+// Test: a full boat cycle with the real SignalControl (12 s stop, 45 s green, 45 s cooldown)
+// and a simulated motor runs to the exact millisecond far faster than real time
+TEST_F(VirtualClockTest, FullBridgeCycle) {
+    static constexpr uint32_t MOTOR_TRAVEL_MS = 8000;
+    const Logger::Level previousLevel = Logger::getLevel();
+    Logger::setLevel(Logger::Level::NONE);
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    EventBus bus;
+    CommandBus commandBus;
+    SignalControl signals(bus);
+    BridgeStateMachine fsm(bus, commandBus);
+
+    struct Rig {
+        EventBus* bus;
+        SignalControl* signals;
+        std::vector<std::pair<uint32_t, BridgeState>> states;
+    } rig{&bus, &signals, {}};
+
+    commandBus.subscribe(CommandTarget::SIGNAL_CONTROL, [r = &rig](const Command& command) {
+        switch (command.action) {
+            case CommandAction::STOP_TRAFFIC: r->signals->stopTraffic(); break;
+            case CommandAction::RESUME_TRAFFIC: r->signals->resumeTraffic(); break;
+            case CommandAction::START_BOAT_GREEN_PERIOD: r->signals->startBoatGreenPeriod(command.data); break;
+            case CommandAction::END_BOAT_GREEN_PERIOD: r->signals->endBoatGreenPeriod(); break;
+            default: break;
+        }
+    });
+    commandBus.subscribe(CommandTarget::MOTOR_CONTROL, [r = &rig](const Command& command) {
+        const BridgeEvent done = command.action == CommandAction::RAISE_BRIDGE ? BridgeEvent::BRIDGE_OPENED_SUCCESS
+                                                                                : BridgeEvent::BRIDGE_CLOSED_SUCCESS;
+        r->bus->publishAfter(MOTOR_TRAVEL_MS, done);
+    });
+    bus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED, [r = &rig](const StateChangeData& change) {
+        r->states.emplace_back(Clock::millis(), change.getNewState());
+    });
+    signals.begin();
+    fsm.begin();
+    VirtualClock::drain(bus);
+    rig.states.clear();
+
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
+    clock.runUntil(bus, 30000);
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_PASSED_LEFT, BoatEventSide::LEFT);
+    clock.runUntil(bus, 80000);
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT);  // During cooldown
+    clock.runUntil(bus, 121000);
+
+    const double wallUs =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wallStart).count();
+    Logger::setLevel(previousLevel);
+
+    using S = BridgeState;
+    const std::vector<std::pair<uint32_t, BridgeState>> expected = {
+        {0, S::STOPPING_TRAFFIC},
+        {12000, S::OPENING},
+        {12000 + MOTOR_TRAVEL_MS, S::OPEN},
+        {20000 + BOAT_GREEN_PERIOD_MS, S::CLOSING},
+        {65000 + MOTOR_TRAVEL_MS, S::RESUMING_TRAFFIC},
+        {75000, S::IDLE},
+        {75000 + BOAT_CYCLE_COOLDOWN_MS, S::STOPPING_TRAFFIC},
+    };
+    EXPECT_EQ(rig.states, expected);
+    EXPECT_LT(wallUs * 1000.0, 121000.0 * 1000.0);  // At least 1000x real time
+    bus.clear();
+}
@@ -0,0 +1,45 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include "CommandBus.h"
+
+// Test: commands reach only the subscribers of their target, before and after seal()
+TEST(CommandBusTest, RoutesByTargetBeforeAndAfterSeal) {
+    CommandBus bus;
+    int motorCalls = 0;
+    int signalCalls = 0;
+    bus.subscribe(CommandTarget::MOTOR_CONTROL, [&motorCalls](const Command&) { motorCalls++; });
+    bus.subscribe(CommandTarget::SIGNAL_CONTROL, [&signalCalls](const Command&) { signalCalls++; });
+
+    Command cmd;
+    cmd.target = CommandTarget::SIGNAL_CONTROL;
+    cmd.action = CommandAction::STOP_TRAFFIC;
+    bus.publish(cmd);
+    EXPECT_EQ(signalCalls, 1);
+    EXPECT_EQ(motorCalls, 0);
+
+    bus.seal();
+    bus.publish(cmd);
+    EXPECT_EQ(signalCalls, 2);
+    EXPECT_FALSE(bus.hasSubscribers(CommandTarget::SAFETY_MANAGER));
+}
+
+// Test: the table cannot change once sealed
+TEST(CommandBusTest, SealRejectsChanges) {
+    CommandBus bus;
+    int calls = 0;
+    bus.subscribe(CommandTarget::CONTROLLER, [&calls](const Command&) { calls++; });
+    bus.seal();
+
+    bus.subscribe(CommandTarget::CONTROLLER, [&calls](const Command&) { calls += 100; });
+    bus.unsubscribe(CommandTarget::CONTROLLER);
+    EXPECT_TRUE(bus.hasSubscribers(CommandTarget::CONTROLLER));
+
+    Command cmd;
+    cmd.target = CommandTarget::CONTROLLER;
+    cmd.action = CommandAction::ENTER_SAFE_STATE;
+    bus.publish(cmd);
+    EXPECT_EQ(calls, 1);
+}
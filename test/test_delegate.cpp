@@ -0,0 +1,165 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+#include "CommandBus.h"
+#include "Delegate.h"
+#include "EventBus.h"
+
+// Count every global heap allocation made by this test binary
+static std::atomic<size_t> g_heapAllocations{0};
+
+void* operator new(size_t size) {
+    g_heapAllocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Shaped like the firmware's subscribers: a member function reached through `this`
+class Handler {
+public:
+    void onCommand(const Command& command) { total_ += static_cast<int>(command.action) + 1; }
+    int total() const { return total_; }
+
+private:
+    int total_ = 0;
+};
+
+struct TooBig {
+    char bytes[DELEGATE_STORAGE_SIZE + 1];
+    void operator()(const Command&) const {}
+};
+
+using CommandDelegate = Delegate<void(const Command&)>;
+
+// Compile-time guarantee: a callable larger than the inline buffer is rejected, not heap-allocated
+static_assert(!CommandDelegate::fits<TooBig>(), "oversized callable must be rejected");
+
+} // namespace
+
+// Test: construction, copy, move and member binding, none of which touch the heap
+TEST(DelegateTest, StoresCallablesInlineWithoutAllocating) {
+    Handler handler;
+    Command cmd;
+    cmd.target = CommandTarget::CONTROLLER;
+    cmd.action = CommandAction::ENTER_SAFE_STATE;
+
+    // The shapes used by the firmware's subscribers fit
+    auto thisLambda = [self = &handler](const Command& c) { self->onCommand(c); };
+    auto thisAndValue = [self = &handler, ev = BridgeEvent::FAULT_DETECTED](const Command& c) {
+        if (ev == BridgeEvent::FAULT_DETECTED) self->onCommand(c);
+    };
+    static_assert(CommandDelegate::fits<decltype(thisLambda)>(), "[this] lambda must fit");
+    static_assert(CommandDelegate::fits<decltype(thisAndValue)>(), "[this, value] lambda must fit");
+
+    const size_t before = g_heapAllocations.load();
+    {
+        CommandDelegate empty;
+        EXPECT_FALSE(empty);
+
+        CommandDelegate lambda = [&handler](const Command& c) { handler.onCommand(c); };
+        auto bound = CommandDelegate::bind<&Handler::onCommand>(&handler);
+        CommandDelegate copy = lambda;
+        CommandDelegate moved = std::move(bound);
+        EXPECT_FALSE(bound);
+
+        lambda(cmd);
+        copy(cmd);
+        moved(cmd);
+        empty = moved;
+        empty(cmd);
+    }
+    EXPECT_EQ(g_heapAllocations.load(), before);
+    EXPECT_EQ(handler.total(), 4 * (static_cast<int>(CommandAction::ENTER_SAFE_STATE) + 1));
+}
+
+// Test: subscribe() tokens remove exactly one subscription on both buses
+TEST(DelegateTest, TokenUnsubscribeRemovesOneSubscriber) {
+    CommandBus commandBus;
+    int first = 0;
+    int second = 0;
+    SubscriptionId a = commandBus.subscribe(CommandTarget::MOTOR_CONTROL, [&first](const Command&) { first++; });
+    SubscriptionId b = commandBus.subscribe(CommandTarget::MOTOR_CONTROL, [&second](const Command&) { second++; });
+    EXPECT_NE(a, INVALID_SUBSCRIPTION_ID);
+    EXPECT_NE(a, b);
+
+    EXPECT_TRUE(commandBus.unsubscribe(a));
+    EXPECT_FALSE(commandBus.unsubscribe(a));
+    Command cmd;
+    cmd.target = CommandTarget::MOTOR_CONTROL;
+    cmd.action = CommandAction::LOWER_BRIDGE;
+    commandBus.publish(cmd);
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 1);
+
+    EventBus eventBus;
+    int normal = 0;
+    int typed = 0;
+    SubscriptionId n = eventBus.subscribe(BridgeEvent::BOAT_PASSED, [&normal](EventData*) { normal++; });
+    SubscriptionId t = eventBus.subscribe<SimpleEventData>(BridgeEvent::BOAT_PASSED, [&typed](const SimpleEventData&) { typed++; });
+    EXPECT_TRUE(eventBus.unsubscribe(t));
+    eventBus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    eventBus.processEvents();
+    EXPECT_EQ(normal, 1);
+    EXPECT_EQ(typed, 0);
+
+    eventBus.seal();
+    EXPECT_EQ(eventBus.subscribe(BridgeEvent::BOAT_PASSED, [](EventData*) {}), INVALID_SUBSCRIPTION_ID);
+    EXPECT_TRUE(eventBus.unsubscribe(n));  // Still allowed once sealed - the entry is skipped
+    eventBus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    eventBus.processEvents();
+    EXPECT_EQ(normal, 1);
+}
+
+// Test: a table of `this`-capturing Delegates calls the same handlers as std::function and
+// never allocates on dispatch (per-call cost: BM_DispatchStdFunction / BM_DispatchDelegate in bench/)
+TEST(DelegateTest, DispatchMatchesStdFunctionWithoutAllocating) {
+    constexpr int SUBSCRIBERS = 4;
+    constexpr int ROUNDS = 1000;
+    Handler viaFunction[SUBSCRIBERS];
+    Handler viaDelegate[SUBSCRIBERS];
+    Command cmd;
+    cmd.target = CommandTarget::MOTOR_CONTROL;
+    cmd.action = CommandAction::RAISE_BRIDGE;
+
+    std::vector<std::function<void(const Command&)>> functions;
+    std::vector<CommandDelegate> delegates;
+    delegates.reserve(SUBSCRIBERS);
+    for (int i = 0; i < SUBSCRIBERS; ++i) {
+        Handler* f = &viaFunction[i];
+        Handler* d = &viaDelegate[i];
+        functions.emplace_back([f](const Command& c) { f->onCommand(c); });
+        delegates.emplace_back([d](const Command& c) { d->onCommand(c); });
+    }
+
+    const size_t before = g_heapAllocations.load();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const auto& callback : delegates) {
+            callback(cmd);
+        }
+    }
+    EXPECT_EQ(g_heapAllocations.load(), before);
+
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const auto& callback : functions) {
+            callback(cmd);
+        }
+    }
+    for (int i = 0; i < SUBSCRIBERS; ++i) {
+        EXPECT_EQ(viaDelegate[i].total(), viaFunction[i].total());
+    }
+    EXPECT_EQ(viaDelegate[0].total(), ROUNDS * (static_cast<int>(CommandAction::RAISE_BRIDGE) + 1));
+}
@@ -4,6 +4,7 @@ unsigned long mock_millis = 0;
 
 #include <gtest/gtest.h>
 #include "DetectionSystem.h"
+#include "NativeHal.h"
 
 
 // Mock EventBus to capture published events
@@ -13,23 +14,36 @@ public:
     void publish(BridgeEvent eventType, EventData* eventData = nullptr, EventPriority priority = EventPriority::NORMAL) /* no override */ {
         lastEvent = eventType;
     }
+    void publishPayload(BridgeEvent eventType, EventPayload&& payload, EventPriority priority = EventPriority::NORMAL) override {
+        lastEvent = eventType;
+    }
 };
 
 // Test: Check if the DetectionSystem initializes correctly
 TEST(DetectionSystemTest, InitializationTest) {
     // Arrange: Create a mock EventBus for testing
     MockEventBus mockEventBus;
+
+    // The right sensor sees nothing and the beam break receiver reads HIGH (clear)
+    NativeHal::reset();
+    NativeHal::setDigitalInput(35, HIGH);
     
     // Act: Create DetectionSystem with the mock EventBus
     DetectionSystem system(mockEventBus);
     
     // Initialize the system
     system.begin();
-     // Simulate time passing for debounce
-    //for (int i = 0; i < 2; ++i) {
-        mock_millis = 1001; // Advance time by debounceDelay
+
+    // A boat approaches the left sensor (HC-SR04 echo: cm * 58 us): first seen ~15 cm
+    // away, then held ~5 cm away for longer than the detection debounce
+    NativeHal::setPulseWidth(33, 15 * 58);
+    mock_millis = 1001;
+    system.update();
+    NativeHal::setPulseWidth(33, 5 * 58);
+    for (int i = 0; i < 12; ++i) {
+        mock_millis += 100; // One sample interval
         system.update();
-    //}
+    }
 
 
     // Assert: Check if the system is initialized correctly (assuming isInitialized() exists)
@@ -0,0 +1,661 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "EventBus.h"
+
+namespace {
+
+// Payload that counts destructions so tests can check the bus frees what it owns
+int g_payloadsDeleted = 0;
+
+class CountingEventData : public SimpleEventData {
+public:
+    explicit CountingEventData(BridgeEvent eventType) : SimpleEventData(eventType) {}
+    ~CountingEventData() override { g_payloadsDeleted++; }
+};
+
+BridgeEvent burstEvent(int i) {
+    return (i % 2) ? BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS : BridgeEvent::BOAT_DETECTED_LEFT;
+}
+
+EventPriority burstPriority(int i) {
+    // One in ten events is safety-critical, matching beam-break/fault traffic mixed into sensor bursts
+    return (i % 10 == 0) ? EventPriority::EMERGENCY : EventPriority::NORMAL;
+}
+
+} // namespace
+
+// Test: EMERGENCY events are dispatched before NORMAL ones, FIFO within each priority
+TEST(EventBusQueueTest, EmergencyBeforeNormalAndFifoWithinPriority) {
+    EventBus bus;
+    std::vector<BridgeEvent> order;
+    auto record = [&order](EventData* d) { order.push_back(d->getEventEnum()); };
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, record);
+    bus.subscribe(BridgeEvent::BOAT_PASSED, record);
+    bus.subscribe(BridgeEvent::FAULT_DETECTED, record);
+    bus.subscribe(BridgeEvent::BEAM_BREAK_ACTIVE, record);
+
+    bus.publish(BridgeEvent::BOAT_DETECTED, new SimpleEventData(BridgeEvent::BOAT_DETECTED));
+    bus.publish(BridgeEvent::FAULT_DETECTED, new SimpleEventData(BridgeEvent::FAULT_DETECTED), EventPriority::EMERGENCY);
+    bus.publish(BridgeEvent::BOAT_PASSED, new SimpleEventData(BridgeEvent::BOAT_PASSED));
+    bus.publish(BridgeEvent::BEAM_BREAK_ACTIVE, new SimpleEventData(BridgeEvent::BEAM_BREAK_ACTIVE), EventPriority::EMERGENCY);
+
+    bus.processEvents();
+
+    std::vector<BridgeEvent> expected = {
+        BridgeEvent::FAULT_DETECTED, BridgeEvent::BEAM_BREAK_ACTIVE,
+        BridgeEvent::BOAT_DETECTED, BridgeEvent::BOAT_PASSED
+    };
+    EXPECT_EQ(order, expected);
+}
+
+// Test: a full ring drops the incoming event, frees its payload and counts the drop
+TEST(EventBusQueueTest, OverflowDropsNewestAndCounts) {
+    EventBus bus(2, 3);
+    g_payloadsDeleted = 0;
+
+    for (int i = 0; i < 5; ++i) {
+        bus.publish(BridgeEvent::BOAT_DETECTED, new CountingEventData(BridgeEvent::BOAT_DETECTED));
+    }
+    for (int i = 0; i < 4; ++i) {
+        bus.publish(BridgeEvent::FAULT_DETECTED, new CountingEventData(BridgeEvent::FAULT_DETECTED), EventPriority::EMERGENCY);
+    }
+
+    EventQueueStats stats = bus.getQueueStats();
+    EXPECT_EQ(stats.normalDropped, 2u);
+    EXPECT_EQ(stats.emergencyDropped, 2u);
+    EXPECT_EQ(stats.normalHighWater, 3u);
+    EXPECT_EQ(stats.emergencyHighWater, 2u);
+    EXPECT_EQ(g_payloadsDeleted, 4);  // Dropped payloads are freed immediately
+
+    bus.processEvents();
+    EXPECT_EQ(g_payloadsDeleted, 9);  // Accepted payloads are freed after dispatch
+}
+
+// Test: the rings wrap around without growing
+TEST(EventBusQueueTest, RingWrapsWithoutGrowing) {
+    EventBus bus(4, 4);
+    int dispatched = 0;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [&dispatched](EventData*) { dispatched++; });
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            bus.publish(BridgeEvent::BOAT_DETECTED, new SimpleEventData(BridgeEvent::BOAT_DETECTED));
+        }
+        bus.processEvents();
+    }
+
+    EventQueueStats stats = bus.getQueueStats();
+    EXPECT_EQ(dispatched, 30);
+    EXPECT_EQ(stats.normalCapacity, 4u);
+    EXPECT_EQ(stats.normalDropped, 0u);
+}
+
+// Test: a 10k-event burst (10% EMERGENCY) through rings sized for it is dispatched in full,
+// every EMERGENCY event ahead of the NORMAL ones (timing: BM_Burst10kRingQueues in bench/)
+TEST(EventBusQueueTest, Burst10kDispatchesEverythingEmergencyFirst) {
+    constexpr int BURST = 10000;
+    EventBus bus(BURST, BURST);
+    std::vector<BridgeEvent> order;
+    order.reserve(BURST);
+    auto record = [&order](EventData* d) { order.push_back(d->getEventEnum()); };
+    bus.subscribe(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, record);
+    bus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, record);
+
+    int emergencies = 0;
+    for (int i = 0; i < BURST; ++i) {
+        bus.publish(burstEvent(i), new SimpleEventData(burstEvent(i)), burstPriority(i));
+        emergencies += burstPriority(i) == EventPriority::EMERGENCY;
+    }
+    bus.processEvents();
+
+    ASSERT_EQ(order.size(), static_cast<size_t>(BURST));
+    // Only even i are EMERGENCY, and even i publish BOAT_DETECTED_LEFT
+    for (int i = 0; i < emergencies; ++i) {
+        ASSERT_EQ(order[i], BridgeEvent::BOAT_DETECTED_LEFT) << "position " << i;
+    }
+    EventQueueStats stats = bus.getQueueStats();
+    EXPECT_EQ(stats.normalDropped, 0u);
+    EXPECT_EQ(stats.emergencyDropped, 0u);
+}
+
+// Test: sealing freezes the subscriber table but dispatch keeps working
+TEST(EventBusSealTest, SealRejectsLateSubscribersAndStillDispatches) {
+    EventBus bus;
+    int early = 0;
+    int late = 0;
+    bus.subscribe(BridgeEvent::STATE_CHANGED, [&early](EventData*) { early++; });
+    bus.seal();
+    EXPECT_TRUE(bus.isSealed());
+
+    bus.subscribe(BridgeEvent::STATE_CHANGED, [&late](EventData*) { late++; });
+    EXPECT_TRUE(bus.hasSubscriptions(BridgeEvent::STATE_CHANGED));
+    EXPECT_FALSE(bus.hasSubscriptions(BridgeEvent::BOAT_DETECTED));
+
+    bus.publish(BridgeEvent::STATE_CHANGED, new StateChangeData(BridgeState::OPEN, BridgeState::OPENING));
+    bus.processEvents();
+    EXPECT_EQ(early, 1);
+    EXPECT_EQ(late, 0);
+
+    bus.clear();
+    EXPECT_FALSE(bus.isSealed());
+}
+
+// Test: typed subscribers get const T& for inline payloads and for pointer-API payloads of the same kind
+TEST(EventBusPayloadTest, TypedSubscriberSeesInlineAndPointerPayloads) {
+    EventBus bus;
+    std::vector<BridgeState> states;
+    int legacyCalls = 0;
+    bus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED, [&states](const StateChangeData& d) {
+        states.push_back(d.getNewState());
+    });
+    bus.subscribe(BridgeEvent::STATE_CHANGED, [&legacyCalls](EventData* d) {
+        // Pointer-API subscribers still receive an EventData* for inline payloads
+        if (d && d->getEventEnum() == BridgeEvent::STATE_CHANGED) legacyCalls++;
+    });
+
+    bus.emplace<StateChangeData>(BridgeState::OPENING, BridgeState::STOPPING_TRAFFIC);
+    bus.publish(BridgeEvent::STATE_CHANGED, new StateChangeData(BridgeState::OPEN, BridgeState::OPENING));
+    // Wrong payload type for the event - the typed subscriber must skip it rather than mis-cast
+    bus.publish(BridgeEvent::STATE_CHANGED, new SimpleEventData(BridgeEvent::STATE_CHANGED));
+    bus.processEvents();
+
+    std::vector<BridgeState> expected = {BridgeState::OPENING, BridgeState::OPEN};
+    EXPECT_EQ(states, expected);
+    EXPECT_EQ(legacyCalls, 3);
+}
+
+// Test: full batches through the pointer API and as inline payloads deliver the same values
+// (per-event cost: BM_EventBusPublishProcessPointer / BM_EventBusPublishProcessTyped in bench/)
+TEST(EventBusPayloadTest, PointerAndInlineBatchesDeliverSameValues) {
+    constexpr int BATCH = 50;  // Fits the default NORMAL ring
+    constexpr int BATCHES = 20;
+
+    EventBus pointerBus;
+    long pointerSum = 0;
+    pointerBus.subscribe(BridgeEvent::STATE_CHANGED, [&pointerSum](EventData* d) {
+        if (d && d->getEventEnum() == BridgeEvent::STATE_CHANGED) {
+            pointerSum += static_cast<int>(static_cast<StateChangeData*>(d)->getNewState());
+        }
+    });
+    pointerBus.seal();
+
+    EventBus inlineBus;
+    long inlineSum = 0;
+    inlineBus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED, [&inlineSum](const StateChangeData& d) {
+        inlineSum += static_cast<int>(d.getNewState());
+    });
+    inlineBus.seal();
+
+    for (int b = 0; b < BATCHES; ++b) {
+        for (int i = 0; i < BATCH; ++i) {
+            pointerBus.publish(BridgeEvent::STATE_CHANGED, new StateChangeData(BridgeState::OPEN, BridgeState::OPENING));
+            inlineBus.emplace<StateChangeData>(BridgeState::OPEN, BridgeState::OPENING);
+        }
+        pointerBus.processEvents();
+        inlineBus.processEvents();
+    }
+
+    const long events = static_cast<long>(BATCH) * BATCHES;
+    EXPECT_EQ(pointerSum, inlineSum);
+    EXPECT_EQ(inlineSum, events * static_cast<int>(BridgeState::OPEN));
+    EXPECT_EQ(pointerBus.getQueueStats().normalDropped, 0u);
+    EXPECT_EQ(inlineBus.getQueueStats().normalDropped, 0u);
+}
+
+// Test: maxEvents caps one call; the rest carries over to the next call in order
+TEST(EventBusBudgetTest, MaxEventsCarriesRemainderOver) {
+    EventBus bus;
+    std::vector<int> seen;
+    bus.subscribe<BoatEventData>(BridgeEvent::BOAT_DETECTED, [&seen](const BoatEventData& d) {
+        seen.push_back(d.getBoatEventSide() == BoatEventSide::LEFT ? 0 : 1);
+    });
+    bus.seal();
+
+    for (int i = 0; i < 10; ++i) {
+        bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED, (i % 2) ? BoatEventSide::RIGHT : BoatEventSide::LEFT);
+    }
+
+    EXPECT_EQ(bus.processEvents(4), 4u);
+    EXPECT_EQ(seen.size(), 4u);
+    EXPECT_EQ(bus.processEvents(4), 4u);
+    EXPECT_EQ(bus.processEvents(4), 2u);
+    EXPECT_EQ(bus.processEvents(4), 0u);
+
+    ASSERT_EQ(seen.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(seen[i], i % 2);
+    }
+    EXPECT_EQ(bus.getQueueStats().budgetStops, 2u);  // The last full call had nothing left
+}
+
+// Test: a slow subscriber makes the time budget stop the call early, but at least one event runs
+TEST(EventBusBudgetTest, TimeBudgetStopsEarly) {
+    EventBus bus;
+    int calls = 0;
+    bus.subscribe(BridgeEvent::BOAT_PASSED, [&calls](EventData*) {
+        calls++;
+        const unsigned long start = micros();
+        while (micros() - start < 500) {
+            // Busy-wait like a subscriber doing slow I/O
+        }
+    });
+    bus.seal();
+
+    for (int i = 0; i < 20; ++i) {
+        bus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    }
+
+    const size_t first = bus.processEvents(EventBus::NO_EVENT_LIMIT, 1000);
+    EXPECT_GE(first, 1u);
+    EXPECT_LE(first, 3u);
+
+    // A budget smaller than one callback still makes progress
+    EXPECT_EQ(bus.processEvents(EventBus::NO_EVENT_LIMIT, 1), 1u);
+
+    bus.processEvents();
+    EXPECT_EQ(calls, 20);
+}
+
+// Test: an EMERGENCY event published mid-drain runs before the NORMAL events already taken
+TEST(EventBusBudgetTest, EmergencyPreemptsCarriedOverNormalEvents) {
+    EventBus bus;
+    std::vector<BridgeEvent> order;
+    bool faultRaised = false;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [&](EventData*) {
+        order.push_back(BridgeEvent::BOAT_DETECTED);
+        if (!faultRaised) {
+            faultRaised = true;
+            bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+        }
+    });
+    bus.subscribe(BridgeEvent::FAULT_DETECTED, [&order](EventData*) {
+        order.push_back(BridgeEvent::FAULT_DETECTED);
+    });
+    bus.seal();
+
+    for (int i = 0; i < 4; ++i) {
+        bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    }
+    bus.processEvents();
+
+    std::vector<BridgeEvent> expected = {
+        BridgeEvent::BOAT_DETECTED, BridgeEvent::FAULT_DETECTED,
+        BridgeEvent::BOAT_DETECTED, BridgeEvent::BOAT_DETECTED, BridgeEvent::BOAT_DETECTED
+    };
+    EXPECT_EQ(order, expected);
+}
+
+// Test: the queue lock is not held while callbacks run, so another thread can publish
+TEST(EventBusBudgetTest, PublishFromOtherThreadDuringDispatch) {
+    EventBus bus;
+    int boats = 0;
+    bool otherThreadPublished = false;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [&](EventData*) {
+        if (boats++ == 0) {
+            // Would deadlock if processEvents() held eventQueue_mutex across the callback
+            std::thread publisher([&bus]() { bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED); });
+            publisher.join();
+            otherThreadPublished = true;
+        }
+    });
+    bus.seal();
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    EXPECT_EQ(bus.processEvents(), 2u);
+    EXPECT_TRUE(otherThreadPublished);
+    EXPECT_EQ(boats, 2);
+}
+
+// Test: EMERGENCY subscribers run before NORMAL ones for the same event, registration order within each
+TEST(EventBusSubscriberPriorityTest, EmergencySubscribersRunFirst) {
+    EventBus bus;
+    std::vector<int> order;
+    bus.subscribe(BridgeEvent::FAULT_DETECTED, [&order](EventData*) { order.push_back(1); });
+    bus.subscribe(BridgeEvent::FAULT_DETECTED, [&order](EventData*) { order.push_back(2); }, EventPriority::EMERGENCY);
+    bus.subscribe<SimpleEventData>(BridgeEvent::FAULT_DETECTED, [&order](const SimpleEventData&) { order.push_back(3); });
+    bus.subscribe<SimpleEventData>(BridgeEvent::FAULT_DETECTED, [&order](const SimpleEventData&) { order.push_back(4); },
+                                   EventPriority::EMERGENCY);
+    bus.seal();
+
+    bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+    bus.processEvents();
+
+    std::vector<int> expected = {2, 4, 1, 3};
+    EXPECT_EQ(order, expected);
+}
+
+// Test: a callback can remove itself and a later subscriber of the same event mid-dispatch
+TEST(EventBusUnsubscribeTest, UnsubscribeFromInsideCallback) {
+    EventBus bus;
+    int once = 0;
+    int victim = 0;
+    int steady = 0;
+    SubscriptionId onceId = INVALID_SUBSCRIPTION_ID;
+    SubscriptionId victimId = INVALID_SUBSCRIPTION_ID;
+    onceId = bus.subscribe(BridgeEvent::BOAT_PASSED, [&](EventData*) {
+        once++;
+        EXPECT_TRUE(bus.unsubscribe(onceId));
+        EXPECT_TRUE(bus.unsubscribe(victimId));
+        EXPECT_FALSE(bus.unsubscribe(victimId));  // Already removed
+    });
+    victimId = bus.subscribe(BridgeEvent::BOAT_PASSED, [&victim](EventData*) { victim++; });
+    bus.subscribe(BridgeEvent::BOAT_PASSED, [&steady](EventData*) { steady++; });
+
+    for (int i = 0; i < 3; ++i) {
+        bus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    }
+    bus.processEvents();
+
+    EXPECT_EQ(once, 1);
+    EXPECT_EQ(victim, 0);  // Removed before its turn in the same dispatch
+    EXPECT_EQ(steady, 3);
+    EXPECT_TRUE(bus.hasSubscriptions(BridgeEvent::BOAT_PASSED));
+}
+
+// Test: subscribing from a callback takes effect from the next event, and stale tokens stay dead
+TEST(EventBusUnsubscribeTest, DeferredSubscribeAndStaleTokens) {
+    EventBus bus;
+    int probe = 0;
+    SubscriptionId probeId = INVALID_SUBSCRIPTION_ID;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [&](EventData*) {
+        if (probeId == INVALID_SUBSCRIPTION_ID) {
+            probeId = bus.subscribe(BridgeEvent::BOAT_DETECTED, [&probe](EventData*) { probe++; });
+        }
+    });
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.processEvents();
+    EXPECT_NE(probeId, INVALID_SUBSCRIPTION_ID);
+    EXPECT_EQ(probe, 0);  // Added during dispatch, not called for that event
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.processEvents();
+    EXPECT_EQ(probe, 1);
+
+    // The freed slot is reused, but the old token must not remove the new subscription
+    EXPECT_TRUE(bus.unsubscribe(probeId));
+    SubscriptionId reused = bus.subscribe(BridgeEvent::BOAT_DETECTED, [&probe](EventData*) { probe += 10; });
+    EXPECT_NE(reused, probeId);
+    EXPECT_FALSE(bus.unsubscribe(probeId));
+    EXPECT_FALSE(bus.unsubscribe(INVALID_SUBSCRIPTION_ID));
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.processEvents();
+    EXPECT_EQ(probe, 11);
+}
+
+// Test: many transient subscribers removed out of order; only the survivors are called
+TEST(EventBusUnsubscribeTest, ManyTransientSubscribers) {
+    EventBus bus;
+    constexpr int COUNT = 500;
+    int calls = 0;
+    std::vector<SubscriptionId> ids;
+    for (int i = 0; i < COUNT; ++i) {
+        ids.push_back(bus.subscribe(BridgeEvent::STATE_CHANGED, [&calls](EventData*) { calls++; }));
+    }
+    // Remove every other one, from the back, as per-client probes going away would
+    for (int i = COUNT - 1; i >= 0; i -= 2) {
+        EXPECT_TRUE(bus.unsubscribe(ids[i]));
+    }
+    bus.emplace<StateChangeData>(BridgeState::OPEN, BridgeState::OPENING);
+    bus.processEvents();
+    EXPECT_EQ(calls, COUNT / 2);
+}
+
+// Test: a mask subscriber gets exactly the events in its mask, told which one fired
+TEST(EventBusMaskTest, MaskSubscriberReceivesOnlyMaskedEvents) {
+    using E = BridgeEvent;
+    EventBus bus;
+    std::vector<BridgeEvent> seen;
+    SubscriptionId id = bus.subscribe(EventMask{E::BOAT_PASSED, E::STATE_CHANGED},
+                                      [&seen](BridgeEvent ev, EventData*) { seen.push_back(ev); });
+    EXPECT_TRUE(bus.hasSubscriptions(E::STATE_CHANGED));
+    EXPECT_FALSE(bus.hasSubscriptions(E::BOAT_DETECTED));
+
+    bus.emplace<SimpleEventData>(E::BOAT_DETECTED);
+    bus.emplace<SimpleEventData>(E::BOAT_PASSED);
+    bus.publish(E::STATE_CHANGED, nullptr);  // Payload-free events still carry their type
+    bus.processEvents();
+
+    std::vector<BridgeEvent> expected = {E::BOAT_PASSED, E::STATE_CHANGED};
+    EXPECT_EQ(seen, expected);
+
+    EXPECT_TRUE(bus.unsubscribe(id));
+    bus.emplace<SimpleEventData>(E::BOAT_PASSED);
+    bus.processEvents();
+    EXPECT_EQ(seen.size(), 2u);
+    EXPECT_FALSE(bus.hasSubscriptions(E::STATE_CHANGED));
+}
+
+// Test: EMERGENCY before NORMAL across per-event and mask subscribers; per-event first within a priority
+TEST(EventBusMaskTest, MaskAndPerEventSubscribersKeepPriorityOrder) {
+    using E = BridgeEvent;
+    EventBus bus;
+    std::vector<int> order;
+    bus.subscribe(EventMask::all(), [&order](BridgeEvent, EventData*) { order.push_back(1); });
+    bus.subscribe(E::FAULT_DETECTED, [&order](EventData*) { order.push_back(2); });
+    bus.subscribe(EventMask{E::FAULT_DETECTED}, [&order](BridgeEvent, EventData*) { order.push_back(3); },
+                  EventPriority::EMERGENCY);
+    bus.subscribe(E::FAULT_DETECTED, [&order](EventData*) { order.push_back(4); }, EventPriority::EMERGENCY);
+    bus.subscribe(EventMask::all().without(E::FAULT_DETECTED), [&order](BridgeEvent, EventData*) { order.push_back(5); });
+    bus.seal();
+
+    bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(E::FAULT_DETECTED);
+    bus.processEvents();
+
+    std::vector<int> expected = {4, 3, 2, 1};
+    EXPECT_EQ(order, expected);
+    EXPECT_TRUE(EventMask::all().contains(E::STATE_CHANGED));  // Last enumerator is covered
+}
+
+// Test: one mask subscription stands in for 26 per-event ones - one table entry, same calls
+// (setup and dispatch cost: BM_BroadcasterSubscribe / BM_BroadcasterDispatch in bench/)
+TEST(EventBusMaskTest, MaskReplacesPerEventSubscriptions) {
+    using E = BridgeEvent;
+    constexpr int ROUNDS = 20;
+    const E events[] = {
+        E::BOAT_DETECTED, E::BOAT_DETECTED_LEFT, E::BOAT_DETECTED_RIGHT, E::BOAT_PASSED,
+        E::BOAT_PASSED_LEFT, E::BOAT_PASSED_RIGHT, E::FAULT_DETECTED, E::FAULT_CLEARED,
+        E::MANUAL_OVERRIDE_ACTIVATED, E::MANUAL_OVERRIDE_DEACTIVATED, E::TRAFFIC_STOPPED_SUCCESS,
+        E::BRIDGE_OPENED_SUCCESS, E::BRIDGE_CLOSED_SUCCESS, E::TRAFFIC_RESUMED_SUCCESS,
+        E::INDICATOR_UPDATE_SUCCESS, E::SYSTEM_SAFE_SUCCESS, E::CAR_LIGHT_CHANGED_SUCCESS,
+        E::BOAT_LIGHT_CHANGED_SUCCESS, E::MANUAL_BRIDGE_OPEN_REQUESTED, E::MANUAL_BRIDGE_CLOSE_REQUESTED,
+        E::MANUAL_TRAFFIC_STOP_REQUESTED, E::MANUAL_TRAFFIC_RESUME_REQUESTED, E::STATE_CHANGED,
+        E::SIMULATION_ENABLED, E::SIMULATION_DISABLED, E::SIMULATION_SENSOR_CONFIG_CHANGED
+    };
+
+    auto run = [&](bool useMask, size_t& entries) {
+        EventBus bus;
+        std::vector<BridgeEvent> seen;
+        if (useMask) {
+            EventMask mask;
+            for (E ev : events) mask = mask.with(ev);
+            bus.subscribe(mask, [&seen](BridgeEvent ev, EventData*) { seen.push_back(ev); });
+        } else {
+            for (E ev : events) bus.subscribe(ev, [&seen](EventData* d) { seen.push_back(d->getEventEnum()); });
+        }
+        bus.seal();
+        entries = bus.subscriptionCount();
+        for (int r = 0; r < ROUNDS; ++r) {
+            for (E ev : events) bus.emplace<SimpleEventData>(ev);
+            bus.emplace<SimpleEventData>(E::BEAM_BREAK_ACTIVE);  // Not subscribed
+            bus.processEvents();
+        }
+        return seen;
+    };
+
+    size_t perEventEntries = 0;
+    size_t maskEntries = 0;
+    const std::vector<BridgeEvent> perEvent = run(false, perEventEntries);
+    const std::vector<BridgeEvent> masked = run(true, maskEntries);
+    EXPECT_EQ(perEventEntries, 26u);
+    EXPECT_EQ(maskEntries, 1u);
+    EXPECT_EQ(perEvent.size(), static_cast<size_t>(ROUNDS) * 26);
+    EXPECT_EQ(masked, perEvent);
+}
+
+// Test: a publish from another thread wakes waitForWork() long before its timeout
+TEST(EventBusWakeTest, RemotePublishWakesWaiter) {
+    EventBus bus;
+    int boats = 0;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [&boats](EventData*) { boats++; });
+    bus.seal();
+
+    std::thread publisher([&bus]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        bus.emplaceRemote<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    });
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool notified = bus.waitForWork(5000);
+    const auto waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    publisher.join();
+
+    EXPECT_TRUE(notified);
+    EXPECT_LT(waitedMs, 2000);
+    EXPECT_EQ(bus.processEvents(), 1u);
+    EXPECT_EQ(boats, 1);
+
+    const EventLoopStats stats = bus.getLoopStats();
+    EXPECT_EQ(stats.waits, 1u);
+    EXPECT_EQ(stats.notifiedWakeups, 1u);
+    EXPECT_EQ(stats.wakeLatencySamples, 1u);
+    EXPECT_GE(stats.wakeLatencyMaxUs, stats.wakeLatencyAvgUs);
+}
+
+// Test: with nothing published, the wait ends at the caller's deadline or the next timer
+TEST(EventBusWakeTest, SleepsUntilNearestDeadline) {
+    EventBus bus;
+    const auto elapsedMs = [](std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(bus.waitForWork(30));
+    EXPECT_GE(elapsedMs(t0), 25);
+
+    // Arming a timer wakes a sleeper so it can shorten its wait
+    bus.callAfter(10, []() {});
+    EXPECT_TRUE(bus.waitForWork(5000));
+    t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(bus.waitForWork(5000));
+    EXPECT_LT(elapsedMs(t0), 2000);
+
+    // Queued events mean there is no sleeping at all
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    t0 = std::chrono::steady_clock::now();
+    bus.waitForWork(5000);
+    bus.waitForWork(5000);  // Latched wake already consumed; still returns because the event is pending
+    EXPECT_LT(elapsedMs(t0), 2000);
+
+    const EventLoopStats stats = bus.getLoopStats();
+    EXPECT_EQ(stats.waits, 5u);
+    EXPECT_EQ(stats.timeoutWakeups, 2u);
+    EXPECT_GT(stats.idlePercent, 0.0f);
+}
+
+// Test: log2 buckets and percentile edges of the latency histogram
+TEST(EventBusMetricsTest, HistogramBucketsAndPercentiles) {
+    EXPECT_EQ(LatencyHistogram::bucketFor(0), 0u);
+    EXPECT_EQ(LatencyHistogram::bucketFor(1), 1u);
+    EXPECT_EQ(LatencyHistogram::bucketFor(3), 2u);
+    EXPECT_EQ(LatencyHistogram::bucketFor(1024), 11u);
+    EXPECT_EQ(LatencyHistogram::bucketFor(UINT32_MAX), LatencyHistogram::BUCKETS - 1);
+
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(50), 0u);
+    for (int i = 0; i < 98; ++i) {
+        histogram.record(10);   // Bucket [8, 16)
+    }
+    histogram.record(900);      // Bucket [512, 1024)
+    histogram.record(5000000);  // Open-ended top bucket
+
+    const LatencyHistogram::Summary s = histogram.summary();
+    EXPECT_EQ(s.count, 100u);
+    EXPECT_EQ(s.p50Us, 15u);
+    EXPECT_EQ(s.p90Us, 15u);
+    EXPECT_EQ(s.p99Us, 1023u);
+    EXPECT_EQ(s.maxUs, 5000000u);
+    EXPECT_EQ(histogram.percentile(100), 5000000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+// Test: queue wait and dispatch time are recorded per event type, even with no subscribers
+TEST(EventBusMetricsTest, RecordsQueueWaitAndDispatchPerEvent) {
+    EventBus bus;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED, [](EventData*) {});
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.emplace<SimpleEventData>(BridgeEvent::FAULT_CLEARED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(bus.processEvents(), 3u);
+
+    const LatencyHistogram::Summary wait = bus.queueWaitHistogram(BridgeEvent::BOAT_DETECTED).summary();
+    EXPECT_EQ(wait.count, 2u);
+    EXPECT_GE(wait.maxUs, 4000u);
+    EXPECT_EQ(bus.dispatchHistogram(BridgeEvent::BOAT_DETECTED).count(), 2u);
+    EXPECT_EQ(bus.queueWaitHistogram(BridgeEvent::FAULT_CLEARED).count(), 1u);
+    EXPECT_EQ(bus.queueWaitHistogram(BridgeEvent::BOAT_PASSED).count(), 0u);
+
+    bus.resetMetrics();
+    EXPECT_EQ(bus.queueWaitHistogram(BridgeEvent::BOAT_DETECTED).count(), 0u);
+    EXPECT_EQ(bus.dispatchHistogram(BridgeEvent::BOAT_DETECTED).count(), 0u);
+}
+
+// Test: per-subscriber timing names the slow callback, including mask subscribers
+TEST(EventBusMetricsTest, SlowSubscriberIsIdentifiedByLabel) {
+    EventBus bus;
+    {
+        EventBus::SubscriberLabel label(bus, "Fast");
+        bus.subscribe(BridgeEvent::BOAT_DETECTED, [](EventData*) {});
+        bus.subscribe(EventMask{BridgeEvent::BOAT_DETECTED, BridgeEvent::BOAT_PASSED},
+                      [](BridgeEvent, EventData*) {});
+    }
+    SubscriptionId slowId;
+    {
+        EventBus::SubscriberLabel label(bus, "Slow");
+        slowId = bus.subscribe(BridgeEvent::BOAT_DETECTED, [](EventData*) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        });
+    }
+    bus.subscribe(BridgeEvent::BOAT_PASSED, [](EventData*) {});  // Outside any label scope
+    bus.seal();
+
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_DETECTED);
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    bus.processEvents();
+
+    SubscriberTiming timings[8];
+    const size_t count = bus.getSubscriberTimings(timings, 8);
+    ASSERT_EQ(count, 4u);
+    EXPECT_EQ(bus.subscriptionCount(), 4u);
+
+    const SubscriberTiming* slowest = &timings[0];
+    size_t masks = 0;
+    size_t unlabelled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(timings[i].calls, timings[i].mask ? 2u : 1u);
+        masks += timings[i].mask ? 1 : 0;
+        unlabelled += timings[i].label ? 0 : 1;
+        if (timings[i].maxUs > slowest->maxUs) {
+            slowest = &timings[i];
+        }
+    }
+    EXPECT_EQ(masks, 1u);
+    EXPECT_EQ(unlabelled, 1u);
+    EXPECT_EQ(slowest->id, slowId);
+    EXPECT_STREQ(slowest->label, "Slow");
+    EXPECT_EQ(slowest->event, BridgeEvent::BOAT_DETECTED);
+    EXPECT_GE(slowest->maxUs, 2500u);
+    EXPECT_GE(bus.dispatchHistogram(BridgeEvent::BOAT_DETECTED).summary().maxUs, slowest->maxUs);
+
+    // Capacity is respected
+    EXPECT_EQ(bus.getSubscriberTimings(timings, 2), 2u);
+}
@@ -0,0 +1,111 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "EventBus.h"
+
+// Count every global heap allocation made by this test binary
+static std::atomic<size_t> g_heapAllocations{0};
+
+void* operator new(size_t size) {
+    g_heapAllocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// One control tick's worth of typical traffic: sensor, FSM, signal and safety payloads
+void publishTick(EventBus& bus) {
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
+    bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::BEAM_BREAK_ACTIVE);
+    bus.emplace<StateChangeData>(BridgeState::STOPPING_TRAFFIC, BridgeState::IDLE);
+    bus.emplace<LightChangeData>("both", "Yellow", true);
+    bus.emplace<SimulationSensorConfigData>(true, false, true);
+}
+
+} // namespace
+
+// Test: emplace<T> publishes under the payload's own event type and priority
+TEST(EventPoolTest, EmplacePublishesTypedPayload) {
+    EventBus bus;
+    BridgeEvent seenType = BridgeEvent::FAULT_DETECTED;
+    BoatEventSide seenSide = BoatEventSide::UNKNOWN;
+    bus.subscribe(BridgeEvent::BOAT_DETECTED_RIGHT, [&](EventData* d) {
+        seenType = d->getEventEnum();
+        seenSide = d->getBoatEventSide();
+    });
+
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT);
+    bus.processEvents();
+
+    EXPECT_EQ(seenType, BridgeEvent::BOAT_DETECTED_RIGHT);
+    EXPECT_EQ(seenSide, BoatEventSide::RIGHT);
+}
+
+// Test: once subscribers are wired and the bus is sealed, publish + dispatch never calls malloc
+TEST(EventPoolTest, SteadyStateDispatchMakesNoHeapAllocations) {
+    EventBus bus;
+    int dispatched = 0;
+    auto count = [&dispatched](EventData*) { dispatched++; };
+    bus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, count);
+    bus.subscribe(BridgeEvent::BEAM_BREAK_ACTIVE, count, EventPriority::EMERGENCY);
+    bus.subscribe(BridgeEvent::STATE_CHANGED, count);
+    bus.subscribe(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, count);
+    bus.subscribe(BridgeEvent::SIMULATION_SENSOR_CONFIG_CHANGED, count);
+    bus.seal();
+
+    // Warm-up tick so lazily-created statics (pool, logger) exist before counting
+    publishTick(bus);
+    bus.processEvents();
+
+    const EventPoolStats before = bus.getPoolStats();
+    const size_t heapBefore = g_heapAllocations.load();
+    for (int tick = 0; tick < 1000; ++tick) {
+        publishTick(bus);
+        bus.processEvents();
+    }
+    const size_t heapAfter = g_heapAllocations.load();
+    const EventPoolStats after = bus.getPoolStats();
+
+    EXPECT_EQ(dispatched, 5 * 1001);
+    EXPECT_EQ(heapAfter - heapBefore, 0u);
+    EXPECT_EQ(after.exhausted, before.exhausted);
+    EXPECT_EQ(after.oversize, before.oversize);
+    EXPECT_EQ(after.smallInUse, before.smallInUse);
+    EXPECT_EQ(after.largeInUse, before.largeInUse);
+}
+
+// Test: when both pools are full the payload falls back to the heap and is counted
+TEST(EventPoolTest, ExhaustionFallsBackToHeapAndCounts) {
+    const size_t total = EventPool::SMALL_BLOCK_COUNT + EventPool::LARGE_BLOCK_COUNT;
+    EventBus bus(4, total + 8);
+
+    const EventPoolStats before = bus.getPoolStats();
+    const size_t freeBlocks = total - before.smallInUse - before.largeInUse;
+    for (size_t i = 0; i < freeBlocks + 3; ++i) {
+        // Pointer API - emplace() of a built-in payload never touches the pool
+        bus.publish(BridgeEvent::BOAT_PASSED, new SimpleEventData(BridgeEvent::BOAT_PASSED));
+    }
+
+    EventPoolStats stats = bus.getPoolStats();
+    EXPECT_EQ(stats.exhausted - before.exhausted, 3u);
+    EXPECT_EQ(stats.smallInUse, stats.smallCapacity);
+    EXPECT_EQ(stats.largeInUse, stats.largeCapacity);  // Small payloads spill into large blocks first
+
+    // Pooled and heap-backed payloads are both released correctly after dispatch
+    bus.processEvents();
+    stats = bus.getPoolStats();
+    EXPECT_EQ(stats.smallInUse, before.smallInUse);
+    EXPECT_EQ(stats.largeInUse, before.largeInUse);
+    EXPECT_EQ(stats.smallHighWater, stats.smallCapacity);
+}
@@ -0,0 +1,52 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include "BridgeStateMachine.h"
+#include "CommandBus.h"
+#include "EventBus.h"
+
+// Test: publish(FAULT_DETECTED) -> FSM issues ENTER_SAFE_STATE before the UI subscribers
+// registered ahead of it run (the latency itself is BM_FaultToSafeState in bench/)
+TEST(FaultLatencyTest, FsmReactsBeforeUiSubscribers) {
+    EventBus bus;
+    CommandBus commandBus;
+    BridgeStateMachine fsm(bus, commandBus);
+
+    // UI/logging subscribers are wired before the FSM, as in setup()
+    int uiCalls = 0;
+    bool uiRanBeforeFsm = false;
+    bool safeStateIssued = false;
+    for (int i = 0; i < 2; ++i) {
+        bus.subscribe(BridgeEvent::FAULT_DETECTED, [&](EventData*) {
+            if (!safeStateIssued) uiRanBeforeFsm = true;
+            uiCalls++;
+        });
+    }
+    commandBus.subscribe(CommandTarget::CONTROLLER, [&safeStateIssued](const Command& cmd) {
+        if (cmd.action == CommandAction::ENTER_SAFE_STATE) {
+            safeStateIssued = true;
+        }
+    });
+    fsm.begin();
+    bus.seal();
+    commandBus.seal();
+
+    constexpr int RUNS = 100;
+    for (int run = 0; run < RUNS; ++run) {
+        safeStateIssued = false;
+        bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+        bus.processEvents();
+        ASSERT_EQ(fsm.getCurrentState(), BridgeState::FAULT);
+        ASSERT_TRUE(safeStateIssued);
+
+        // Back to IDLE for the next run
+        bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_CLEARED);
+        bus.processEvents();
+        ASSERT_EQ(fsm.getCurrentState(), BridgeState::IDLE);
+    }
+
+    EXPECT_FALSE(uiRanBeforeFsm);
+    EXPECT_EQ(uiCalls, 2 * RUNS);
+}
@@ -0,0 +1,159 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "EventBus.h"
+#include "MpscQueue.h"
+
+namespace {
+
+struct Item {
+    uint32_t producer = 0;
+    uint32_t seq = 0;
+};
+
+constexpr int PRODUCERS = 4;
+
+} // namespace
+
+// Test: single-threaded FIFO order and full/empty behaviour
+TEST(MpscQueueTest, FifoAndBounded) {
+    MpscQueue<Item, 4> queue;
+    Item out;
+    EXPECT_FALSE(queue.tryPop(out));
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(Item{0, i}));
+    }
+    EXPECT_FALSE(queue.tryPush(Item{0, 99}));  // Full
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(out));
+        EXPECT_EQ(out.seq, i);
+    }
+    EXPECT_FALSE(queue.tryPop(out));
+
+    // Wraps around after a full lap
+    EXPECT_TRUE(queue.tryPush(Item{0, 7}));
+    ASSERT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out.seq, 7u);
+}
+
+// Stress: std::thread producers vs one consumer; nothing lost, per-producer order kept
+TEST(MpscQueueTest, ConcurrentProducersLoseNothing) {
+    constexpr uint32_t PER_PRODUCER = 200000;
+    MpscQueue<Item, 1024> queue;
+    std::atomic<bool> start{false};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, &start, p]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.tryPush(Item{static_cast<uint32_t>(p), i})) {
+                    std::this_thread::yield();  // Full - the consumer will catch up
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> nextSeq(PRODUCERS, 0);
+    uint64_t received = 0;
+    bool ordered = true;
+    const uint64_t total = static_cast<uint64_t>(PRODUCERS) * PER_PRODUCER;
+
+    start.store(true);
+    Item item;
+    while (received < total) {
+        if (!queue.tryPop(item)) {
+            std::this_thread::yield();  // Let producers run on single-core hosts
+            continue;
+        }
+        ordered = ordered && (item.seq == nextSeq[item.producer]);
+        nextSeq[item.producer] = item.seq + 1;
+        received++;
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received, total);
+    for (int p = 0; p < PRODUCERS; ++p) {
+        EXPECT_EQ(nextSeq[p], PER_PRODUCER);
+    }
+    Item leftover;
+    EXPECT_FALSE(queue.tryPop(leftover));
+}
+
+// Stress: producer threads use emplaceRemote() while the consumer thread runs processEvents()
+TEST(EventBusRemoteTest, CrossThreadPublishesAreAllDispatched) {
+    constexpr int PER_PRODUCER = 50000;
+    const BridgeEvent producerEvents[PRODUCERS] = {
+        BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED, BridgeEvent::MANUAL_BRIDGE_CLOSE_REQUESTED,
+        BridgeEvent::BOAT_DETECTED_LEFT, BridgeEvent::SYSTEM_RESET_REQUESTED
+    };
+
+    EventBus bus;
+    int counts[PRODUCERS] = {0, 0, 0, 0};
+    for (int p = 0; p < PRODUCERS; ++p) {
+        int* counter = &counts[p];
+        bus.subscribe(producerEvents[p], [counter](EventData*) { (*counter)++; });
+    }
+    bus.seal();
+
+    std::atomic<bool> start{false};
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                // Retry when the hand-off queue is full so the test can check nothing is lost
+                while (!(p == 3 ? bus.emplaceRemote<SimpleEventData, EventPriority::EMERGENCY>(producerEvents[p])
+                                : bus.emplaceRemote<SimpleEventData>(producerEvents[p]))) {
+                    std::this_thread::yield();
+                }
+            }
+            finished++;
+        });
+    }
+
+    start.store(true);
+    int dispatched = 0;
+    do {
+        bus.processEvents();
+        dispatched = counts[0] + counts[1] + counts[2] + counts[3];
+        std::this_thread::yield();
+    } while (finished.load() < PRODUCERS || dispatched < PRODUCERS * PER_PRODUCER);
+    for (auto& t : producers) t.join();
+
+    for (int p = 0; p < PRODUCERS; ++p) {
+        EXPECT_EQ(counts[p], PER_PRODUCER);
+    }
+    EventQueueStats stats = bus.getQueueStats();
+    EXPECT_EQ(stats.normalDropped, 0u);
+    EXPECT_EQ(stats.emergencyDropped, 0u);
+}
+
+// Test: a full hand-off queue rejects the publish and counts it
+TEST(EventBusRemoteTest, FullHandOffQueueCountsDrops) {
+    EventBus bus;
+    int dispatched = 0;
+    bus.subscribe(BridgeEvent::BOAT_PASSED, [&dispatched](EventData*) { dispatched++; });
+
+    const size_t capacity = EventBus::REMOTE_QUEUE_CAPACITY;
+    for (size_t i = 0; i < capacity + 5; ++i) {
+        bus.emplaceRemote<BoatEventData>(BridgeEvent::BOAT_PASSED, BoatEventSide::LEFT);
+    }
+    EXPECT_EQ(bus.getQueueStats().remoteDropped, 5u);
+
+    bus.processEvents();
+    EXPECT_EQ(dispatched, static_cast<int>(capacity));
+}
@@ -0,0 +1,129 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "SeqLock.h"
+#include "UiState.h"
+
+namespace {
+
+// Every field carries the same stamp, so a torn copy shows as a mismatch
+struct Stamped {
+    uint32_t a;
+    uint32_t b[13];
+    uint16_t c;
+    uint8_t d;
+    uint32_t e;
+
+    static Stamped make(uint32_t stamp) {
+        Stamped s;
+        s.a = stamp;
+        for (uint32_t& v : s.b) v = stamp;
+        s.c = static_cast<uint16_t>(stamp);
+        s.d = static_cast<uint8_t>(stamp);
+        s.e = stamp;
+        return s;
+    }
+
+    bool consistent() const {
+        for (uint32_t v : b) {
+            if (v != a) return false;
+        }
+        return c == static_cast<uint16_t>(a) && d == static_cast<uint8_t>(a) && e == a;
+    }
+};
+
+}  // namespace
+
+// Test: the constructor publishes the initial value
+TEST(SeqLockTest, LoadsInitialValue) {
+    SeqLock<Stamped> lock(Stamped::make(7));
+    const Stamped s = lock.load();
+    EXPECT_EQ(s.a, 7u);
+    EXPECT_TRUE(s.consistent());
+    EXPECT_EQ(lock.stores(), 1u);
+}
+
+// Test: a load after a store sees the whole new value
+TEST(SeqLockTest, LoadSeesLatestStore) {
+    SeqLock<Stamped> lock(Stamped::make(0));
+    lock.store(Stamped::make(1));
+    lock.store(Stamped::make(2));
+
+    Stamped s = Stamped::make(99);
+    ASSERT_TRUE(lock.tryLoad(s));
+    EXPECT_EQ(s.a, 2u);
+    EXPECT_TRUE(s.consistent());
+    EXPECT_EQ(lock.stores(), 3u);
+}
+
+// Test: UiState round-trips, enums and flag bits included
+TEST(SeqLockTest, PublishesUiState) {
+    SeqLock<UiState> lock;
+    UiState state;
+    state.version = 12;
+    state.sectionVersion[2] = 11;
+    state.bridgeState = BridgeState::STOPPING_TRAFFIC;
+    state.boatLeft = LightColour::GREEN;
+    state.boatTimerSide = LightSide::LEFT;
+    state.bridgeLockEngaged = false;
+    state.simBeamBreakEnabled = true;
+    lock.store(state);
+
+    const UiState copy = lock.load();
+    EXPECT_EQ(copy.version, 12u);
+    EXPECT_EQ(copy.sectionVersion[2], 11u);
+    EXPECT_EQ(copy.bridgeState, BridgeState::STOPPING_TRAFFIC);
+    EXPECT_EQ(copy.boatLeft, LightColour::GREEN);
+    EXPECT_EQ(copy.boatRight, LightColour::RED);
+    EXPECT_EQ(copy.boatTimerSide, LightSide::LEFT);
+    EXPECT_FALSE(copy.bridgeLockEngaged);
+    EXPECT_TRUE(copy.simBeamBreakEnabled);
+    EXPECT_FALSE(copy.manualMode);
+}
+
+// Test: the serialized names are the ones the UI expects
+TEST(SeqLockTest, UiStateNames) {
+    EXPECT_STREQ(toString(LightColour::YELLOW), "Yellow");
+    EXPECT_STREQ(toString(LightSide::NONE), "");
+    EXPECT_STREQ(toString(LightSide::RIGHT), "right");
+    EXPECT_STREQ(toString(BridgeState::IDLE), "IDLE");
+    EXPECT_STREQ(toString(BridgeState::MANUAL_CLOSED), "MANUAL_CLOSED");
+    static_assert(sizeof(UiState) <= 48, "UiState is copied on every read - keep it small");
+}
+
+// Test: readers racing a writer only ever see whole values, in order
+TEST(SeqLockTest, ConcurrentReadersNeverSeeTornValues) {
+    SeqLock<Stamped> lock(Stamped::make(0));
+    constexpr uint32_t STORES = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn{0};
+    std::atomic<uint32_t> backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            uint32_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const Stamped s = lock.load();
+                if (!s.consistent()) torn.fetch_add(1, std::memory_order_relaxed);
+                if (s.a < last) backwards.fetch_add(1, std::memory_order_relaxed);
+                last = s.a;
+            }
+        });
+    }
+
+    for (uint32_t i = 1; i <= STORES; ++i) {
+        lock.store(Stamped::make(i));
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& t : readers) t.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(backwards.load(), 0u);
+    EXPECT_EQ(lock.load().a, STORES);
+}
@@ -0,0 +1,113 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "SnapshotCoalescer.h"
+
+// Test: nothing marked, nothing to send
+TEST(SnapshotCoalescerTest, CleanStateIsNeverDue) {
+    SnapshotCoalescer snapshots(50);
+    EXPECT_EQ(snapshots.msUntilDue(1000), SnapshotCoalescer::NOT_DIRTY);
+    EXPECT_FALSE(snapshots.takeDue(1000));
+    EXPECT_EQ(snapshots.stats().sent, 0u);
+}
+
+// Test: the first change after a quiet period goes out at once
+TEST(SnapshotCoalescerTest, FirstChangeIsSentImmediately) {
+    SnapshotCoalescer snapshots(50);
+    snapshots.markDirty();
+    EXPECT_EQ(snapshots.msUntilDue(1000), 0u);
+    EXPECT_TRUE(snapshots.takeDue(1000));
+    EXPECT_FALSE(snapshots.takeDue(1000));  // Already covered
+}
+
+// Test: a burst (STATE_CHANGED + two BOAT_LIGHT_CHANGED) costs one snapshot
+TEST(SnapshotCoalescerTest, BurstCoalescesIntoOneSnapshot) {
+    SnapshotCoalescer snapshots(50);
+    snapshots.markDirty();
+    snapshots.markDirty();
+    snapshots.markDirty();
+
+    EXPECT_TRUE(snapshots.takeDue(1000));
+    EXPECT_FALSE(snapshots.takeDue(1000));
+
+    const SnapshotCoalescer::Stats stats = snapshots.stats();
+    EXPECT_EQ(stats.marked, 3u);
+    EXPECT_EQ(stats.sent, 1u);
+    EXPECT_EQ(stats.suppressed, 2u);
+}
+
+// Test: changes inside the interval are held until it has passed, then sent together
+TEST(SnapshotCoalescerTest, ChangesWithinIntervalAreHeld) {
+    SnapshotCoalescer snapshots(50);
+    snapshots.markDirty();
+    ASSERT_TRUE(snapshots.takeDue(1000));
+
+    snapshots.markDirty();
+    EXPECT_EQ(snapshots.msUntilDue(1010), 40u);
+    EXPECT_FALSE(snapshots.takeDue(1010));
+    snapshots.markDirty();
+    EXPECT_FALSE(snapshots.takeDue(1049));
+
+    EXPECT_EQ(snapshots.msUntilDue(1050), 0u);
+    EXPECT_TRUE(snapshots.takeDue(1050));
+
+    const SnapshotCoalescer::Stats stats = snapshots.stats();
+    EXPECT_EQ(stats.marked, 3u);
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.suppressed, 1u);
+}
+
+// Test: the interval survives millis() wrapping
+TEST(SnapshotCoalescerTest, IntervalAcrossMillisWrap) {
+    SnapshotCoalescer snapshots(50);
+    snapshots.markDirty();
+    ASSERT_TRUE(snapshots.takeDue(UINT32_MAX - 10));
+
+    snapshots.markDirty();
+    EXPECT_FALSE(snapshots.takeDue(UINT32_MAX));
+    EXPECT_EQ(snapshots.msUntilDue(5), 34u);
+    EXPECT_TRUE(snapshots.takeDue(40));
+}
+
+// Test: interval 0 still coalesces, but never holds
+TEST(SnapshotCoalescerTest, ZeroIntervalDisablesRateLimit) {
+    SnapshotCoalescer snapshots(0);
+    snapshots.markDirty();
+    EXPECT_TRUE(snapshots.takeDue(1000));
+    snapshots.markDirty();
+    EXPECT_TRUE(snapshots.takeDue(1000));
+    EXPECT_EQ(snapshots.stats().suppressed, 0u);
+}
+
+// Test: a mark from another task wakes the sleeping consumer
+TEST(SnapshotCoalescerTest, MarkWakesWaiter) {
+    SnapshotCoalescer snapshots(50);
+    std::thread producer([&snapshots]() { snapshots.markDirty(); });
+    EXPECT_TRUE(snapshots.wait(5000));
+    producer.join();
+    EXPECT_TRUE(snapshots.takeDue(0));
+}
+
+// Test: every mark from concurrent producers is accounted for as sent or suppressed
+TEST(SnapshotCoalescerTest, ConcurrentMarksAreAllAccounted) {
+    SnapshotCoalescer snapshots(0);
+    constexpr uint32_t PER_PRODUCER = 20000;
+    std::thread a([&snapshots]() { for (uint32_t i = 0; i < PER_PRODUCER; ++i) snapshots.markDirty(); });
+    std::thread b([&snapshots]() { for (uint32_t i = 0; i < PER_PRODUCER; ++i) snapshots.markDirty(); });
+
+    uint32_t now = 0;
+    while (snapshots.stats().marked < 2 * PER_PRODUCER) {
+        snapshots.takeDue(now++);
+    }
+    a.join();
+    b.join();
+    snapshots.takeDue(now);
+
+    const SnapshotCoalescer::Stats stats = snapshots.stats();
+    EXPECT_EQ(stats.marked, 2 * PER_PRODUCER);
+    EXPECT_EQ(stats.sent + stats.suppressed, stats.marked);
+    EXPECT_EQ(snapshots.msUntilDue(now), SnapshotCoalescer::NOT_DIRTY);
+}
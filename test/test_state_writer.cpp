@@ -0,0 +1,563 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BridgeSystemDefs.h"
+#include "ConsoleCommands.h"
+#include "DetectionSystem.h"
+#include "EventBus.h"
+#include "Logger.h"
+#include "MotorControl.h"
+#include "SignalControl.h"
+#include "StateWriter.h"
+#include "UiState.h"
+
+namespace {
+
+// StateWriter wired as in setup(): subscribed on a sealed bus, events applied on dispatch
+struct StateFixture {
+    EventBus bus;
+    StateWriter state;
+
+    explicit StateFixture(size_t logCapacity = ActivityLog::DEFAULT_CAPACITY) : state(bus, logCapacity) {
+        Logger::setLevel(Logger::Level::WARN);
+        state.beginSubscriptions();
+        bus.seal();
+    }
+
+    void event(BridgeEvent ev) {
+        bus.emplace<SimpleEventData>(ev);
+        bus.processEvents();
+    }
+    void carLight(const char* side, const char* colour) {
+        bus.emplace<LightChangeData>(String(side), String(colour), true);
+        bus.processEvents();
+    }
+    void boatLight(const char* side, const char* colour) {
+        bus.emplace<LightChangeData>(String(side), String(colour), false);
+        bus.processEvents();
+    }
+    void stateChange(BridgeState from, BridgeState to) {
+        bus.emplace<StateChangeData>(to, from);
+        bus.processEvents();
+    }
+};
+
+// Cache hits and misses since the last call
+struct CacheDelta {
+    const StateWriter& state;
+    StateWriter::CacheStats last = state.cacheStats();
+
+    StateWriter::CacheStats take() {
+        const StateWriter::CacheStats now = state.cacheStats();
+        const StateWriter::CacheStats delta{now.hits - last.hits, now.misses - last.misses};
+        last = now;
+        return delta;
+    }
+};
+
+// The fields the consistency test cross-checks, as a client mirrors them from a snapshot
+// and then the patches after it
+struct Mirror {
+    std::string bridgeState;
+    uint32_t lastChangeMs = 0;
+    std::string boatLeft, boatRight, boatTimerSide;
+    uint32_t boatTimerStartMs = 0;
+
+    void apply(JsonObject payload) {
+        JsonObject bridge = payload["bridge"].as<JsonObject>();
+        if (!bridge.isNull()) {
+            bridgeState = bridge["state"] | "";
+            lastChangeMs = bridge["lastChangeMs"] | 0u;
+            boatTimerStartMs = bridge["boatTimerStartMs"] | 0u;
+            boatTimerSide = bridge["boatTimerSide"] | "";
+        }
+        JsonObject boat = payload["traffic"]["boat"].as<JsonObject>();
+        if (!boat.isNull()) {
+            boatLeft = boat["left"]["value"] | "";
+            boatRight = boat["right"]["value"] | "";
+        }
+    }
+
+    // What one applied event at a time can produce: the state change stamps its state into
+    // lastChangeMs, a green boat light owns the timer, two red ones have stopped it
+    bool consistent() const {
+        if (lastChangeMs != 0 && bridgeState != toString(static_cast<BridgeState>(lastChangeMs % 10))) return false;
+        if (boatLeft == "Green") return boatTimerSide == "left" && boatTimerStartMs != 0;
+        if (boatRight == "Green") return boatTimerSide == "right" && boatTimerStartMs != 0;
+        return boatTimerSide.empty() && boatTimerStartMs == 0;
+    }
+};
+
+}  // namespace
+
+// Test: a patch holds the sections changed after `from` and nothing else
+TEST(StateWriterPatchTest, HoldsOnlyChangedSections) {
+    StateFixture f;
+    const uint32_t v0 = f.state.version();
+
+    f.carLight("both", "Red");
+    DynamicJsonDocument doc(1024);
+    ASSERT_TRUE(f.state.buildPatch(doc, v0));
+    EXPECT_STREQ(doc["path"].as<const char*>(), "/system/patch");
+    JsonObject p = doc["payload"].as<JsonObject>();
+    EXPECT_STREQ(p["traffic"]["car"]["left"]["value"].as<const char*>(), "Red");
+    EXPECT_STREQ(p["traffic"]["car"]["right"]["value"].as<const char*>(), "Red");
+    EXPECT_TRUE(p["traffic"]["boat"].isNull());
+    EXPECT_TRUE(p["bridge"].isNull());
+    EXPECT_TRUE(p["system"].isNull());
+    ASSERT_EQ(p["log"].size(), 1u);
+    EXPECT_STREQ(p["log"][0]["text"].as<const char*>(), "Car lights set to Red");
+
+    // A boat light moves the boat section and the bridge one (it owns the boat timer)
+    const uint32_t v1 = f.state.version();
+    mock_millis = 1000;  // A timer started at 0 ms reads as stopped
+    f.boatLight("left", "Green");
+    doc.clear();
+    ASSERT_TRUE(f.state.buildPatch(doc, v1));
+    p = doc["payload"].as<JsonObject>();
+    EXPECT_STREQ(p["traffic"]["boat"]["left"]["value"].as<const char*>(), "Green");
+    EXPECT_TRUE(p["traffic"]["car"].isNull());
+    EXPECT_EQ(p["bridge"]["boatTimerStartMs"].as<uint32_t>(), 1000u);
+    EXPECT_STREQ(p["bridge"]["boatTimerSide"].as<const char*>(), "left");
+    EXPECT_TRUE(p["system"].isNull());
+
+    // Nothing since the current version: an empty patch, no sections and no lines
+    doc.clear();
+    ASSERT_TRUE(f.state.buildPatch(doc, f.state.version()));
+    p = doc["payload"].as<JsonObject>();
+    EXPECT_EQ(p["from"].as<uint32_t>(), p["seq"].as<uint32_t>());
+    EXPECT_TRUE(p["bridge"].isNull());
+    EXPECT_TRUE(p["traffic"].isNull());
+    EXPECT_TRUE(p["log"].isNull());
+}
+
+// Test: each patch starts where the previous one ended, and its lines follow on in seq order
+TEST(StateWriterPatchTest, FromAndSeqAreContinuous) {
+    StateFixture f;
+    uint32_t version = f.state.version();
+    uint32_t nextLine = 0;
+
+    auto drain = [&]() {
+        DynamicJsonDocument doc(1024);
+        ASSERT_TRUE(f.state.buildPatch(doc, version));
+        EXPECT_EQ(doc["payload"]["from"].as<uint32_t>(), version);
+        EXPECT_EQ(doc["payload"]["seq"].as<uint32_t>(), f.state.version());
+        JsonArray lines = doc["payload"]["log"].as<JsonArray>();
+        for (size_t i = 0; i < lines.size(); ++i) {
+            EXPECT_EQ(lines[i]["seq"].as<uint32_t>(), nextLine++);
+        }
+        version = doc["payload"]["seq"].as<uint32_t>();
+    };
+
+    f.event(BridgeEvent::BOAT_DETECTED_LEFT);
+    drain();
+    f.stateChange(BridgeState::IDLE, BridgeState::STOPPING_TRAFFIC);
+    f.carLight("both", "Yellow");
+    f.carLight("both", "Red");
+    drain();
+    f.event(BridgeEvent::INDICATOR_UPDATE_SUCCESS);  // Changes nothing, logs nothing
+    drain();
+    f.event(BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
+    drain();
+    EXPECT_EQ(nextLine, 5u);
+}
+
+// Test: a log line pushed after the version a reader loaded belongs to the next patch.
+// The dispatch task pushes a line before it publishes the version it was pushed at, so a
+// patch built in between must hold it back - sent twice, or never, would break the chain.
+TEST(StateWriterPatchTest, LinesPastPublishedVersionWaitForNextPatch) {
+    StateFixture f;
+    constexpr int CYCLES = 3000;
+    std::atomic<bool> done{false};
+
+    std::thread dispatch([&]() {
+        for (int i = 0; i < CYCLES; ++i) {
+            f.event(BridgeEvent::BOAT_DETECTED);
+            f.carLight("both", (i % 2) ? "Green" : "Red");
+            f.stateChange(BridgeState::IDLE, BridgeState::STOPPING_TRAFFIC);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t version = 0;
+    uint32_t nextLine = 0;
+    uint32_t outOfOrder = 0;
+    bool finished = false;
+    while (!finished) {
+        finished = done.load(std::memory_order_acquire);  // One more pass after the last event
+        DynamicJsonDocument doc(4096);
+        if (!f.state.buildPatch(doc, version)) {
+            // Fell behind the log ring: resync from a snapshot, as the broadcast does
+            doc.clear();
+            f.state.buildSnapshot(doc);
+            version = doc["payload"]["seq"].as<uint32_t>();
+            nextLine = doc["payload"]["logNext"].as<uint32_t>();
+            continue;
+        }
+        if (doc["payload"]["from"].as<uint32_t>() != version) outOfOrder++;
+        JsonArray lines = doc["payload"]["log"].as<JsonArray>();
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (lines[i]["seq"].as<uint32_t>() != nextLine) outOfOrder++;
+            nextLine = lines[i]["seq"].as<uint32_t>() + 1;
+        }
+        version = doc["payload"]["seq"].as<uint32_t>();
+    }
+    dispatch.join();
+
+    EXPECT_EQ(outOfOrder, 0u);
+    EXPECT_EQ(version, f.state.version());
+    EXPECT_EQ(nextLine, static_cast<uint32_t>(CYCLES) * 3);  // Every line, each once
+}
+
+// Test: once the log has overwritten lines a patch would need, buildPatch() refuses and
+// a snapshot (with logNext) is what the client gets
+TEST(StateWriterPatchTest, DroppedLinesFallBackToSnapshot) {
+    StateFixture f(4);
+    const uint32_t v0 = f.state.version();
+    f.event(BridgeEvent::BOAT_DETECTED);
+    f.event(BridgeEvent::BOAT_DETECTED_LEFT);
+    const uint32_t v2 = f.state.version();
+    for (int i = 0; i < 4; ++i) f.event(BridgeEvent::BOAT_PASSED);  // Overwrites the first two
+
+    DynamicJsonDocument doc(1024);
+    EXPECT_FALSE(f.state.buildPatch(doc, v0));
+
+    // Everything after v2 is still held
+    doc.clear();
+    ASSERT_TRUE(f.state.buildPatch(doc, v2));
+    JsonArray lines = doc["payload"]["log"].as<JsonArray>();
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0]["seq"].as<uint32_t>(), 2u);
+
+    doc.clear();
+    f.state.buildSnapshot(doc);
+    EXPECT_STREQ(doc["path"].as<const char*>(), "/system/snapshot");
+    EXPECT_EQ(doc["payload"]["seq"].as<uint32_t>(), f.state.version());
+    EXPECT_EQ(doc["payload"]["logNext"].as<uint32_t>(), 6u);
+    EXPECT_FALSE(doc["payload"]["traffic"]["car"].isNull());
+}
+
+// Test: a section is serialized once per version of it; other sections moving leave it cached
+TEST(StateWriterCacheTest, HitsUntilTheSectionVersionMoves) {
+    StateFixture f;
+    CacheDelta cache{f.state};
+
+    const String car = f.state.carTrafficStatusJson();
+    const String boat = f.state.boatTrafficStatusJson();
+    EXPECT_EQ(f.state.carTrafficStatusJson(), car);
+    EXPECT_EQ(f.state.boatTrafficStatusJson(), boat);
+    StateWriter::CacheStats d = cache.take();
+    EXPECT_EQ(d.misses, 2u);
+    EXPECT_EQ(d.hits, 2u);
+
+    // Only the car section moved
+    f.carLight("both", "Red");
+    const String redCar = f.state.carTrafficStatusJson();
+    EXPECT_NE(redCar, car);
+    EXPECT_EQ(f.state.boatTrafficStatusJson(), boat);
+    d = cache.take();
+    EXPECT_EQ(d.misses, 1u);
+    EXPECT_EQ(d.hits, 1u);
+
+    // The snapshot follows the overall version, so any change misses it once
+    const String snapshot = f.state.snapshotPayloadJson();
+    EXPECT_EQ(f.state.snapshotPayloadJson(), snapshot);
+    f.event(BridgeEvent::BOAT_DETECTED);  // Log line only
+    EXPECT_NE(f.state.snapshotPayloadJson(), snapshot);
+    EXPECT_EQ(f.state.carTrafficStatusJson(), redCar);
+    d = cache.take();
+    EXPECT_EQ(d.misses, 2u);
+    EXPECT_EQ(d.hits, 2u);
+}
+
+// Test: the pedestrian countdown is read live from SignalControl, not versioned by an event,
+// so each change of it must miss the bridge entry
+TEST(StateWriterCacheTest, PedestrianCountdownInvalidatesBridge) {
+    EventBus bus;
+    StateWriter state(bus);
+    SignalControl signals(bus);
+    state.attachSignalControl(&signals);
+    state.beginSubscriptions();
+    bus.seal();
+    CacheDelta cache{state};
+
+    mock_millis = 1000;
+    const String idle = state.bridgeStatusJson();
+    EXPECT_EQ(state.bridgeStatusJson(), idle);
+    EXPECT_EQ(cache.take().hits, 1u);
+
+    signals.stopTraffic();
+    DynamicJsonDocument doc(512);
+    ASSERT_FALSE(deserializeJson(doc, state.bridgeStatusJson()));
+    EXPECT_EQ(doc["pedestrianTimerStartMs"].as<uint32_t>(), 1000u);
+    EXPECT_EQ(doc["pedestrianTimerRemainingMs"].as<uint32_t>(), static_cast<uint32_t>(PEDESTRIAN_CROSSING_TIME_MS));
+    StateWriter::CacheStats d = cache.take();
+    EXPECT_EQ(d.misses, 1u);
+    EXPECT_EQ(d.hits, 0u);
+
+    mock_millis = 1500;
+    doc.clear();
+    ASSERT_FALSE(deserializeJson(doc, state.bridgeStatusJson()));
+    EXPECT_EQ(doc["pedestrianTimerRemainingMs"].as<uint32_t>(),
+              static_cast<uint32_t>(PEDESTRIAN_CROSSING_TIME_MS) - 500u);
+    ASSERT_FALSE(deserializeJson(doc, state.snapshotPayloadJson()));
+    EXPECT_EQ(doc["bridge"]["pedestrianTimerRemainingMs"].as<uint32_t>(),
+              static_cast<uint32_t>(PEDESTRIAN_CROSSING_TIME_MS) - 500u);
+    d = cache.take();
+    EXPECT_EQ(d.misses, 2u);
+
+    // Same instant, same countdown: cached again
+    state.bridgeStatusJson();
+    EXPECT_EQ(cache.take().hits, 1u);
+}
+
+// Test: the log level and the console's ultrasonic streaming are shown in the system
+// section without an event, so changing either misses the cached entry
+TEST(StateWriterCacheTest, LogLevelAndStreamingInvalidateSystem) {
+    EventBus bus;
+    StateWriter state(bus);
+    MotorControl motor(bus);
+    DetectionSystem detection(bus);
+    SignalControl signals(bus);
+    ConsoleCommands console(motor, detection, bus, signals);
+    state.attachConsole(&console);
+    state.beginSubscriptions();
+    bus.seal();
+    Logger::setLevel(Logger::Level::WARN);
+    CacheDelta cache{state};
+
+    const String warn = state.systemStatusJson();
+    EXPECT_EQ(state.systemStatusJson(), warn);
+    EXPECT_EQ(cache.take().hits, 1u);
+
+    Logger::setLevel(Logger::Level::ERROR);
+    const String error = state.systemStatusJson();
+    EXPECT_NE(error, warn);
+    EXPECT_EQ(cache.take().misses, 1u);
+
+    ASSERT_TRUE(console.executeCommand("us"));
+    DynamicJsonDocument doc(512);
+    ASSERT_FALSE(deserializeJson(doc, state.systemStatusJson()));
+    EXPECT_TRUE(doc["ultrasonicStreaming"]["left"].as<bool>());
+    EXPECT_TRUE(doc["ultrasonicStreaming"]["right"].as<bool>());
+    EXPECT_EQ(cache.take().misses, 1u);
+
+    ASSERT_TRUE(console.executeCommand("us"));
+    EXPECT_EQ(state.systemStatusJson(), error);
+    EXPECT_EQ(cache.take().misses, 1u);
+    Logger::setLevel(Logger::Level::WARN);
+}
+
+// Test: light sides and colours are matched case-insensitively, whatever sent them
+TEST(StateWriterLightTest, ParsesSideAndColourIgnoringCase) {
+    StateFixture f;
+    f.carLight("LEFT", "rEd");
+    EXPECT_EQ(f.state.state().carLeft, LightColour::RED);
+    EXPECT_EQ(f.state.state().carRight, LightColour::GREEN);
+
+    f.carLight("Both", "YELLOW");
+    EXPECT_EQ(f.state.state().carLeft, LightColour::YELLOW);
+    EXPECT_EQ(f.state.state().carRight, LightColour::YELLOW);
+
+    f.boatLight("Right", "green");
+    EXPECT_EQ(f.state.state().boatRight, LightColour::GREEN);
+
+    // Shown with the canonical names
+    DynamicJsonDocument doc(512);
+    ASSERT_FALSE(deserializeJson(doc, f.state.carTrafficStatusJson()));
+    EXPECT_STREQ(doc["left"]["value"].as<const char*>(), "Yellow");
+    doc.clear();
+    f.state.buildSnapshot(doc);
+    EXPECT_STREQ(doc["payload"]["traffic"]["boat"]["right"]["value"].as<const char*>(), "Green");
+}
+
+// Test: a lowercase "green" (the console's spelling) starts the boat timer like "Green"
+TEST(StateWriterLightTest, LowercaseGreenStartsBoatTimer) {
+    StateFixture f;
+    mock_millis = 4200;
+    f.boatLight("left", "green");
+    EXPECT_EQ(f.state.state().boatTimerStartMs, 4200u);
+    EXPECT_EQ(f.state.state().boatTimerSide, LightSide::LEFT);
+
+    f.boatLight("left", "red");
+    EXPECT_EQ(f.state.state().boatTimerStartMs, 0u);
+    EXPECT_EQ(f.state.state().boatTimerSide, LightSide::NONE);
+}
+
+// Test: an unknown colour is logged but leaves the light, and its section, as they were
+TEST(StateWriterLightTest, UnknownColourLeavesLightUnchanged) {
+    StateFixture f;
+    mock_millis = 1000;
+    f.boatLight("left", "Green");
+    const UiState before = f.state.state();
+    const String car = f.state.carTrafficStatusJson();
+
+    f.carLight("both", "Purple");
+    f.boatLight("left", "Blue");
+    const UiState after = f.state.state();
+    EXPECT_EQ(after.carLeft, before.carLeft);
+    EXPECT_EQ(after.carRight, before.carRight);
+    EXPECT_EQ(after.boatLeft, LightColour::GREEN);
+    EXPECT_EQ(after.boatTimerStartMs, 1000u);
+    EXPECT_EQ(f.state.carTrafficStatusJson(), car);
+
+    DynamicJsonDocument doc(1024);
+    ASSERT_TRUE(f.state.buildPatch(doc, before.version));
+    EXPECT_TRUE(doc["payload"]["traffic"].isNull());
+    EXPECT_TRUE(doc["payload"]["bridge"].isNull());
+    EXPECT_EQ(doc["payload"]["log"].size(), 2u);
+}
+
+// Test: /system/log pages - the newest page without a cursor, then forward from a cursor
+// LOG_PAGE_LINES at a time, "more" until the newest line has been read
+TEST(StateWriterLogTest, PagesForwardFromACursor) {
+    StateFixture f;
+    for (int i = 0; i < 70; ++i) f.event(BridgeEvent::BOAT_DETECTED);  // seq 0..69
+
+    DynamicJsonDocument doc(8192);
+    f.state.fillLog(doc.to<JsonObject>(), StateWriter::LOG_LATEST);
+    ASSERT_EQ(doc["lines"].size(), StateWriter::LOG_PAGE_LINES);
+    EXPECT_EQ(doc["lines"][0]["seq"].as<uint32_t>(), 70u - StateWriter::LOG_PAGE_LINES);
+    EXPECT_EQ(doc["lines"][StateWriter::LOG_PAGE_LINES - 1]["seq"].as<uint32_t>(), 69u);
+    EXPECT_EQ(doc["since"].as<int>(), -1);
+    EXPECT_EQ(doc["next"].as<uint32_t>(), 70u);
+    EXPECT_EQ(doc["dropped"].as<uint32_t>(), 0u);
+    EXPECT_FALSE(doc["more"].as<bool>());
+
+    uint32_t since = 9;
+    uint32_t pages = 0;
+    uint32_t expected = 10;
+    for (;;) {
+        doc.clear();
+        f.state.fillLog(doc.to<JsonObject>(), since);
+        pages++;
+        EXPECT_EQ(doc["since"].as<uint32_t>(), since);
+        EXPECT_EQ(doc["dropped"].as<uint32_t>(), 0u);
+        JsonArray lines = doc["lines"].as<JsonArray>();
+        EXPECT_LE(lines.size(), StateWriter::LOG_PAGE_LINES);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            EXPECT_EQ(lines[i]["seq"].as<uint32_t>(), expected++);
+        }
+        if (!doc["more"].as<bool>()) break;
+        since = lines[lines.size() - 1]["seq"].as<uint32_t>();
+    }
+    EXPECT_EQ(pages, 2u);
+    EXPECT_EQ(expected, 70u);
+
+    // At the newest line: nothing, and nothing more
+    doc.clear();
+    f.state.fillLog(doc.to<JsonObject>(), 69);
+    EXPECT_EQ(doc["lines"].size(), 0u);
+    EXPECT_FALSE(doc["more"].as<bool>());
+}
+
+// Test: the newest page of a short log is all of it
+TEST(StateWriterLogTest, LatestPageOfAShortLog) {
+    StateFixture f;
+    DynamicJsonDocument doc(2048);
+    f.state.fillLog(doc.to<JsonObject>(), StateWriter::LOG_LATEST);
+    EXPECT_EQ(doc["lines"].size(), 0u);
+    EXPECT_EQ(doc["next"].as<uint32_t>(), 0u);
+
+    for (int i = 0; i < 5; ++i) f.event(BridgeEvent::BOAT_PASSED);
+    doc.clear();
+    f.state.fillLog(doc.to<JsonObject>(), StateWriter::LOG_LATEST);
+    ASSERT_EQ(doc["lines"].size(), 5u);
+    EXPECT_EQ(doc["lines"][0]["seq"].as<uint32_t>(), 0u);
+    EXPECT_FALSE(doc["more"].as<bool>());
+}
+
+// Test: a cursor older than the ring gets what is still held and how many lines it missed
+TEST(StateWriterLogTest, CursorOlderThanTheRingReportsDropped) {
+    StateFixture f(16);
+    for (int i = 0; i < 40; ++i) f.event(BridgeEvent::BOAT_DETECTED);  // Holds seq 24..39
+
+    DynamicJsonDocument doc(4096);
+    f.state.fillLog(doc.to<JsonObject>(), 9);
+    ASSERT_EQ(doc["lines"].size(), 16u);
+    EXPECT_EQ(doc["lines"][0]["seq"].as<uint32_t>(), 24u);
+    EXPECT_EQ(doc["dropped"].as<uint32_t>(), 14u);  // 10..23
+    EXPECT_EQ(doc["next"].as<uint32_t>(), 40u);
+    EXPECT_FALSE(doc["more"].as<bool>());
+
+    // The newest page never reports drops: it never asked for older lines
+    doc.clear();
+    f.state.fillLog(doc.to<JsonObject>(), StateWriter::LOG_LATEST);
+    EXPECT_EQ(doc["lines"].size(), 16u);
+    EXPECT_EQ(doc["dropped"].as<uint32_t>(), 0u);
+}
+
+// Test: snapshots and patches built while the dispatch task publishes are each taken from
+// one whole UiState - the fields one event sets together are never seen half applied
+TEST(StateWriterConcurrencyTest, SnapshotsAndPatchesStayConsistentWhilePublishing) {
+    StateFixture f;
+    constexpr uint32_t CYCLES = 2000;
+    constexpr int STATES = static_cast<int>(BridgeState::RESUMING_TRAFFIC) + 1;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> inconsistent{0};
+    std::atomic<uint32_t> backwards{0};
+    std::atomic<uint32_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&, r]() {
+            uint32_t last = 0;
+            Mirror patched;
+            bool based = false;
+            uint32_t patchedVersion = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                DynamicJsonDocument doc(4096);
+                if (r == 0 || !based) {
+                    f.state.buildSnapshot(doc);
+                    Mirror snapshot;
+                    snapshot.apply(doc["payload"].as<JsonObject>());
+                    if (!snapshot.consistent()) inconsistent.fetch_add(1, std::memory_order_relaxed);
+                    if (r == 1) {
+                        patched = snapshot;
+                        patchedVersion = doc["payload"]["seq"].as<uint32_t>();
+                        based = true;
+                    }
+                } else if (f.state.buildPatch(doc, patchedVersion)) {
+                    patched.apply(doc["payload"].as<JsonObject>());
+                    if (!patched.consistent()) inconsistent.fetch_add(1, std::memory_order_relaxed);
+                    patchedVersion = doc["payload"]["seq"].as<uint32_t>();
+                } else {
+                    based = false;  // Log overran: rebase on a snapshot
+                    continue;
+                }
+                const uint32_t seq = doc["payload"]["seq"].as<uint32_t>();
+                if (seq < last) backwards.fetch_add(1, std::memory_order_relaxed);
+                last = seq;
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (uint32_t k = 1; k <= CYCLES; ++k) {
+        const BridgeState next = static_cast<BridgeState>(k % STATES);
+        mock_millis = k * 10 + static_cast<uint32_t>(next);
+        f.stateChange(static_cast<BridgeState>((k - 1) % STATES), next);
+        f.boatLight((k % 2) ? "left" : "right", "Green");
+        f.boatLight((k % 2) ? "left" : "right", "Red");
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& t : readers) t.join();
+
+    EXPECT_EQ(inconsistent.load(), 0u);
+    EXPECT_EQ(backwards.load(), 0u);
+    EXPECT_GT(reads.load(), 0u);
+
+    DynamicJsonDocument doc(4096);
+    f.state.buildSnapshot(doc);
+    Mirror settled;
+    settled.apply(doc["payload"].as<JsonObject>());
+    EXPECT_TRUE(settled.consistent());
+    EXPECT_EQ(settled.lastChangeMs, CYCLES * 10 + CYCLES % STATES);
+}
@@ -0,0 +1,249 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "EventBus.h"
+#include "SignalControl.h"
+#include "TimerWheel.h"
+
+// Test: every timer fires on exactly its deadline tick, across all wheel levels
+TEST(TimerWheelTest, FiresOnDeadlineAcrossLevels) {
+    const uint32_t start = 1000;  // Not slot-aligned, so cascades happen mid-delay
+    TimerWheel wheel(start);
+
+    std::vector<uint32_t> delays = {0, 1, 2, 63, 64, 65, 127, 4095, 4096, 4097, 45000, 120000, 262143, 262144};
+    std::mt19937 rng(7);
+    while (delays.size() < TimerWheel::MAX_TIMERS) {
+        delays.push_back(rng() % 300000);
+    }
+
+    std::vector<uint32_t> firedAt(delays.size(), 0);
+    uint32_t now = start;
+    for (size_t i = 0; i < delays.size(); ++i) {
+        ASSERT_NE(wheel.schedule(start, delays[i], [&firedAt, &now, i]() { firedAt[i] = now; }),
+                  INVALID_TIMER_ID);
+    }
+    EXPECT_EQ(wheel.pending(), delays.size());
+
+    // Step one ms at a time so each callback records the tick it fired on
+    while (wheel.pending() > 0 && now < start + 400000) {
+        wheel.advance(++now);
+    }
+
+    for (size_t i = 0; i < delays.size(); ++i) {
+        const uint32_t expected = start + (delays[i] == 0 ? 1 : delays[i]);
+        EXPECT_EQ(firedAt[i], expected) << "delay " << delays[i];
+    }
+}
+
+// Test: cancel() is one-shot and ids of fired/cancelled timers never hit a later timer
+TEST(TimerWheelTest, CancelAndStaleIds) {
+    TimerWheel wheel;
+    int a = 0;
+    int b = 0;
+
+    TimerId first = wheel.schedule(0, 100, [&a]() { a++; });
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(INVALID_TIMER_ID));
+
+    // Reuses the freed node; the old id must not cancel it
+    TimerId second = wheel.schedule(0, 100, [&b]() { b++; });
+    EXPECT_NE(second, first);
+    EXPECT_FALSE(wheel.cancel(first));
+
+    EXPECT_EQ(wheel.advance(99), 0u);
+    EXPECT_EQ(wheel.advance(100), 1u);
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 1);
+    EXPECT_FALSE(wheel.cancel(second));  // Already fired
+
+    // Pool exhaustion is reported, not grown
+    for (size_t i = 0; i < TimerWheel::MAX_TIMERS; ++i) {
+        ASSERT_NE(wheel.schedule(100, 10, []() {}), INVALID_TIMER_ID);
+    }
+    EXPECT_EQ(wheel.schedule(100, 10, []() {}), INVALID_TIMER_ID);
+    wheel.clear();
+    EXPECT_EQ(wheel.pending(), 0u);
+    EXPECT_EQ(wheel.advance(200), 0u);
+}
+
+// Test: a stale id still misses after one pool slot has been re-armed past 16 bits of
+// generations (SignalControl re-arms its phase timer for every stop/resume)
+TEST(TimerWheelTest, StaleIdSurvivesManyRearms) {
+    TimerWheel wheel;
+    const TimerId stale = wheel.schedule(0, 100, []() {});
+    ASSERT_TRUE(wheel.cancel(stale));
+
+    // The freed node is reused by each schedule; 65536 re-arms wrapped a uint16_t generation
+    for (uint32_t i = 0; i < 65535; ++i) {
+        ASSERT_TRUE(wheel.cancel(wheel.schedule(0, 100, []() {})));
+    }
+    int fired = 0;
+    const TimerId live = wheel.schedule(0, 100, [&fired]() { fired++; });
+    EXPECT_NE(live, stale);
+    EXPECT_FALSE(wheel.cancel(stale));
+    EXPECT_EQ(wheel.advance(100), 1u);
+    EXPECT_EQ(fired, 1);
+}
+
+// Test: callbacks can re-arm themselves (periodic blink) and cancel other timers
+TEST(TimerWheelTest, CallbacksRearmAndCancel) {
+    struct Context {
+        TimerWheel wheel;
+        uint32_t now = 0;
+        std::vector<uint32_t> ticks;
+        TimerId victim = INVALID_TIMER_ID;
+        TimerWheel::Callback periodic;
+    } ctx;
+
+    // 64 ms re-arm lands back in the bucket being fired; it must wait a full turn
+    ctx.periodic = [c = &ctx]() {
+        c->ticks.push_back(c->now);
+        if (c->ticks.size() < 4) {
+            c->wheel.schedule(c->now, 64, c->periodic);
+        }
+        c->wheel.cancel(c->victim);
+    };
+    ctx.wheel.schedule(0, 64, ctx.periodic);
+    ctx.victim = ctx.wheel.schedule(0, 300, []() { FAIL() << "cancelled timer ran"; });
+
+    for (ctx.now = 1; ctx.now <= 400; ctx.now += 5) {
+        ctx.wheel.advance(ctx.now);
+    }
+    ASSERT_EQ(ctx.ticks.size(), 4u);
+    // Each fires on the first 5 ms advance at or after its deadline and re-arms from there
+    EXPECT_EQ(ctx.ticks[0], 66u);
+    EXPECT_EQ(ctx.ticks[1], 131u);
+    EXPECT_EQ(ctx.ticks[2], 196u);
+    EXPECT_EQ(ctx.ticks[3], 261u);
+}
+
+// Test: nextDueIn() reports the earliest deadline so the caller knows how long it may sleep
+TEST(TimerWheelTest, NextDueIn) {
+    TimerWheel wheel(500);
+    EXPECT_EQ(wheel.nextDueIn(500), TimerWheel::NO_TIMER);
+
+    TimerId late = wheel.schedule(500, 12000, []() {});
+    wheel.schedule(500, 2000, []() {});
+    EXPECT_EQ(wheel.nextDueIn(500), 2000u);
+    EXPECT_EQ(wheel.nextDueIn(2400), 100u);
+    EXPECT_EQ(wheel.nextDueIn(3000), 0u);  // Overdue
+
+    wheel.advance(2500);
+    EXPECT_EQ(wheel.nextDueIn(2500), 10000u);
+    wheel.cancel(late);
+    EXPECT_EQ(wheel.nextDueIn(2500), TimerWheel::NO_TIMER);
+}
+
+// Test: publishAfter() / callAfter() fire from processEvents() once mock time passes the deadline
+TEST(TimerWheelTest, EventBusPublishAfter) {
+    EventBus bus;
+    mock_millis = 10000;
+    int expired = 0;
+    int cancelled = 0;
+    int called = 0;
+    bus.subscribe(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED, [&expired](EventData* data) {
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(data->getEventEnum(), BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED);
+        expired++;
+    });
+    bus.subscribe(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, [&cancelled](EventData*) { cancelled++; });
+
+    EXPECT_NE(bus.publishAfter(BOAT_GREEN_PERIOD_MS, BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED), INVALID_TIMER_ID);
+    TimerId stop = bus.publishAfter(12000, BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
+    bus.callAfter(2000, [&called]() { called++; });
+    EXPECT_EQ(bus.msUntilNextTimer(), 2000u);
+
+    mock_millis += 1999;
+    bus.processEvents();
+    EXPECT_EQ(called, 0);
+    mock_millis += 1;
+    bus.processEvents();
+    EXPECT_EQ(called, 1);
+
+    EXPECT_TRUE(bus.cancelTimer(stop));
+    mock_millis = 10000 + BOAT_GREEN_PERIOD_MS - 5;
+    bus.processEvents();
+    EXPECT_EQ(expired, 0);
+    mock_millis += 5;
+    EXPECT_EQ(bus.processEvents(), 1u);  // The timer's event is dispatched in the same call
+    EXPECT_EQ(expired, 1);
+    EXPECT_EQ(cancelled, 0);
+    EXPECT_EQ(bus.msUntilNextTimer(), TimerWheel::NO_TIMER);
+
+    // clear() drops armed timers along with queued events
+    bus.publishAfter(10, BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
+    bus.clear();
+    mock_millis += 100;
+    bus.processEvents();
+    EXPECT_EQ(cancelled, 0);
+}
+
+// Test: halt() part-way through a phased operation or a boat green period cancels its
+// timers - nothing drives a light or reports SUCCESS afterwards
+TEST(TimerWheelTest, SignalControlHaltCancelsPendingPhases) {
+    EventBus bus;
+    mock_millis = 50000;
+    SignalControl signals(bus);
+    signals.begin();
+
+    int lightChanges = 0;
+    int successes = 0;
+    int expired = 0;
+    bus.subscribe(BridgeEvent::CAR_LIGHT_CHANGED_SUCCESS, [&lightChanges](EventData*) { lightChanges++; });
+    bus.subscribe(BridgeEvent::BOAT_LIGHT_CHANGED_SUCCESS, [&lightChanges](EventData*) { lightChanges++; });
+    bus.subscribe(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, [&successes](EventData*) { successes++; });
+    bus.subscribe(BridgeEvent::TRAFFIC_RESUMED_SUCCESS, [&successes](EventData*) { successes++; });
+    bus.subscribe(BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED, [&expired](EventData*) { expired++; });
+
+    // Fault 1 s into the 2 s red hold of a resume
+    signals.resumeTraffic();
+    signals.startBoatGreenPeriod("left");
+    mock_millis += 1000;
+    bus.processEvents();
+    lightChanges = 0;
+    signals.halt();
+    EXPECT_FALSE(signals.isBoatGreenPeriodActive());
+    EXPECT_EQ(bus.msUntilNextTimer(), TimerWheel::NO_TIMER);
+
+    mock_millis += BOAT_GREEN_PERIOD_MS + 1000;
+    bus.processEvents();
+    EXPECT_EQ(lightChanges, 0);
+    EXPECT_EQ(successes, 0);
+    EXPECT_EQ(expired, 0);
+
+    // Fault between the yellow and red phases of a stop
+    signals.stopTraffic();
+    mock_millis += 7000;
+    bus.processEvents();
+    lightChanges = 0;
+    signals.halt();
+    EXPECT_FALSE(signals.isPedestrianTimerActive());
+    EXPECT_EQ(bus.msUntilNextTimer(), TimerWheel::NO_TIMER);
+
+    mock_millis += 20000;
+    bus.processEvents();
+    EXPECT_EQ(lightChanges, 0);
+    EXPECT_EQ(successes, 0);
+}
+
+// Test: idle ticks with the whole pool armed far ahead fire nothing and keep every timer
+// (per-tick cost against polling: BM_TimerWheelTick / BM_PollingTick in bench/)
+TEST(TimerWheelTest, IdleTicksFireNothing) {
+    constexpr uint32_t TICKS = 200000;
+    TimerWheel wheel;
+    int fired = 0;
+    for (size_t i = 0; i < TimerWheel::MAX_TIMERS; ++i) {
+        wheel.schedule(0, 1000000 + static_cast<uint32_t>(i), [&fired]() { fired++; });
+    }
+
+    for (uint32_t now = 1; now <= TICKS; ++now) {
+        wheel.advance(now);
+    }
+    EXPECT_EQ(fired, 0);
+    EXPECT_EQ(wheel.pending(), TimerWheel::MAX_TIMERS);
+}
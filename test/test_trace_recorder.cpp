@@ -0,0 +1,209 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "EventBus.h"
+#include "TraceRecorder.h"
+
+namespace {
+
+uint32_t readU32(const std::vector<uint8_t>& blob, size_t offset) {
+    uint32_t value;
+    std::memcpy(&value, blob.data() + offset, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+// Test: once full, the ring keeps the newest CAPACITY records, oldest first
+TEST(TraceRecorderTest, RingKeepsNewestRecords) {
+    auto trace = std::make_unique<TraceRecorder>();
+    const uint32_t extra = 10;
+    for (uint32_t i = 0; i < TraceRecorder::CAPACITY + extra; ++i) {
+        trace->record(TraceKind::PUBLISH, BridgeEvent::BOAT_DETECTED, BoatEventSide::UNKNOWN,
+                      EventPriority::NORMAL, 70000, i, 100000);
+    }
+    EXPECT_EQ(trace->size(), TraceRecorder::CAPACITY);
+    EXPECT_EQ(trace->totalRecorded(), TraceRecorder::CAPACITY + extra);
+
+    std::vector<TraceRecord> records(TraceRecorder::CAPACITY);
+    ASSERT_EQ(trace->snapshot(records.data(), records.size()), TraceRecorder::CAPACITY);
+    EXPECT_EQ(records.front().timestampUs, extra);
+    EXPECT_EQ(records.back().timestampUs, TraceRecorder::CAPACITY + extra - 1);
+    EXPECT_EQ(records.front().queueDepth, UINT16_MAX);  // Saturated, not truncated
+    EXPECT_EQ(records.front().durationUs, UINT16_MAX);
+
+    trace->setEnabled(false);
+    trace->record(TraceKind::PUBLISH, BridgeEvent::BOAT_DETECTED, BoatEventSide::UNKNOWN, EventPriority::NORMAL, 0, 0);
+    EXPECT_EQ(trace->totalRecorded(), TraceRecorder::CAPACITY + extra);
+
+    trace->clear();
+    EXPECT_EQ(trace->size(), 0u);
+    EXPECT_FALSE(trace->isEnabled());  // clear() keeps the enabled flag
+}
+
+// Test: publish, remote publish, drop and dispatch are all recorded with side and depth
+TEST(TraceRecorderTest, EventBusWritesPublishDropAndDispatch) {
+    auto trace = std::make_unique<TraceRecorder>();
+    EventBus bus(2, 2);
+    bus.setTraceRecorder(trace.get());
+    bus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, [](EventData*) {});
+
+    bus.emplace<BoatEventData>(BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT);
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);
+    bus.emplace<SimpleEventData>(BridgeEvent::BOAT_PASSED);  // Normal ring holds 2 - dropped
+    EXPECT_TRUE(bus.emplaceRemote<SimpleEventData>(BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED));
+    bus.emplace<SimpleEventData, EventPriority::EMERGENCY>(BridgeEvent::FAULT_DETECTED);
+    EXPECT_EQ(bus.processEvents(), 4u);
+
+    std::vector<TraceRecord> records(16);
+    records.resize(trace->snapshot(records.data(), records.size()));
+    ASSERT_EQ(records.size(), 9u);
+
+    const auto kindOf = [](const TraceRecord& r) { return static_cast<TraceKind>(r.kind); };
+    const auto eventOf = [](const TraceRecord& r) { return static_cast<BridgeEvent>(r.event); };
+
+    EXPECT_EQ(kindOf(records[0]), TraceKind::PUBLISH);
+    EXPECT_EQ(eventOf(records[0]), BridgeEvent::BOAT_DETECTED_LEFT);
+    EXPECT_EQ(static_cast<BoatEventSide>(records[0].side), BoatEventSide::LEFT);
+    EXPECT_EQ(records[0].queueDepth, 1u);
+    EXPECT_EQ(records[1].queueDepth, 2u);
+    EXPECT_EQ(kindOf(records[2]), TraceKind::DROP);
+    EXPECT_EQ(kindOf(records[3]), TraceKind::PUBLISH_REMOTE);
+    EXPECT_EQ(static_cast<EventPriority>(records[4].priority), EventPriority::EMERGENCY);
+
+    // EMERGENCY first, then NORMAL FIFO, then the event drained from the hand-off queue
+    EXPECT_EQ(kindOf(records[5]), TraceKind::DISPATCH);
+    EXPECT_EQ(eventOf(records[5]), BridgeEvent::FAULT_DETECTED);
+    EXPECT_EQ(eventOf(records[6]), BridgeEvent::BOAT_DETECTED_LEFT);
+    EXPECT_EQ(static_cast<BoatEventSide>(records[6].side), BoatEventSide::LEFT);
+    EXPECT_GE(records[6].timestampUs, records[0].timestampUs);
+    EXPECT_EQ(eventOf(records[8]), BridgeEvent::MANUAL_BRIDGE_OPEN_REQUESTED);
+    EXPECT_EQ(records[8].queueDepth, 0u);
+    for (size_t i = 5; i < records.size(); ++i) {
+        EXPECT_EQ(kindOf(records[i]), TraceKind::DISPATCH);
+    }
+}
+
+// Test: dump() emits a header and whole records in pieces that base64-encode independently
+TEST(TraceRecorderTest, DumpFormat) {
+    auto trace = std::make_unique<TraceRecorder>();
+    const size_t count = TraceRecorder::CAPACITY + 100;  // Wrapped, so the ring is split
+    for (size_t i = 0; i < count; ++i) {
+        trace->record(TraceKind::DISPATCH, BridgeEvent::STATE_CHANGED, BoatEventSide::RIGHT,
+                      EventPriority::NORMAL, i % 7, static_cast<uint32_t>(i), 42);
+    }
+
+    struct Capture {
+        std::vector<uint8_t> blob;
+        size_t pieces = 0;
+        bool allMultiplesOfThree = true;
+    } capture;
+    const size_t dumped = trace->dump([c = &capture](const uint8_t* data, size_t len) {
+        c->blob.insert(c->blob.end(), data, data + len);
+        c->pieces++;
+        c->allMultiplesOfThree = c->allMultiplesOfThree && (len % 3 == 0);
+    });
+
+    EXPECT_EQ(dumped, TraceRecorder::CAPACITY);
+    EXPECT_TRUE(capture.allMultiplesOfThree);
+    ASSERT_EQ(capture.blob.size(), TraceRecorder::HEADER_SIZE + dumped * sizeof(TraceRecord));
+    EXPECT_EQ(readU32(capture.blob, 0), TraceRecorder::MAGIC);
+    EXPECT_EQ(std::memcmp(capture.blob.data(), "BTRC", 4), 0);
+    EXPECT_EQ(capture.blob[4], TraceRecorder::FORMAT_VERSION);
+    EXPECT_EQ(capture.blob[6], sizeof(TraceRecord));
+    EXPECT_EQ(readU32(capture.blob, 8), TraceRecorder::CAPACITY);
+    EXPECT_EQ(readU32(capture.blob, 12), count);
+    EXPECT_EQ(readU32(capture.blob, 16), TraceRecorder::CAPACITY);
+
+    // Records follow oldest first, across the wrap point
+    for (size_t i = 0; i < dumped; ++i) {
+        TraceRecord r;
+        std::memcpy(&r, capture.blob.data() + TraceRecorder::HEADER_SIZE + i * sizeof(TraceRecord), sizeof(r));
+        ASSERT_EQ(r.timestampUs, count - TraceRecorder::CAPACITY + i);
+        ASSERT_EQ(r.durationUs, 42u);
+    }
+    EXPECT_TRUE(trace->isEnabled());  // Recording resumes after the dump
+}
+
+// Test: the incremental dump reads the same bytes as dump(), keeps recording paused until
+// endDump() and excludes a second dump meanwhile
+TEST(TraceRecorderTest, IncrementalDumpMatchesDump) {
+    auto trace = std::make_unique<TraceRecorder>();
+    const size_t count = TraceRecorder::CAPACITY + 37;
+    for (size_t i = 0; i < count; ++i) {
+        trace->record(TraceKind::PUBLISH, BridgeEvent::BOAT_DETECTED, BoatEventSide::LEFT,
+                      EventPriority::NORMAL, i % 5, static_cast<uint32_t>(i));
+    }
+
+    std::vector<uint8_t> whole;
+    trace->dump([w = &whole](const uint8_t* data, size_t len) { w->insert(w->end(), data, data + len); });
+
+    TraceRecorder::DumpCursor cursor;
+    ASSERT_TRUE(trace->beginDump(cursor));
+    EXPECT_FALSE(trace->isEnabled());
+    EXPECT_EQ(trace->dump([](const uint8_t*, size_t) { FAIL() << "second dump ran"; }), 0u);
+    TraceRecorder::DumpCursor other;
+    EXPECT_FALSE(trace->beginDump(other));
+
+    std::vector<uint8_t> pieces;
+    uint8_t buffer[48];
+    for (size_t len; (len = trace->readDump(cursor, buffer, sizeof(buffer))) > 0;) {
+        EXPECT_EQ(len % 3, 0u);
+        pieces.insert(pieces.end(), buffer, buffer + len);
+        trace->record(TraceKind::PUBLISH, BridgeEvent::BOAT_PASSED, BoatEventSide::LEFT,
+                      EventPriority::NORMAL, 0, 0);  // Paused: not recorded
+    }
+    trace->endDump(cursor);
+
+    // Only the header's micros() field may differ
+    ASSERT_EQ(pieces.size(), whole.size());
+    EXPECT_EQ(std::memcmp(pieces.data(), whole.data(), 20), 0);
+    EXPECT_EQ(std::memcmp(pieces.data() + TraceRecorder::HEADER_SIZE, whole.data() + TraceRecorder::HEADER_SIZE,
+                          whole.size() - TraceRecorder::HEADER_SIZE), 0);
+    EXPECT_EQ(trace->totalRecorded(), count);
+    EXPECT_TRUE(trace->isEnabled());
+    EXPECT_TRUE(trace->beginDump(other));
+    trace->endDump(other);
+}
+
+// Test: writers on other threads never tear a record while a dump is in progress
+TEST(TraceRecorderTest, ConcurrentWritersAndDump) {
+    auto trace = std::make_unique<TraceRecorder>();
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (uint8_t w = 0; w < 3; ++w) {
+        writers.emplace_back([&trace, &stop, w]() {
+            uint32_t n = 0;
+            while (!stop.load()) {
+                // Every field carries the writer id, so a torn record shows up as a mismatch
+                trace->record(TraceKind::PUBLISH, static_cast<BridgeEvent>(w), static_cast<BoatEventSide>(w),
+                              EventPriority::NORMAL, w, w * 1000000u + (n++ % 1000), w);
+            }
+        });
+    }
+
+    std::vector<TraceRecord> records(TraceRecorder::CAPACITY);
+    for (int round = 0; round < 20; ++round) {
+        const size_t n = trace->snapshot(records.data(), records.size());
+        for (size_t i = 0; i < n; ++i) {
+            const TraceRecord& r = records[i];
+            ASSERT_EQ(r.side, r.event);
+            ASSERT_EQ(r.queueDepth, r.event);
+            ASSERT_EQ(r.durationUs, r.event);
+            ASSERT_EQ(r.timestampUs / 1000000u, r.event);
+        }
+        std::this_thread::yield();
+    }
+    stop.store(true);
+    for (auto& t : writers) {
+        t.join();
+    }
+    EXPECT_GT(trace->totalRecorded(), 0u);
+}
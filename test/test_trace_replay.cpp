@@ -0,0 +1,134 @@
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "TraceReplay.h"
+
+namespace {
+
+std::vector<std::string> formatAll(const std::vector<ReplayOutput>& outputs) {
+    std::vector<std::string> lines;
+    for (const ReplayOutput& output : outputs) {
+        lines.push_back(TraceReplay::format(output));
+    }
+    return lines;
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+ReplayInput input(uint32_t timeMs, BridgeEvent event, BoatEventSide side = BoatEventSide::UNKNOWN) {
+    return ReplayInput{timeMs, event, side, EventPriority::NORMAL};
+}
+
+}  // namespace
+
+// Test: the recorded two-boat cycle replays to the checked-in command/transition sequence
+TEST(TraceReplayTest, BoatCycleMatchesGoldenFile) {
+    std::ifstream trace(std::string(REPLAY_TRACE_DIR) + "/boat_cycle.csv");
+    ASSERT_TRUE(trace.is_open());
+    std::vector<ReplayInput> inputs;
+    std::string error;
+    ASSERT_TRUE(TraceReplay::loadCsv(trace, inputs, &error)) << error;
+
+    TraceReplay replay;
+    const std::vector<std::string> actual = formatAll(replay.run(inputs));
+    const std::vector<std::string> expected = readLines(std::string(REPLAY_TRACE_DIR) + "/boat_cycle.expected");
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(actual, expected);
+}
+
+// Test: replays are repeatable and run far faster than the virtual time they cover
+TEST(TraceReplayTest, DeterministicAndFasterThanRealTime) {
+    const std::vector<ReplayInput> inputs = {
+        input(0, BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT),
+        input(0, BridgeEvent::BOAT_DETECTED, BoatEventSide::RIGHT),
+        input(12000, BridgeEvent::TRAFFIC_STOPPED_SUCCESS),
+        input(28000, BridgeEvent::BRIDGE_OPENED_SUCCESS),
+        input(51000, BridgeEvent::BOAT_PASSED_RIGHT, BoatEventSide::RIGHT),
+        input(73000, BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED),
+        input(90000, BridgeEvent::BRIDGE_CLOSED_SUCCESS),
+        input(92000, BridgeEvent::TRAFFIC_RESUMED_SUCCESS),
+    };
+
+    TraceReplay replay;
+    const std::vector<std::string> first = formatAll(replay.run(inputs));
+    const TraceReplay::Stats stats = replay.lastStats();
+    const std::vector<std::string> second = formatAll(replay.run(inputs));
+
+    EXPECT_EQ(first, second);
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(first.back(), "92000 STATE RESUMING_TRAFFIC -> IDLE");
+    EXPECT_EQ(stats.inputs, inputs.size());
+    EXPECT_EQ(stats.virtualMs, 92000u + BOAT_PASSAGE_TIMEOUT_MS);
+    EXPECT_LT(stats.wallMs * 1000.0, static_cast<double>(stats.virtualMs));
+}
+
+// Test: a boat queued behind a cycle starts the next one exactly BOAT_CYCLE_COOLDOWN_MS after traffic resumes
+TEST(TraceReplayTest, CooldownTimerReleasesQueuedBoat) {
+    const std::vector<ReplayInput> inputs = {
+        input(0, BridgeEvent::BOAT_DETECTED_LEFT, BoatEventSide::LEFT),
+        input(1000, BridgeEvent::TRAFFIC_STOPPED_SUCCESS),
+        input(2000, BridgeEvent::BRIDGE_OPENED_SUCCESS),
+        input(10000, BridgeEvent::BOAT_PASSED_LEFT, BoatEventSide::LEFT),
+        input(47000, BridgeEvent::BOAT_GREEN_PERIOD_EXPIRED),
+        input(50000, BridgeEvent::BOAT_DETECTED_RIGHT, BoatEventSide::RIGHT),
+        input(60000, BridgeEvent::BRIDGE_CLOSED_SUCCESS),
+        input(61000, BridgeEvent::TRAFFIC_RESUMED_SUCCESS),
+    };
+
+    TraceReplay replay;
+    const std::vector<ReplayOutput> outputs = replay.run(inputs);
+
+    std::vector<uint32_t> stopTimes;
+    for (const ReplayOutput& output : outputs) {
+        EXPECT_FALSE(output.kind == ReplayOutput::Kind::TRANSITION && output.to == BridgeState::FAULT);
+        if (output.kind == ReplayOutput::Kind::COMMAND && output.action == CommandAction::STOP_TRAFFIC) {
+            stopTimes.push_back(output.timeMs);
+        }
+    }
+    ASSERT_EQ(stopTimes.size(), 2u) << ::testing::PrintToString(formatAll(outputs));
+    EXPECT_EQ(stopTimes[0], 0u);
+    EXPECT_EQ(stopTimes[1], 61000u + BOAT_CYCLE_COOLDOWN_MS);
+}
+
+// Test: only published inputs are kept, times are rebased, malformed rows are rejected
+TEST(TraceReplayTest, LoadCsvFiltersAndValidates) {
+    std::istringstream good(
+        "# comment\n"
+        "timestamp_us,kind,event,side,priority,queue_depth,duration_us\n"
+        "5000000,PUBLISH,BOAT_DETECTED_LEFT,LEFT,NORMAL,1,\n"
+        "5000100,DISPATCH,BOAT_DETECTED_LEFT,LEFT,NORMAL,0,90\n"
+        "5000200,PUBLISH,STATE_CHANGED,UNKNOWN,NORMAL,1,\n"
+        "5002500,DROP,BOAT_PASSED,UNKNOWN,NORMAL,8,\n"
+        "5007500,PUBLISH_REMOTE,BEAM_BREAK_ACTIVE,UNKNOWN,EMERGENCY,0,\r\n");
+    std::vector<ReplayInput> inputs;
+    ASSERT_TRUE(TraceReplay::loadCsv(good, inputs));
+    ASSERT_EQ(inputs.size(), 2u);
+    EXPECT_EQ(inputs[0].timeMs, 0u);
+    EXPECT_EQ(inputs[0].side, BoatEventSide::LEFT);
+    EXPECT_EQ(inputs[1].event, BridgeEvent::BEAM_BREAK_ACTIVE);
+    EXPECT_EQ(inputs[1].timeMs, 7u);
+    EXPECT_EQ(inputs[1].priority, EventPriority::EMERGENCY);
+
+    std::istringstream bad("1,PUBLISH,NOT_AN_EVENT,UNKNOWN,NORMAL,1,\n");
+    std::string error;
+    inputs.clear();
+    EXPECT_FALSE(TraceReplay::loadCsv(bad, inputs, &error));
+    EXPECT_NE(error.find("line 1"), std::string::npos);
+    EXPECT_NE(error.find("NOT_AN_EVENT"), std::string::npos);
+}
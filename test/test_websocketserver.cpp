@@ -1 +1,217 @@
-// Test doc
\ No newline at end of file
+#ifdef UNIT_TEST
+unsigned long mock_millis = 0;
+#endif
+
+#include <gtest/gtest.h>
+#include <ArduinoJson.h>
+#include <string>
+#include <vector>
+#include <ESPAsyncWebServer.h>
+#include "CommandBus.h"
+#include "DetectionSystem.h"
+#include "EventBus.h"
+#include "Logger.h"
+#include "StateWriter.h"
+#include "WebSocketServer.h"
+
+namespace {
+
+// The server wired as in setup(), started on the native WiFi, with one loopback client
+// whose frames are kept in arrival order
+struct LoopbackFixture {
+    EventBus bus;
+    StateWriter state{bus};
+    CommandBus commandBus;
+    DetectionSystem detection{bus};
+    WebSocketServer server{80, state, commandBus, bus, detection};
+    AsyncWebSocket* ws = nullptr;
+    uint32_t client = 0;
+    std::vector<std::string> frames;
+
+    LoopbackFixture() {
+        Logger::setLevel(Logger::Level::WARN);
+        mock_millis = 1000;
+        state.beginSubscriptions();
+        server.beginSubscriptions();
+        bus.seal();
+
+        // The native WiFi connects on the first attempt; the next loop starts the server
+        server.configureWiFi("test", "test");
+        server.networkLoop();
+        server.networkLoop();
+        ws = AsyncWebSocket::find("/ws");
+        if (ws) {
+            client = ws->connectClient([this](uint32_t, bool binary, const uint8_t* data, size_t len) {
+                if (!binary) frames.emplace_back(reinterpret_cast<const char*>(data), len);
+            });
+        }
+    }
+
+    ~LoopbackFixture() {
+        if (ws) ws->disconnectClient(client);
+    }
+
+    void event(BridgeEvent ev) {
+        bus.emplace<SimpleEventData>(ev);
+        bus.processEvents();
+    }
+
+    // Frames with this path received so far
+    size_t count(const char* path) const {
+        size_t n = 0;
+        for (const std::string& frame : frames) {
+            DynamicJsonDocument doc(4096);
+            if (!deserializeJson(doc, frame) && std::string(doc["path"] | "") == path) n++;
+        }
+        return n;
+    }
+
+    // Sends one GET and parses the response it gets back into doc
+    bool get(const char* path, JsonDocument& doc) {
+        const size_t before = frames.size();
+        const String request = String("{\"v\":1,\"id\":\"t\",\"type\":\"request\",\"method\":\"GET\",\"path\":\"") +
+                               path + "\"}";
+        ws->receiveText(client, request);
+        if (frames.size() != before + 1) return false;
+        return !deserializeJson(doc, frames.back());
+    }
+};
+
+}  // namespace
+
+// Test: changes inside one broadcast interval leave as a single patch, and /system/metrics
+// reports the same sent/suppressed counts as the coalescer
+TEST(WebSocketServerBroadcastTest, MarksInsideOneIntervalSendOnce) {
+    LoopbackFixture f;
+    ASSERT_NE(f.ws, nullptr);
+    f.server.setBroadcastIntervalMs(50);
+    ASSERT_EQ(f.count("/system/snapshot"), 1u);  // On connect
+
+    // The first change after a quiet period goes out at once
+    f.event(BridgeEvent::BOAT_DETECTED_LEFT);
+    f.server.networkLoop();
+    EXPECT_EQ(f.count("/system/patch"), 1u);
+
+    // Five more inside the interval are held...
+    mock_millis = 1010;
+    f.event(BridgeEvent::TRAFFIC_STOPPED_SUCCESS);
+    f.event(BridgeEvent::BRIDGE_OPENED_SUCCESS);
+    f.event(BridgeEvent::BOAT_PASSED);
+    f.event(BridgeEvent::BRIDGE_CLOSED_SUCCESS);
+    f.event(BridgeEvent::TRAFFIC_RESUMED_SUCCESS);
+    f.server.networkLoop();
+    mock_millis = 1049;
+    f.server.networkLoop();
+    EXPECT_EQ(f.count("/system/patch"), 1u);
+
+    // ...and leave together once it has passed
+    mock_millis = 1050;
+    f.server.networkLoop();
+    f.server.networkLoop();
+    ASSERT_EQ(f.count("/system/patch"), 2u);
+    DynamicJsonDocument patch(4096);
+    ASSERT_FALSE(deserializeJson(patch, f.frames.back()));
+    EXPECT_EQ(patch["payload"]["seq"].as<uint32_t>(), f.state.version());
+    EXPECT_EQ(patch["payload"]["log"].size(), 5u);
+
+    const SnapshotCoalescer::Stats stats = f.server.broadcastStats();
+    EXPECT_EQ(stats.marked, 6u);
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.suppressed, 4u);
+
+    DynamicJsonDocument metrics(4096);
+    ASSERT_TRUE(f.get("/system/metrics", metrics));
+    ASSERT_TRUE(metrics["ok"].as<bool>());
+    JsonObject broadcast = metrics["payload"]["broadcast"].as<JsonObject>();
+    EXPECT_EQ(broadcast["intervalMs"].as<uint32_t>(), 50u);
+    EXPECT_EQ(broadcast["marked"].as<uint32_t>(), stats.marked);
+    EXPECT_EQ(broadcast["sent"].as<uint32_t>(), stats.sent);
+    EXPECT_EQ(broadcast["suppressed"].as<uint32_t>(), stats.suppressed);
+    EXPECT_EQ(broadcast["patches"].as<uint32_t>(), 2u);
+    EXPECT_EQ(broadcast["snapshots"].as<uint32_t>(), 1u);
+}
+
+// Test: the status GETs splice StateWriter's cached JSON into the response envelope; the
+// frame must parse, and its payload must be exactly the cached section
+TEST(WebSocketServerGetTest, CachedPayloadsSpliceIntoValidEnvelope) {
+    LoopbackFixture f;
+    ASSERT_NE(f.ws, nullptr);
+    f.event(BridgeEvent::BOAT_DETECTED_LEFT);
+    f.bus.emplace<LightChangeData>(String("both"), String("Red"), true);
+    f.bus.processEvents();
+
+    struct Route {
+        const char* path;
+        String (StateWriter::*json)() const;
+    };
+    const Route routes[] = {
+        {"/bridge/status", &StateWriter::bridgeStatusJson},
+        {"/traffic/car/status", &StateWriter::carTrafficStatusJson},
+        {"/traffic/boat/status", &StateWriter::boatTrafficStatusJson},
+        {"/system/status", &StateWriter::systemStatusJson},
+        {"/system/snapshot", &StateWriter::snapshotPayloadJson},
+    };
+    for (const Route& route : routes) {
+        SCOPED_TRACE(route.path);
+        DynamicJsonDocument doc(4096);
+        ASSERT_TRUE(f.get(route.path, doc));  // Parses as a whole
+        EXPECT_EQ(doc["v"].as<int>(), 1);
+        EXPECT_STREQ(doc["id"].as<const char*>(), "t");
+        EXPECT_STREQ(doc["type"].as<const char*>(), "response");
+        EXPECT_TRUE(doc["ok"].as<bool>());
+        EXPECT_STREQ(doc["path"].as<const char*>(), route.path);
+        ASSERT_TRUE(doc["payload"].is<JsonObject>());
+
+        String payload;
+        serializeJson(doc["payload"], payload);
+        EXPECT_EQ(payload, (f.state.*route.json)());
+    }
+}
+
+// Test: /system/log takes only "?since=<seq>"; anything else is refused, not read as seq 0
+TEST(WebSocketServerGetTest, LogQueryIsValidated) {
+    LoopbackFixture f;
+    ASSERT_NE(f.ws, nullptr);
+    for (int i = 0; i < 3; ++i) f.event(BridgeEvent::BOAT_DETECTED);
+
+    for (const char* path : {"/system/log?since=abc", "/system/log?since=", "/system/log?since=1x",
+                             "/system/log?from=1", "/system/log?since=4294967295"}) {
+        SCOPED_TRACE(path);
+        DynamicJsonDocument doc(1024);
+        ASSERT_TRUE(f.get(path, doc));
+        EXPECT_FALSE(doc["ok"].as<bool>());
+        EXPECT_STREQ(doc["path"].as<const char*>(), path);
+        EXPECT_STREQ(doc["error"].as<const char*>(), "Invalid log query");
+    }
+
+    DynamicJsonDocument doc(4096);
+    ASSERT_TRUE(f.get("/system/log?since=0", doc));
+    ASSERT_TRUE(doc["ok"].as<bool>());
+    ASSERT_EQ(doc["payload"]["lines"].size(), 2u);
+    EXPECT_EQ(doc["payload"]["lines"][0]["seq"].as<uint32_t>(), 1u);
+
+    doc.clear();
+    ASSERT_TRUE(f.get("/system/log", doc));
+    EXPECT_EQ(doc["payload"]["lines"].size(), 3u);
+    EXPECT_EQ(doc["payload"]["since"].as<int>(), -1);
+}
+
+// Test: replies to one client are sent as their own String, not from a socket buffer - the
+// socket only frees its buffers on a broadcast, so a polling UI on a quiet bridge would
+// otherwise hold one per reply
+TEST(WebSocketServerGetTest, RepliesHoldNoSocketBuffers) {
+    LoopbackFixture f;
+    ASSERT_NE(f.ws, nullptr);
+    const size_t held = f.ws->bufferCount();
+
+    constexpr int REPLIES = 50;
+    for (int i = 0; i < REPLIES; ++i) {
+        DynamicJsonDocument doc(4096);
+        ASSERT_TRUE(f.get((i % 2) ? "/system/ping" : "/bridge/status", doc));
+        ASSERT_TRUE(doc["ok"].as<bool>());
+    }
+    f.ws->receiveText(f.client, "{\"v\":1,\"id\":\"s\",\"type\":\"request\",\"method\":\"SET\","
+                                "\"path\":\"/traffic/boat/light\",\"payload\":{\"side\":\"left\",\"value\":\"Green\"}}");
+    EXPECT_EQ(f.frames.size(), 1u + REPLIES + 1u);  // Snapshot on connect, the replies, the SET ack
+    EXPECT_EQ(f.ws->bufferCount(), held);
+}
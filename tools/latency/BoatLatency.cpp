@@ -0,0 +1,436 @@
+#include "BoatLatency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "BridgeSystemDefs.h"
+#include "BridgeStateMachine.h"
+#include "CommandBus.h"
+#include "Controller.h"
+#include "DetectionSystem.h"
+#include "LocalStateIndicator.h"
+#include "Logger.h"
+#include "MotorControl.h"
+#include "NativeHal.h"
+#include "SignalControl.h"
+#include "VirtualClock.h"
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr uint8_t BEAM_BREAK_RECEIVER_PIN = 35;  // HIGH = beam clear
+constexpr size_t MAX_SAMPLES_PER_BOAT = 400;
+// Generous bound on STOP_TRAFFIC -> RAISE_BRIDGE (the stop sequence is 12 s)
+constexpr uint32_t RAISE_WINDOW_MS = 30000;
+// Rest of the cycle: span travel each way, the boat under the span, then back to IDLE
+constexpr uint32_t SPAN_TRAVEL_MS = 8000;
+constexpr uint32_t PASSAGE_START_MS = 5000;  // After BRIDGE_OPENED, beam broken until...
+constexpr uint32_t PASSAGE_END_MS = 8000;
+constexpr uint32_t CYCLE_LIMIT_MS = 180000;
+
+double usBetween(SteadyClock::time_point from, SteadyClock::time_point to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+// EventBus that timestamps the two publishes the harness follows
+class ProbeBus : public EventBus {
+public:
+    bool detected = false;
+    SteadyClock::time_point detectedAt;
+    uint32_t detectedMs = 0;
+
+    bool stopped = false;
+    SteadyClock::time_point stoppedAt;
+    uint32_t stoppedMs = 0;
+
+    void arm() {
+        detected = false;
+        stopped = false;
+    }
+
+    void publishPayload(BridgeEvent eventType, EventPayload&& payload, EventPriority priority) override {
+        if (!detected && (eventType == BridgeEvent::BOAT_DETECTED_LEFT || eventType == BridgeEvent::BOAT_DETECTED_RIGHT)) {
+            detectedAt = SteadyClock::now();
+            detectedMs = Clock::millis();
+            detected = true;
+        } else if (!stopped && eventType == BridgeEvent::TRAFFIC_STOPPED_SUCCESS) {
+            stoppedAt = SteadyClock::now();
+            stoppedMs = Clock::millis();
+            stopped = true;
+        }
+        EventBus::publishPayload(eventType, std::move(payload), priority);
+    }
+};
+
+// The control core as main.cpp wires it, plus probes at each hop
+struct Rig {
+    enum class Awaiting { NOTHING, SIGNAL_OUTPUT, MOTOR_OUTPUT };
+
+    ProbeBus bus;
+    CommandBus commandBus;
+    MotorControl motor{bus};
+    SignalControl signals{bus};
+    LocalStateIndicator indicator{bus};
+    Controller controller{bus, commandBus, motor, signals, indicator};
+    BridgeStateMachine fsm{bus, commandBus};
+    DetectionSystem detection{bus};
+
+    Awaiting awaiting = Awaiting::NOTHING;
+    SteadyClock::time_point detectDispatchAt, stopCommandAt, signalOutputAt;
+    SteadyClock::time_point stoppedDispatchAt, raiseCommandAt, motorOutputAt;
+    uint32_t stopCommandMs = 0;
+    bool stopCommanded = false;
+    bool signalReached = false;
+    bool raiseCommanded = false;
+    bool motorReached = false;
+
+    Rig() {
+        NativeHal::reset();
+        NativeHal::setDigitalInput(BEAM_BREAK_RECEIVER_PIN, HIGH);
+        NativeHal::setOutputObserver(&Rig::onOutput, this);
+        motor.setSimulationMode(true);  // The harness ends span travel with simulateLimitSwitchPress()
+
+        // Per-event subscribers run before BridgeStateMachine's mask subscription, so these
+        // mark the moment dispatch reaches it
+        bus.subscribe(BridgeEvent::BOAT_DETECTED_LEFT, [r = this](EventData*) { r->onDetectDispatch(); });
+        bus.subscribe(BridgeEvent::BOAT_DETECTED_RIGHT, [r = this](EventData*) { r->onDetectDispatch(); });
+        bus.subscribe(BridgeEvent::TRAFFIC_STOPPED_SUCCESS, [r = this](EventData*) {
+            r->stoppedDispatchAt = SteadyClock::now();
+        });
+        // Registered before Controller::begin(), so the CommandBus calls these first
+        commandBus.subscribe(CommandTarget::SIGNAL_CONTROL, [r = this](const Command& command) {
+            if (command.action == CommandAction::STOP_TRAFFIC && !r->stopCommanded) {
+                r->stopCommanded = true;
+                r->stopCommandMs = Clock::millis();
+                r->awaiting = Awaiting::SIGNAL_OUTPUT;
+                r->stopCommandAt = SteadyClock::now();
+            }
+        });
+        commandBus.subscribe(CommandTarget::MOTOR_CONTROL, [r = this](const Command& command) {
+            if (command.action == CommandAction::RAISE_BRIDGE && !r->raiseCommanded) {
+                r->raiseCommanded = true;
+                r->awaiting = Awaiting::MOTOR_OUTPUT;
+                r->raiseCommandAt = SteadyClock::now();
+            }
+        });
+
+        // setup() order
+        motor.init();
+        signals.begin();
+        controller.begin();
+        fsm.begin();
+        detection.begin();
+        indicator.begin();
+        bus.seal();
+        commandBus.seal();
+        VirtualClock::drain(bus);
+    }
+
+    ~Rig() {
+        NativeHal::setOutputObserver(nullptr, nullptr);
+    }
+
+    // Clears the probes for the next boat
+    void arm() {
+        bus.arm();
+        awaiting = Awaiting::NOTHING;
+        detectDispatchAt = SteadyClock::time_point();
+        stopCommandMs = 0;
+        stopCommanded = signalReached = raiseCommanded = motorReached = false;
+    }
+
+    void onDetectDispatch() {
+        if (detectDispatchAt == SteadyClock::time_point()) {
+            detectDispatchAt = SteadyClock::now();
+        }
+    }
+
+    // First GPIO write after a command is the module acting on it
+    static void onOutput(void* context, uint8_t, int) {
+        Rig* r = static_cast<Rig*>(context);
+        if (r->awaiting == Awaiting::SIGNAL_OUTPUT) {
+            r->signalOutputAt = SteadyClock::now();
+            r->signalReached = true;
+        } else if (r->awaiting == Awaiting::MOTOR_OUTPUT) {
+            r->motorOutputAt = SteadyClock::now();
+            r->motorReached = true;
+        } else {
+            return;
+        }
+        r->awaiting = Awaiting::NOTHING;
+    }
+};
+
+// A boat coming straight at one sensor and holding short of it
+struct Profile {
+    bool left;
+    float startCm;     // Out of range (beyond the far zone)
+    float stepCm;      // Closing per sample
+    float stopCm;      // Where it holds, inside DETECT_THRESHOLD_CM
+    uint32_t phaseMs;  // Offset of the first sample
+};
+
+Profile randomProfile(std::mt19937& rng) {
+    std::uniform_real_distribution<float> start(35.0f, 45.0f);
+    std::uniform_real_distribution<float> speedCmPerS(15.0f, 60.0f);
+    std::uniform_real_distribution<float> stop(3.0f, 8.0f);
+    std::uniform_int_distribution<uint32_t> phase(0, DetectionSystem::SAMPLE_INTERVAL_MS - 1);
+    Profile p;
+    p.left = (rng() & 1u) != 0;
+    p.startCm = start(rng);
+    p.stepCm = speedCmPerS(rng) * DetectionSystem::SAMPLE_INTERVAL_MS / 1000.0f;
+    p.stopCm = stop(rng);
+    p.phaseMs = phase(rng);
+    return p;
+}
+
+// Drives the rest of the cycle - span travel, the boat passing under the span (beam break),
+// the close and the cooldown - so the next boat meets an idle bridge. Ticks at the sample
+// interval, as the sensor and motor tasks poll.
+bool finishCycle(VirtualClock& clock, Rig& rig) {
+    const uint64_t startMs = clock.nowMs();
+    uint64_t motorStartMs = 0;
+    uint64_t openedMs = 0;
+    bool motorWasRunning = false;
+
+    for (uint64_t now = startMs; now < startMs + CYCLE_LIMIT_MS; now += DetectionSystem::SAMPLE_INTERVAL_MS) {
+        clock.runUntil(rig.bus, now);
+
+        const bool motorRunning = rig.motor.isMotorRunning();
+        if (motorRunning && !motorWasRunning) {
+            motorStartMs = now;
+        }
+        motorWasRunning = motorRunning;
+        if (motorRunning && now - motorStartMs >= SPAN_TRAVEL_MS) {
+            rig.motor.simulateLimitSwitchPress();
+        }
+        rig.motor.checkProgress();
+
+        const BridgeState state = rig.fsm.getCurrentState();
+        if (state == BridgeState::OPEN && openedMs == 0) {
+            openedMs = now;
+        }
+        const bool beamBroken = openedMs != 0 && now >= openedMs + PASSAGE_START_MS && now < openedMs + PASSAGE_END_MS;
+        NativeHal::setDigitalInput(BEAM_BREAK_RECEIVER_PIN, beamBroken ? LOW : HIGH);
+        rig.detection.processSample(-1.0f, -1.0f);
+        rig.bus.processEvents();
+
+        if (openedMs != 0 && rig.fsm.getCurrentState() == BridgeState::IDLE) {
+            // Back to IDLE; detections are deferred until the cooldown is over
+            clock.runUntil(rig.bus, now + BOAT_CYCLE_COOLDOWN_MS + DetectionSystem::SAMPLE_INTERVAL_MS);
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Summary {
+    size_t count = 0;
+    double mean = 0, p50 = 0, p90 = 0, p99 = 0, min = 0, max = 0;
+};
+
+Summary summarise(std::vector<double> values) {
+    Summary s;
+    s.count = values.size();
+    if (values.empty()) {
+        return s;
+    }
+    std::sort(values.begin(), values.end());
+    double total = 0;
+    for (double v : values) {
+        total += v;
+    }
+    // Nearest-rank percentiles
+    auto rank = [&values](double q) {
+        size_t index = static_cast<size_t>(q * values.size() + 0.999999);
+        return values[index == 0 ? 0 : std::min(index, values.size()) - 1];
+    };
+    s.mean = total / values.size();
+    s.p50 = rank(0.50);
+    s.p90 = rank(0.90);
+    s.p99 = rank(0.99);
+    s.min = values.front();
+    s.max = values.back();
+    return s;
+}
+
+template <typename Field>
+std::vector<double> collect(const std::vector<BoatLatencySample>& samples, Field field) {
+    std::vector<double> values;
+    values.reserve(samples.size());
+    for (const BoatLatencySample& s : samples) {
+        values.push_back(field(s));
+    }
+    return values;
+}
+
+struct Hop {
+    const char* key;    // JSON name
+    const char* label;  // Table row
+    std::vector<double> values;
+};
+
+std::vector<Hop> hops(const std::vector<BoatLatencySample>& samples) {
+    using S = BoatLatencySample;
+    return {
+        {"detect", "DetectionSystem sample -> publish", collect(samples, [](const S& s) { return s.detectUs; })},
+        {"dispatch", "EventBus publish -> FSM", collect(samples, [](const S& s) { return s.dispatchUs; })},
+        {"stateMachine", "FSM -> CommandBus STOP_TRAFFIC", collect(samples, [](const S& s) { return s.stateMachineUs; })},
+        {"controller", "Controller -> SignalControl GPIO", collect(samples, [](const S& s) { return s.controllerUs; })},
+        {"stopSoftware", "  stop path software", collect(samples, [](const S& s) { return s.stopSoftwareUs(); })},
+        {"raiseDispatch", "EventBus publish -> FSM", collect(samples, [](const S& s) { return s.raiseDispatchUs; })},
+        {"raiseStateMachine", "FSM -> CommandBus RAISE_BRIDGE", collect(samples, [](const S& s) { return s.raiseStateMachineUs; })},
+        {"raiseController", "Controller -> MotorControl GPIO", collect(samples, [](const S& s) { return s.raiseControllerUs; })},
+        {"raiseSoftware", "  raise path software", collect(samples, [](const S& s) { return s.raiseSoftwareUs(); })},
+        {"software", "software total", collect(samples, [](const S& s) { return s.softwareUs(); })},
+    };
+}
+
+std::vector<double> endToEndMs(const std::vector<BoatLatencySample>& samples) {
+    return collect(samples, [](const BoatLatencySample& s) {
+        return s.debounceMs + s.signalSequenceMs + s.softwareUs() / 1000.0;
+    });
+}
+
+}  // namespace
+
+std::vector<BoatLatencySample> BoatLatency::run() {
+    return run(Options());
+}
+
+std::vector<BoatLatencySample> BoatLatency::run(const Options& options) {
+    const auto wallStart = SteadyClock::now();
+    const Logger::Level previousLevel = Logger::getLevel();
+    if (options.quiet) {
+        Logger::setLevel(Logger::Level::NONE);
+    }
+
+    stats_ = Stats();
+    std::vector<BoatLatencySample> samples;
+    samples.reserve(options.boats);
+    std::mt19937 rng(options.seed);
+    VirtualClock clock;
+    Clock* const previousClock = Clock::install(&clock);
+
+    Rig rig;
+
+    for (size_t boat = 0; boat < options.boats; ++boat) {
+        const Profile profile = randomProfile(rng);
+        std::normal_distribution<float> noiseCm(0.0f, 0.3f);
+        rig.arm();
+
+        // Leg 1: approach, debounce, STOP_TRAFFIC
+        const uint64_t startMs = clock.nowMs() + profile.phaseMs;
+        uint32_t crossingMs = 0;
+        bool crossed = false;
+        SteadyClock::time_point sampleAt;
+        for (size_t k = 0; k < MAX_SAMPLES_PER_BOAT && !rig.bus.detected; ++k) {
+            clock.runUntil(rig.bus, startMs + k * DetectionSystem::SAMPLE_INTERVAL_MS);
+            const float distanceCm =
+                std::max(profile.stopCm, profile.startCm - profile.stepCm * k) + noiseCm(rng);
+
+            sampleAt = SteadyClock::now();
+            rig.detection.processSample(profile.left ? distanceCm : -1.0f, profile.left ? -1.0f : distanceCm);
+            rig.bus.processEvents();  // The publish wakes the control task straight away
+
+            const float filteredCm = profile.left ? rig.detection.getLeftFilteredDistanceCm()
+                                                  : rig.detection.getRightFilteredDistanceCm();
+            if (!crossed && filteredCm > 0 && filteredCm <= DetectionSystem::DETECT_THRESHOLD_CM) {
+                crossed = true;
+                crossingMs = Clock::millis();
+            }
+        }
+
+        // Leg 2: the stop sequence runs on its timers, then RAISE_BRIDGE
+        if (rig.signalReached) {
+            clock.runUntil(rig.bus, rig.stopCommandMs + RAISE_WINDOW_MS);
+        }
+        const bool reached = crossed && rig.signalReached && rig.motorReached;
+        if (!finishCycle(clock, rig)) {
+            // Stuck mid-cycle (FAULT or lost event): put the system back to IDLE for the next boat
+            stats_.failed++;
+            rig.motor.halt();
+            rig.bus.emplace<SimpleEventData>(BridgeEvent::SYSTEM_RESET_REQUESTED);
+            clock.runUntil(rig.bus, clock.nowMs() + BOAT_CYCLE_COOLDOWN_MS + DetectionSystem::SAMPLE_INTERVAL_MS);
+            continue;
+        }
+        if (!reached) {
+            stats_.failed++;
+            continue;
+        }
+
+        BoatLatencySample s;
+        s.debounceMs = rig.bus.detectedMs - crossingMs;
+        s.detectUs = usBetween(sampleAt, rig.bus.detectedAt);
+        s.dispatchUs = usBetween(rig.bus.detectedAt, rig.detectDispatchAt);
+        s.stateMachineUs = usBetween(rig.detectDispatchAt, rig.stopCommandAt);
+        s.controllerUs = usBetween(rig.stopCommandAt, rig.signalOutputAt);
+        s.signalSequenceMs = rig.bus.stoppedMs - rig.stopCommandMs;
+        s.raiseDispatchUs = usBetween(rig.bus.stoppedAt, rig.stoppedDispatchAt);
+        s.raiseStateMachineUs = usBetween(rig.stoppedDispatchAt, rig.raiseCommandAt);
+        s.raiseControllerUs = usBetween(rig.raiseCommandAt, rig.motorOutputAt);
+        samples.push_back(s);
+    }
+
+    stats_.boats = options.boats;
+    stats_.seed = options.seed;
+    stats_.virtualMs = clock.nowMs();
+    Clock::install(previousClock);
+    Logger::setLevel(previousLevel);
+    stats_.wallMs = std::chrono::duration<double, std::milli>(SteadyClock::now() - wallStart).count();
+    return samples;
+}
+
+void BoatLatency::printReport(const std::vector<BoatLatencySample>& samples, const Stats& stats, FILE* out) {
+    std::fprintf(out, "Boat-to-barrier latency: %u boats (seed %u, %u failed), %.1f s virtual in %.1f ms\n\n",
+                 static_cast<unsigned int>(stats.boats), static_cast<unsigned int>(stats.seed),
+                 static_cast<unsigned int>(stats.failed), stats.virtualMs / 1000.0, stats.wallMs);
+
+    std::fprintf(out, "%-36s %8s %9s %9s %9s %9s %9s\n", "software hop (us)", "count", "mean", "p50", "p90", "p99", "max");
+    for (const Hop& hop : hops(samples)) {
+        const Summary s = summarise(hop.values);
+        std::fprintf(out, "%-36s %8u %9.2f %9.2f %9.2f %9.2f %9.2f\n", hop.label, static_cast<unsigned int>(s.count),
+                     s.mean, s.p50, s.p90, s.p99, s.max);
+    }
+
+    const Summary debounce = summarise(collect(samples, [](const BoatLatencySample& s) { return double(s.debounceMs); }));
+    const Summary sequence =
+        summarise(collect(samples, [](const BoatLatencySample& s) { return double(s.signalSequenceMs); }));
+    const Summary total = summarise(endToEndMs(samples));
+    std::fprintf(out, "\nfixed waits (ms, virtual)\n");
+    std::fprintf(out, "  debounce          min %.0f  p50 %.0f  max %.0f  (DETECT_HOLD_MS %lu, sampled every %lu ms)\n",
+                 debounce.min, debounce.p50, debounce.max, DetectionSystem::DETECT_HOLD_MS,
+                 DetectionSystem::SAMPLE_INTERVAL_MS);
+    std::fprintf(out, "  stop sequence     min %.0f  p50 %.0f  max %.0f\n", sequence.min, sequence.p50, sequence.max);
+    std::fprintf(out, "end-to-end (ms)     p50 %.3f  p99 %.3f  max %.3f  (crossing -> motor GPIO)\n",
+                 total.p50, total.p99, total.max);
+}
+
+void BoatLatency::printJson(const std::vector<BoatLatencySample>& samples, const Stats& stats, FILE* out) {
+    auto summaryJson = [out](const Summary& s, const char* unit) {
+        std::fprintf(out, "{\"count\": %u, \"mean%s\": %.3f, \"p50%s\": %.3f, \"p90%s\": %.3f, \"p99%s\": %.3f, "
+                          "\"min%s\": %.3f, \"max%s\": %.3f}",
+                     static_cast<unsigned int>(s.count), unit, s.mean, unit, s.p50, unit, s.p90, unit, s.p99, unit,
+                     s.min, unit, s.max);
+    };
+
+    std::fprintf(out, "{\n  \"boats\": %u,\n  \"seed\": %u,\n  \"failed\": %u,\n  \"virtualMs\": %llu,\n  \"wallMs\": %.3f,\n",
+                 static_cast<unsigned int>(stats.boats), static_cast<unsigned int>(stats.seed),
+                 static_cast<unsigned int>(stats.failed), static_cast<unsigned long long>(stats.virtualMs),
+                 stats.wallMs);
+    std::fprintf(out, "  \"hops\": {\n");
+    const std::vector<Hop> all = hops(samples);
+    for (size_t i = 0; i < all.size(); ++i) {
+        std::fprintf(out, "    \"%s\": ", all[i].key);
+        summaryJson(summarise(all[i].values), "Us");
+        std::fprintf(out, "%s\n", i + 1 < all.size() ? "," : "");
+    }
+    std::fprintf(out, "  },\n  \"fixed\": {\n    \"detectHoldMs\": %lu,\n    \"debounce\": ", DetectionSystem::DETECT_HOLD_MS);
+    summaryJson(summarise(collect(samples, [](const BoatLatencySample& s) { return double(s.debounceMs); })), "Ms");
+    std::fprintf(out, ",\n    \"stopSequence\": ");
+    summaryJson(summarise(collect(samples, [](const BoatLatencySample& s) { return double(s.signalSequenceMs); })), "Ms");
+    std::fprintf(out, "\n  },\n  \"endToEnd\": ");
+    summaryJson(summarise(endToEndMs(samples)), "Ms");
+    std::fprintf(out, "\n}\n");
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Host-only (UNIT_TEST) end-to-end latency harness: ultrasonic threshold crossing ->
+// STOP_TRAFFIC at SignalControl -> RAISE_BRIDGE at MotorControl, for many simulated boats
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// One boat's path through the control core
+//
+// The fixed waits are designed in and run on the VirtualClock (ms): the detection debounce
+// (DetectionSystem::DETECT_HOLD_MS, quantised to the sample interval) and SignalControl's
+// yellow + red stop sequence. The hops between them are software latency, measured in
+// host time (us) around the real modules:
+//
+//   detectUs        sample handed to DetectionSystem -> BOAT_DETECTED_<side> published
+//   dispatchUs      publish -> EventBus dispatch reaches BridgeStateMachine
+//   stateMachineUs  BridgeStateMachine -> STOP_TRAFFIC dispatched by the CommandBus
+//   controllerUs    Controller -> SignalControl drives its first GPIO
+//
+// and the same three bus hops again from TRAFFIC_STOPPED_SUCCESS to MotorControl's first
+// GPIO write for RAISE_BRIDGE.
+struct BoatLatencySample {
+    uint32_t debounceMs;        // Sample that crossed DETECT_THRESHOLD_CM -> sample that published
+    double detectUs;
+    double dispatchUs;
+    double stateMachineUs;
+    double controllerUs;
+
+    uint32_t signalSequenceMs;  // STOP_TRAFFIC -> TRAFFIC_STOPPED_SUCCESS
+    double raiseDispatchUs;
+    double raiseStateMachineUs;
+    double raiseControllerUs;
+
+    double stopSoftwareUs() const { return detectUs + dispatchUs + stateMachineUs + controllerUs; }
+    double raiseSoftwareUs() const { return raiseDispatchUs + raiseStateMachineUs + raiseControllerUs; }
+    double softwareUs() const { return stopSoftwareUs() + raiseSoftwareUs(); }
+};
+
+/**
+ * BoatLatency - drives synthetic boats through DetectionSystem, EventBus, BridgeStateMachine,
+ * CommandBus, Controller, SignalControl and MotorControl on a VirtualClock
+ *
+ * The boats share one system, run back to back: each gets a seeded random distance profile
+ * (a random side, approach speed and stopping distance, with sensor noise), and after the
+ * measured legs the harness finishes its cycle - span travel via the simulated limit switch,
+ * passage via the beam break, the close and the cooldown - so the next boat meets an idle
+ * bridge, as on the canal. The profile is
+ * fed to DetectionSystem::processSample() every SAMPLE_INTERVAL_MS and the bus is
+ * processed straight after, as the control task does when a publish wakes it. GPIO writes
+ * are observed through the native HAL. The network-core subscribers (StateWriter,
+ * WebSocketServer) are not part of the rig.
+ *
+ * Software hops include the harness's own probes (one steady_clock read each).
+ */
+class BoatLatency {
+public:
+    struct Options {
+        size_t boats = 10000;
+        uint32_t seed = 1;
+        bool quiet = true;  // Silence the Logger during the run
+    };
+
+    struct Stats {
+        size_t boats = 0;
+        uint32_t seed = 0;
+        size_t failed = 0;  // Boats whose command never reached the hardware, or whose cycle stuck
+        uint64_t virtualMs = 0;
+        double wallMs = 0.0;
+    };
+
+    std::vector<BoatLatencySample> run();
+    std::vector<BoatLatencySample> run(const Options& options);
+
+    const Stats& lastStats() const { return stats_; }
+
+    // Per-hop distributions (count, mean, p50, p90, p99, max) as a table or as JSON
+    static void printReport(const std::vector<BoatLatencySample>& samples, const Stats& stats, FILE* out);
+    static void printJson(const std::vector<BoatLatencySample>& samples, const Stats& stats, FILE* out);
+
+private:
+    Stats stats_;
+};
@@ -0,0 +1,222 @@
+#include "TraceReplay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include "BridgeStateMachine.h"
+#include "CommandBus.h"
+#include "Logger.h"
+#include "VirtualClock.h"
+
+namespace {
+
+std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        fields.push_back(field);
+    }
+    if (!line.empty() && line.back() == ',') {
+        fields.emplace_back();  // Trailing empty column (duration_us of non-DISPATCH rows)
+    }
+    return fields;
+}
+
+bool parseEvent(const std::string& name, BridgeEvent& out) {
+    for (size_t i = 0; i < BRIDGE_EVENT_COUNT; ++i) {
+        if (name == bridgeEventToString(static_cast<BridgeEvent>(i))) {
+            out = static_cast<BridgeEvent>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSide(const std::string& name, BoatEventSide& out) {
+    if (name == "LEFT") { out = BoatEventSide::LEFT; return true; }
+    if (name == "RIGHT") { out = BoatEventSide::RIGHT; return true; }
+    if (name == "UNKNOWN" || name.empty()) { out = BoatEventSide::UNKNOWN; return true; }
+    return false;
+}
+
+bool parsePriority(const std::string& name, EventPriority& out) {
+    if (name == "NORMAL") { out = EventPriority::NORMAL; return true; }
+    if (name == "EMERGENCY") { out = EventPriority::EMERGENCY; return true; }
+    return false;
+}
+
+bool fail(std::string* error, size_t lineNumber, const std::string& what) {
+    if (error) {
+        *error = "line " + std::to_string(lineNumber) + ": " + what;
+    }
+    return false;
+}
+
+}  // namespace
+
+bool TraceReplay::isStateMachineOutput(BridgeEvent event) {
+    return event == BridgeEvent::STATE_CHANGED || event == BridgeEvent::BOAT_PASSAGE_TIMEOUT;
+}
+
+bool TraceReplay::loadCsv(std::istream& in, std::vector<ReplayInput>& out, std::string* error) {
+    std::string line;
+    size_t lineNumber = 0;
+    bool haveFirst = false;
+    uint64_t firstUs = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#' || line.rfind("timestamp_us", 0) == 0) {
+            continue;  // Blank, comment or header
+        }
+
+        const std::vector<std::string> fields = splitCsv(line);
+        if (fields.size() < 5) {
+            return fail(error, lineNumber, "expected timestamp_us,kind,event,side,priority");
+        }
+        if (fields[1] != "PUBLISH" && fields[1] != "PUBLISH_REMOTE") {
+            continue;  // DISPATCH and DROP rows are outcomes, not inputs
+        }
+
+        char* end = nullptr;
+        const uint64_t timestampUs = std::strtoull(fields[0].c_str(), &end, 10);
+        if (end == fields[0].c_str() || *end != '\0') {
+            return fail(error, lineNumber, "bad timestamp '" + fields[0] + "'");
+        }
+        ReplayInput input;
+        if (!parseEvent(fields[2], input.event)) {
+            return fail(error, lineNumber, "unknown event '" + fields[2] + "'");
+        }
+        if (!parseSide(fields[3], input.side)) {
+            return fail(error, lineNumber, "unknown side '" + fields[3] + "'");
+        }
+        if (!parsePriority(fields[4], input.priority)) {
+            return fail(error, lineNumber, "unknown priority '" + fields[4] + "'");
+        }
+        if (isStateMachineOutput(input.event)) {
+            continue;
+        }
+
+        if (!haveFirst) {
+            firstUs = timestampUs;
+            haveFirst = true;
+        }
+        input.timeMs = timestampUs > firstUs ? static_cast<uint32_t>((timestampUs - firstUs) / 1000) : 0;
+        out.push_back(input);
+    }
+    return true;
+}
+
+std::vector<ReplayOutput> TraceReplay::run(const std::vector<ReplayInput>& inputs) {
+    return run(inputs, Options());
+}
+
+std::vector<ReplayOutput> TraceReplay::run(const std::vector<ReplayInput>& inputs, const Options& options) {
+    const auto wallStart = std::chrono::steady_clock::now();
+    const Logger::Level previousLevel = Logger::getLevel();
+    if (options.quiet) {
+        Logger::setLevel(Logger::Level::NONE);
+    }
+
+    std::vector<ReplayOutput> outputs;
+    VirtualClock clock;
+    Clock* const previousClock = Clock::install(&clock);
+    {
+        EventBus bus;
+        CommandBus commandBus;
+        BridgeStateMachine fsm(bus, commandBus);
+
+        for (size_t t = 0; t < COMMAND_TARGET_COUNT; ++t) {
+            commandBus.subscribe(static_cast<CommandTarget>(t), [out = &outputs](const Command& command) {
+                ReplayOutput output{};
+                output.timeMs = Clock::millis();
+                output.kind = ReplayOutput::Kind::COMMAND;
+                output.target = command.target;
+                output.action = command.action;
+                output.data = command.data.c_str();
+                out->push_back(output);
+            });
+        }
+        bus.subscribe<StateChangeData>(BridgeEvent::STATE_CHANGED, [out = &outputs](const StateChangeData& change) {
+            ReplayOutput output{};
+            output.timeMs = Clock::millis();
+            output.kind = ReplayOutput::Kind::TRANSITION;
+            output.from = change.getPreviousState();
+            output.to = change.getNewState();
+            out->push_back(output);
+        });
+
+        fsm.begin();
+        bus.seal();
+        commandBus.seal();
+        VirtualClock::drain(bus);
+
+        uint32_t lastMs = 0;
+        for (const ReplayInput& input : inputs) {
+            clock.runUntil(bus, input.timeMs);  // Cross-core publishes may be a few us out of order
+            if (input.side != BoatEventSide::UNKNOWN) {
+                bus.publish(input.event, new BoatEventData(input.event, input.side), input.priority);
+            } else {
+                bus.publish(input.event, new SimpleEventData(input.event), input.priority);
+            }
+            VirtualClock::drain(bus);
+            lastMs = input.timeMs;
+        }
+        clock.runUntil(bus, lastMs + options.settleMs);
+        stats_.virtualMs = clock.nowMs();
+    }
+
+    Clock::install(previousClock);
+    Logger::setLevel(previousLevel);
+    stats_.inputs = inputs.size();
+    stats_.outputs = outputs.size();
+    stats_.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    return outputs;
+}
+
+std::string TraceReplay::format(const ReplayOutput& output) {
+    char line[160];
+    if (output.kind == ReplayOutput::Kind::TRANSITION) {
+        std::snprintf(line, sizeof(line), "%u STATE %s -> %s", static_cast<unsigned int>(output.timeMs),
+                      BridgeStateMachine::stateName(output.from), BridgeStateMachine::stateName(output.to));
+    } else {
+        std::snprintf(line, sizeof(line), "%u COMMAND %s %s%s%s", static_cast<unsigned int>(output.timeMs),
+                      commandTargetName(output.target), commandActionName(output.action),
+                      output.data.empty() ? "" : " ", output.data.c_str());
+    }
+    return line;
+}
+
+const char* TraceReplay::commandTargetName(CommandTarget target) {
+    switch (target) {
+        case CommandTarget::CONTROLLER: return "CONTROLLER";
+        case CommandTarget::MOTOR_CONTROL: return "MOTOR_CONTROL";
+        case CommandTarget::SIGNAL_CONTROL: return "SIGNAL_CONTROL";
+        case CommandTarget::LOCAL_STATE_INDICATOR: return "LOCAL_STATE_INDICATOR";
+        case CommandTarget::SAFETY_MANAGER: return "SAFETY_MANAGER";
+    }
+    return "UNKNOWN_TARGET";
+}
+
+const char* TraceReplay::commandActionName(CommandAction action) {
+    switch (action) {
+        case CommandAction::ENTER_SAFE_STATE: return "ENTER_SAFE_STATE";
+        case CommandAction::RAISE_BRIDGE: return "RAISE_BRIDGE";
+        case CommandAction::LOWER_BRIDGE: return "LOWER_BRIDGE";
+        case CommandAction::STOP_TRAFFIC: return "STOP_TRAFFIC";
+        case CommandAction::RESUME_TRAFFIC: return "RESUME_TRAFFIC";
+        case CommandAction::SET_CAR_TRAFFIC: return "SET_CAR_TRAFFIC";
+        case CommandAction::SET_BOAT_LIGHT_LEFT: return "SET_BOAT_LIGHT_LEFT";
+        case CommandAction::SET_BOAT_LIGHT_RIGHT: return "SET_BOAT_LIGHT_RIGHT";
+        case CommandAction::START_BOAT_GREEN_PERIOD: return "START_BOAT_GREEN_PERIOD";
+        case CommandAction::END_BOAT_GREEN_PERIOD: return "END_BOAT_GREEN_PERIOD";
+        case CommandAction::SET_STATE: return "SET_STATE";
+        case CommandAction::RESET_TO_IDLE_STATE: return "RESET_TO_IDLE_STATE";
+    }
+    return "UNKNOWN_ACTION";
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// Host-only (UNIT_TEST) replay of recorded EventBus traffic through the real BridgeStateMachine
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "BridgeSystemDefs.h"
+#include "EventBus.h"
+
+// One event to inject, at a time relative to the start of the trace
+struct ReplayInput {
+    uint32_t timeMs;
+    BridgeEvent event;
+    BoatEventSide side;
+    EventPriority priority;
+};
+
+// One thing the state machine did: a command on the CommandBus or a STATE_CHANGED
+struct ReplayOutput {
+    enum class Kind { COMMAND, TRANSITION };
+
+    uint32_t timeMs;
+    Kind kind;
+    // COMMAND
+    CommandTarget target;
+    CommandAction action;
+    std::string data;
+    // TRANSITION
+    BridgeState from;
+    BridgeState to;
+};
+
+/**
+ * TraceReplay - drives a fresh EventBus + CommandBus + BridgeStateMachine from a list of
+ * timestamped events on a VirtualClock
+ *
+ * Between inputs the clock jumps straight to the next EventBus timer deadline, so cooldown,
+ * green-period and passage timers fire on the exact millisecond they would on the target
+ * while an hour of bridge traffic replays in milliseconds. Each run starts from power-on
+ * state, so the same inputs always produce the same outputs.
+ *
+ * Open loop: the subsystems are not simulated. Their success events (TRAFFIC_STOPPED_SUCCESS,
+ * BRIDGE_OPENED_SUCCESS, ...) come from the trace at the time they were recorded.
+ */
+class TraceReplay {
+public:
+    struct Options {
+        uint32_t settleMs = BOAT_PASSAGE_TIMEOUT_MS;  // Virtual time run on after the last input
+        bool quiet = true;                            // Silence the Logger during the run
+    };
+
+    struct Stats {
+        size_t inputs = 0;
+        size_t outputs = 0;
+        uint32_t virtualMs = 0;
+        double wallMs = 0.0;
+    };
+
+    // Reads the CSV written by tools/trace_decode.py. Only PUBLISH / PUBLISH_REMOTE rows are
+    // inputs; events the state machine publishes itself are skipped. Times become relative
+    // to the first input. Returns false (and sets error) on a malformed row.
+    static bool loadCsv(std::istream& in, std::vector<ReplayInput>& out, std::string* error = nullptr);
+
+    // True for events the replayed state machine produces on its own
+    static bool isStateMachineOutput(BridgeEvent event);
+
+    std::vector<ReplayOutput> run(const std::vector<ReplayInput>& inputs);
+    std::vector<ReplayOutput> run(const std::vector<ReplayInput>& inputs, const Options& options);
+
+    const Stats& lastStats() const { return stats_; }
+
+    // "<timeMs> COMMAND <target> <action> [data]" or "<timeMs> STATE <from> -> <to>"
+    static std::string format(const ReplayOutput& output);
+
+    static const char* commandTargetName(CommandTarget target);
+    static const char* commandActionName(CommandAction action);
+
+private:
+    Stats stats_;
+};
@@ -0,0 +1,60 @@
+// trace_replay - replays a decoded field trace through BridgeStateMachine on the host
+//
+//   tools/trace_decode.py capture.log > field.csv
+//   build/trace_replay field.csv > field.out        # commands + state transitions, one per line
+//   diff test/traces/<golden>.expected field.out
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "TraceReplay.h"
+
+unsigned long mock_millis = 0;
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    TraceReplay::Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--settle") == 0 && i + 1 < argc) {
+            options.settleMs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            options.quiet = false;
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: %s <trace.csv> [--settle ms] [--verbose]\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "%s: cannot open\n", path);
+        return 1;
+    }
+    std::vector<ReplayInput> inputs;
+    std::string error;
+    if (!TraceReplay::loadCsv(in, inputs, &error)) {
+        std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+        return 1;
+    }
+
+    TraceReplay replay;
+    for (const ReplayOutput& output : replay.run(inputs, options)) {
+        std::printf("%s\n", TraceReplay::format(output).c_str());
+    }
+
+    const TraceReplay::Stats& stats = replay.lastStats();
+    std::fprintf(stderr, "%u inputs -> %u outputs, %.1f s virtual in %.2f ms (%.0fx real time)\n",
+                 static_cast<unsigned int>(stats.inputs), static_cast<unsigned int>(stats.outputs),
+                 stats.virtualMs / 1000.0, stats.wallMs,
+                 stats.wallMs > 0 ? stats.virtualMs / stats.wallMs : 0.0);
+    return 0;
+}
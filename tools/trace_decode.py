@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Decode an EventBus trace dump (see include/TraceRecorder.h) into CSV or Chrome trace JSON.
+
+Input is either
+  * the raw binary blob (concatenated /system/trace WebSocket frames), or
+  * a serial log containing the console 'trace dump' output between the
+    TRACE BEGIN / TRACE END lines (base64, one dump piece per line).
+
+Event names are read from include/BridgeSystemDefs.h so the decoder follows the enum.
+
+    tools/trace_decode.py capture.log > trace.csv
+    tools/trace_decode.py --format chrome trace.bin > trace.json   # open in chrome://tracing or ui.perfetto.dev
+"""
+
+import argparse
+import base64
+import csv
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x43525442  # "BTRC"
+HEADER = struct.Struct("<IHHIIII")
+RECORD = struct.Struct("<IBBBBHH")
+
+KINDS = ["PUBLISH", "PUBLISH_REMOTE", "DROP", "DISPATCH"]
+SIDES = ["UNKNOWN", "LEFT", "RIGHT"]
+PRIORITIES = ["NORMAL", "EMERGENCY"]
+
+DEFAULT_DEFS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "BridgeSystemDefs.h")
+
+
+def load_event_names(path):
+    """BridgeEvent enumerators in declaration order (index == enum value)."""
+    try:
+        with open(path, encoding="utf-8") as f:
+            source = f.read()
+    except OSError:
+        return []
+    match = re.search(r"enum\s+class\s+BridgeEvent\s*\{(.*?)\};", source, re.S)
+    if not match:
+        return []
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    return [name.strip() for name in body.split(",") if name.strip()]
+
+
+def read_blob(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == MAGIC:
+        return data
+
+    # Console capture: base64 lines between the markers, ignoring log lines around them
+    text = data.decode("utf-8", errors="replace")
+    match = re.search(r"TRACE BEGIN\s*\n(.*?)\n\s*TRACE END", text, re.S)
+    if not match:
+        sys.exit("%s: no binary header and no TRACE BEGIN/END block" % path)
+    lines = [line.strip() for line in match.group(1).splitlines()]
+    return b"".join(base64.b64decode(line) for line in lines if re.fullmatch(r"[A-Za-z0-9+/=]+", line))
+
+
+def decode(blob):
+    if len(blob) < HEADER.size:
+        sys.exit("dump too short for a header")
+    magic, version, record_size, count, total, capacity, dump_us = HEADER.unpack_from(blob)
+    if magic != MAGIC:
+        sys.exit("bad magic 0x%08x" % magic)
+    if version != 1 or record_size != RECORD.size:
+        sys.exit("unsupported trace format v%d (record size %d)" % (version, record_size))
+
+    available = (len(blob) - HEADER.size) // RECORD.size
+    if available < count:
+        print("warning: header says %d records, dump holds %d" % (count, available), file=sys.stderr)
+        count = available
+    if total > count:
+        print("note: %d older records were overwritten" % (total - count), file=sys.stderr)
+
+    # micros() is 32-bit; records are oldest first, so every backwards step is a wrap
+    records = []
+    offset_us = 0
+    previous = None
+    for i in range(count):
+        ts, kind, event, side, priority, depth, duration = RECORD.unpack_from(blob, HEADER.size + i * RECORD.size)
+        if previous is not None and ts < previous and previous - ts > 0x80000000:
+            offset_us += 1 << 32
+        previous = ts
+        records.append((ts + offset_us, kind, event, side, priority, depth, duration))
+    return records
+
+
+def name(table, index):
+    return table[index] if index < len(table) else str(index)
+
+
+def write_csv(records, events, out):
+    writer = csv.writer(out)
+    writer.writerow(["timestamp_us", "kind", "event", "side", "priority", "queue_depth", "duration_us"])
+    for ts, kind, event, side, priority, depth, duration in records:
+        writer.writerow([ts, name(KINDS, kind), name(events, event), name(SIDES, side),
+                         name(PRIORITIES, priority), depth, duration if name(KINDS, kind) == "DISPATCH" else ""])
+
+
+def write_chrome(records, events, out):
+    # tid 1 = control core (publish + dispatch), tid 0 = network core (remote publishes)
+    base = records[0][0] if records else 0
+    trace = [
+        {"ph": "M", "pid": 0, "tid": 0, "name": "thread_name", "args": {"name": "network core"}},
+        {"ph": "M", "pid": 0, "tid": 1, "name": "thread_name", "args": {"name": "control core"}},
+    ]
+    for ts, kind, event, side, priority, depth, duration in records:
+        kind_name = name(KINDS, kind)
+        args = {"side": name(SIDES, side), "priority": name(PRIORITIES, priority), "queueDepth": depth}
+        entry = {"name": name(events, event), "cat": kind_name, "pid": 0, "ts": ts - base, "args": args}
+        if kind_name == "DISPATCH":
+            entry.update(ph="X", tid=1, dur=duration)
+        else:
+            entry.update(ph="i", s="t", tid=0 if kind_name == "PUBLISH_REMOTE" else 1)
+            if kind_name == "DROP":
+                entry["name"] = "DROP " + entry["name"]
+        trace.append(entry)
+        if kind_name == "PUBLISH_REMOTE":
+            continue  # Depth of the hand-off queue is not recorded
+        trace.append({"ph": "C", "pid": 0, "tid": 1, "name": "queueDepth", "ts": ts - base,
+                      "args": {"depth": depth}})
+    json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary dump or serial capture")
+    parser.add_argument("--format", choices=["csv", "chrome"], default="csv")
+    parser.add_argument("--defs", default=DEFAULT_DEFS, help="BridgeSystemDefs.h for event names")
+    parser.add_argument("-o", "--output", help="write here instead of stdout")
+    args = parser.parse_args()
+
+    records = decode(read_blob(args.dump))
+    events = load_event_names(args.defs)
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        if args.format == "csv":
+            write_csv(records, events, out)
+        else:
+            write_chrome(records, events, out)
+    finally:
+        if args.output:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()